@@ -5,6 +5,7 @@ from bembelapi.events import EventEmitter
 from bembelapi.config import NaoEvent
 from bembelapi.message_handler import MessageHandler, MessageHandlerEvent
 from bembelapi.nao import RobotConfig
+from bembelapi.symbolstream import SymbolStreamDecoder
 
 
 class NaoConfigEvent(MessageHandlerEvent):
@@ -29,10 +30,23 @@ class NaoMessageEvent(MessageHandlerEvent):
         event_emitter.emit(nao_event, message, self.client_address, self.socket)
 
 
+class NaoSymbolStreamEvent(MessageHandlerEvent):
+    def __init__(self, data: bytes, client_address: (str, int), _socket: socket):
+        super().__init__(client_address, _socket)
+        self.data = data
+
+    def dispatch(self, event_emitter: EventEmitter):
+        event_emitter.emit("message_symbol_stream", self.data, self.client_address, self.socket)
+
+
 class NaoMessageHandler(MessageHandler):
     def handle(self):
         data, _socket = self.request
 
+        if SymbolStreamDecoder.is_symbol_stream(data):
+            self._emit(NaoSymbolStreamEvent(data, self.client_address, _socket))
+            return
+
         try:
             message = json.loads(data.decode("utf-8"))
             self._emit(NaoMessageEvent(message, self.client_address, _socket))
@@ -44,6 +44,16 @@ class SaveBlackboardsMessage:
         })
 
 
+class RequestSymbolTableMessage:
+
+    def __str__(self):
+        return json.dumps({
+            'debugv2': {
+                'msg_type': 'symbol_table'
+            }
+        })
+
+
 class MonitorMessage:
     def __init__(self, nao_name: str):
         self._data = b""
@@ -1,19 +1,29 @@
 import socket
+import time
 
 from bembelapi.config import NaoEvent
 from bembelapi.connection_manager import NaoConnectionManager
+from bembelapi.messages import RequestSymbolTableMessage
 from bembelapi.naomodule import NaoModule
+from bembelapi.symbolstream import SymbolStreamDecoder
 
 
 class NaoSymbolsListener(NaoModule):
+    # seconds between requests for the symbol table
+    TABLE_REQUEST_INTERVAL = 1.0
+
     def __init__(self, connection_manager: NaoConnectionManager):
         super().__init__()
         self.connection_manager = connection_manager
+        self._decoder = SymbolStreamDecoder()
+        self._decoder_connection = None
+        self._last_table_request = 0
 
     def setup(self, parent):
         super().setup(parent)
         parent.add_listener("message_symbol_names", self)
         parent.add_listener("message_symbol_values", self)
+        parent.add_listener("message_symbol_stream", self)
 
     def handle_message_symbol_names(self, message: dict, client: (str, int), _socket: socket):
         nao_connection = self.connection_manager.connection
@@ -29,5 +39,22 @@ class NaoSymbolsListener(NaoModule):
 
         self.parent.emit(NaoEvent.NAO_SYMBOL_VALUES, message, nao_connection)
 
+    def handle_message_symbol_stream(self, data: bytes, client: (str, int), _socket: socket):
+        nao_connection = self.connection_manager.connection
+        if not nao_connection:
+            return
+        if nao_connection is not self._decoder_connection:
+            self._decoder = SymbolStreamDecoder()
+            self._decoder_connection = nao_connection
+
+        values = self._decoder.decode(data)
+        if self._decoder.needs_table:
+            now = time.time()
+            if now - self._last_table_request > self.TABLE_REQUEST_INTERVAL:
+                self._last_table_request = now
+                nao_connection.send(RequestSymbolTableMessage())
+        if values is not None:
+            self.parent.emit(NaoEvent.NAO_SYMBOL_VALUES, values, nao_connection)
+
     def tick(self):
         pass
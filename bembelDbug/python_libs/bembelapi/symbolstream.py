@@ -0,0 +1,102 @@
+import struct
+
+
+class SymbolStreamDecoder:
+    """
+    Decodes the binary debug symbol stream (see DebugSymbolsHeader in the
+    frontend's src/network/debugheader.h).
+
+    The robot only sends changed values, so the decoder keeps the last value
+    of every symbol and returns the merged state after the last packet of
+    each frame.
+    """
+    MAGIC = b"BBsy"
+    VERSION = 1
+
+    TYPE_TABLE = 0
+    TYPE_VALUES = 1
+    TYPE_KEYFRAME = 2
+
+    LAST_PACKET = 1
+    REMOVED = 0xffff
+
+    HEADER = struct.Struct("<4sBBBxIIHxx")
+    ENTRY = struct.Struct("<HH")
+
+    def __init__(self):
+        self._table_id = 0
+        self._names = {}
+        self._values = {}
+        self._keyframe_seen = False
+        self._keyframe_sequence = None
+        self.needs_table = True
+
+    @classmethod
+    def is_symbol_stream(cls, data: bytes) -> bool:
+        return data[:len(cls.MAGIC)] == cls.MAGIC
+
+    def decode(self, data: bytes):
+        """
+        :return: {blackboard: {key: value}} after the last packet of a frame,
+                 None otherwise
+        """
+        if len(data) < self.HEADER.size:
+            return None
+        magic, version, _type, flags, table_id, sequence, count = self.HEADER.unpack_from(data)
+        if magic != self.MAGIC or version != self.VERSION:
+            return None
+
+        if _type == self.TYPE_TABLE:
+            if table_id != self._table_id:
+                self._table_id = table_id
+                self._names = {}
+                self._values = {}
+                self._keyframe_seen = False
+            for _id, value in self._entries(data, count):
+                self._names[_id] = value.decode("utf-8")
+            if flags & self.LAST_PACKET:
+                self.needs_table = False
+            return None
+
+        if table_id != self._table_id:
+            self.needs_table = True
+            return None
+
+        # a keyframe can span several packets, only clear on the first one
+        if _type == self.TYPE_KEYFRAME and sequence != self._keyframe_sequence:
+            self._keyframe_sequence = sequence
+            self._values = {}
+            self._keyframe_seen = True
+        for _id, value in self._entries(data, count):
+            name = self._names.get(_id)
+            if name is None:
+                self.needs_table = True
+                continue
+            if value is None:
+                self._values.pop(name, None)
+            else:
+                self._values[name] = value.decode("utf-8")
+
+        if not flags & self.LAST_PACKET or not self._keyframe_seen:
+            return None
+        return self._merged()
+
+    def _entries(self, data: bytes, count: int):
+        offset = self.HEADER.size
+        for _ in range(count):
+            if offset + self.ENTRY.size > len(data):
+                return
+            _id, length = self.ENTRY.unpack_from(data, offset)
+            offset += self.ENTRY.size
+            if length == self.REMOVED:
+                yield _id, None
+                continue
+            yield _id, data[offset:offset + length]
+            offset += length
+
+    def _merged(self) -> dict:
+        result = {}
+        for name, value in self._values.items():
+            blackboard, key = name.split(".", 1)
+            result.setdefault(blackboard, {})[key] = value
+        return result
@@ -449,11 +449,9 @@ void processOneFile(const std::string& filename, int processingCount, const std:
     high_resolution_clock::time_point t1 = high_resolution_clock::now();
 
     HTWKVision vision(STD_WIDTH, STD_HEIGHT, HtwkVisionConfig());
-    vision.resetProfilingStats(true);
     for (int i=0;i<processingCount;i++) {
         vision.proceed(imageYUV422, true, pitch, roll);
     }
-    vision.printProfilingResults(true);
 
     high_resolution_clock::time_point t2 = high_resolution_clock::now();
     duration<double> time_span = duration_cast<duration<double>>(t2 - t1);
@@ -507,12 +505,14 @@ void processDirectory(const std::string& path, int processingCount, const std::s
     lowerConfig.isUpperCam = false;
     HTWKVision upperVision(STD_WIDTH, STD_HEIGHT, upperConfig);
     HTWKVision lowerVision(STD_WIDTH, STD_HEIGHT, lowerConfig);
-    upperVision.resetProfilingStats(true);
-    lowerVision.resetProfilingStats(true);
-    std::string statsFileUpper;
-    std::string statsFileLower;
-    statsFileUpper.append(path + "/timeUpper.csv");
-    statsFileLower.append(path + "/timeLower.csv");
+    std::ofstream statsFileUpper;
+    std::ofstream statsFileLower;
+    if (writeTimeFile) {
+        statsFileUpper.open(path + "/timeUpper.csv");
+        statsFileLower.open(path + "/timeLower.csv");
+        statsFileUpper << "image;avg ms" << std::endl;
+        statsFileLower << "image;avg ms" << std::endl;
+    }
 
     for (const ipr &img : images){
         boost::filesystem::path p(img.name);
@@ -520,31 +520,25 @@ void processDirectory(const std::string& path, int processingCount, const std::s
         bool isUpper = (imgName.find("_U.") != std::string::npos);
         std::cout << imgName << std::endl;
 
+        high_resolution_clock::time_point start = high_resolution_clock::now();
         if(isUpper) {
             for (int i=0;i<processingCount;i++){
                 upperVision.proceed(img.img, false,img.pitch,img.roll);
             }
-            if (writeTimeFile)
-                upperVision.writeProfilingFile(statsFileUpper,imgName);
         } else {
             for (int i=0;i<processingCount;i++){
                 lowerVision.proceed(img.img,true,img.pitch,img.roll);
             }
-            if (writeTimeFile)
-                lowerVision.writeProfilingFile(statsFileLower,imgName);
+        }
+        if (writeTimeFile) {
+            duration<double, std::milli> imageTime = high_resolution_clock::now() - start;
+            (isUpper ? statsFileUpper : statsFileLower) << imgName << ";" << imageTime.count() / processingCount << std::endl;
         }
 
         if (!debugPath.empty()) {
             writeDebugFiles(debugPath+"/"+imgName, STD_WIDTH, STD_HEIGHT, img.img, upperVision);
         }
     }
-    if(!writeTimeFile){
-        printf("\n\nUpper Camera timing:\n");
-        upperVision.printProfilingResults(true);
-        printf("\nLower Camera timing:\n");
-        lowerVision.printProfilingResults(true);
-    }
-
 //    CALLGRIND_TOGGLE_COLLECT;
 //    CALLGRIND_STOP_INSTRUMENTATION;
 
@@ -56,84 +56,6 @@ private:
     void createAdressLookups();
     std::vector<RobotClassifierResult> resultRobotClassifier;
 
-    static constexpr bool enableProfiling = false;
-    void createProfilingStats();
-
-    inline void getTime(timespec& t) { clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t); }
-    inline void writeProfilHeader(const std::string& fileName);
-    inline void writeData(std::ofstream &file, const std::string& sep, float min, float avg, float max){
-        file << min << sep << avg << sep << max << sep;
-    }
-    inline void writeHead(std::ofstream &file, const std::string& sep, const std::string& name){
-        file << sep << name << sep << sep;
-    }
-
-    timespec tFieldColorDetector;
-    timespec tRegionClassifier;
-    timespec tFieldDetector;
-    timespec tLineDetector;
-    timespec tGoalDetector;
-    timespec tHypoGenerator;
-    timespec tBallDetector;
-    timespec tFeetDetector;
-    timespec tNearObstacleDetector;
-    timespec tEllipseFitter;
-    timespec tRobotHypotheses;
-    timespec tRobotClassifier;
-    timespec tJersey;
-    timespec tIntegralImage;
-    timespec tEnd;
-
-    float cntFieldColorDetector = 0;
-    float cntRegionClassifier = 0;
-    float cntFieldDetector = 0;
-    float cntLineDetector = 0;
-    float cntGoalDetector = 0;
-    float cntHypoGenerator = 0;
-    float cntBallDetector = 0;
-    float cntFeetDetector = 0;
-    float cntNearObstacleDetector = 0;
-    float cntEllipseFitter = 0;
-    float cntRobotHypotheses = 0;
-    float cntRobotClassifier = 0;
-    float cntJersey = 0;
-    float cntCreateIntegralImage = 0;
-    float cntTotal = 0;
-
-    float maxFieldColorDetector = 0;
-    float maxRegionClassifier = 0;
-    float maxFieldDetector = 0;
-    float maxLineDetector = 0;
-    float maxGoalDetector = 0;
-    float maxHypoGenerator = 0;
-    float maxBallDetector = 0;
-    float maxFeetDetector = 0;
-    float maxNearObstacleDetector = 0;
-    float maxEllipseFitter = 0;
-    float maxRobotHypotheses = 0;
-    float maxRobotClassifier = 0;
-    float maxJersey = 0;
-    float maxCreateIntegralImage = 0;
-    float maxTotal = 0;
-
-    float minFieldColorDetector = 0;
-    float minRegionClassifier = 0;
-    float minFieldDetector = 0;
-    float minLineDetector = 0;
-    float minGoalDetector = 0;
-    float minHypoGenerator = 0;
-    float minBallDetector = 0;
-    float minFeetDetector = 0;
-    float minNearObstacleDetector = 0;
-    float minEllipseFitter = 0;
-    float minRobotHypotheses = 0;
-    float minRobotClassifier = 0;
-    float minJersey = 0;
-    float minCreateIntegralImage = 0;
-    float minTotal = 0;
-
-    int cntImage = 0;
-
     HtwkVisionConfig config;
 
 public:
@@ -167,9 +89,6 @@ public:
 
     /**elements are in pixelcoordinates**/
     std::vector<RobotClassifierResult> getRobotClassifierResult() const { return resultRobotClassifier; }
-    void printProfilingResults(bool isUpperCam);
-    void writeProfilingFile(const std::string& fileName, const std::string& imageName);
-    void resetProfilingStats(bool isUpperCam);
 
     HtwkVisionConfig& getHtwkVisionConfig() { return config; }
 };
@@ -1,10 +1,8 @@
 #include "hypotheses_generator_scanlines.h"
 
 #include <cstring>
-#include <emmintrin.h>
-#include <xmmintrin.h>
-
 #include <projectionutil.h>
+#include <simd.h>
 
 #include <cassert>
 
@@ -200,10 +198,8 @@ void HypothesesGeneratorScanlines::calculateBlockBlurBorder(const float objectRa
     }
 }
 
-#define _mm_shuffle2_epi32(a, b, imm) \
-    _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), (imm)))
-
-void HypothesesGeneratorScanlines::calculateBlockBlurSSERatingScale2(const float objectRadius, const int px, const int py){
+void HypothesesGeneratorScanlines::calculateBlockBlurSimdRatingScale2(const float objectRadius, const int px, const int py){
+    using namespace simd::native;
     int r=(int)(objectRadius*0.6f/IntegralImage::INTEGRAL_SCALE);
 
     int iWidth = IntegralImage::iWidth;
@@ -212,32 +208,24 @@ void HypothesesGeneratorScanlines::calculateBlockBlurSSERatingScale2(const float
     for(int y=py+RATING_SCALE/2;y<py+blockSize;y+=RATING_SCALE){
         int py1=std::max(0,y-r);
         int py2=std::min(IntegralImage::iHeight-1,y+r);
-        __m128 areaInner = _mm_set1_ps(3.f/(2.f*r*(py2-py1)));
+        f32x4 areaInner = set1(3.f/(2.f*r*(py2-py1)));
         for(int x=px+RATING_SCALE/2;x<px+blockSize;x+=8){
             int px1=x-r;
             int px2=x+r;
             int px3=x+4-r;
             int px4=x+4+r;
-            __m128i p11 = _mm_loadu_si128((__m128i*)&iImg[px1+py1*iWidth]);
-            __m128i p31 = _mm_loadu_si128((__m128i*)&iImg[px3+py1*iWidth]);
-            __m128i p131 = _mm_shuffle2_epi32(p11,p31,_MM_SHUFFLE(2,0,2,0));
-            __m128i p12 = _mm_loadu_si128((__m128i*)&iImg[px1+py2*iWidth]);
-            __m128i p32 = _mm_loadu_si128((__m128i*)&iImg[px3+py2*iWidth]);
-            __m128i p132 = _mm_shuffle2_epi32(p12,p32,_MM_SHUFFLE(2,0,2,0));
-            __m128i p21 = _mm_loadu_si128((__m128i*)&iImg[px2+py1*iWidth]);
-            __m128i p41 = _mm_loadu_si128((__m128i*)&iImg[px4+py1*iWidth]);
-            __m128i p241 = _mm_shuffle2_epi32(p21,p41,_MM_SHUFFLE(2,0,2,0));
-            __m128i p22 = _mm_loadu_si128((__m128i*)&iImg[px2+py2*iWidth]);
-            __m128i p42 = _mm_loadu_si128((__m128i*)&iImg[px4+py2*iWidth]);
-            __m128i p242 = _mm_shuffle2_epi32(p22,p42,_MM_SHUFFLE(2,0,2,0));
-            __m128 inner = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_sub_epi32(p242,p132),_mm_sub_epi32(p241,p131)));
-            __m128i rating = _mm_cvtps_epi32(_mm_mul_ps(inner,areaInner));
-            _mm_store_si128((__m128i*)&ratingImg[x/RATING_SCALE+y/RATING_SCALE*rWidth],rating);
+            i32x4 p131 = evenLanes(loadu(&iImg[px1+py1*iWidth]), loadu(&iImg[px3+py1*iWidth]));
+            i32x4 p132 = evenLanes(loadu(&iImg[px1+py2*iWidth]), loadu(&iImg[px3+py2*iWidth]));
+            i32x4 p241 = evenLanes(loadu(&iImg[px2+py1*iWidth]), loadu(&iImg[px4+py1*iWidth]));
+            i32x4 p242 = evenLanes(loadu(&iImg[px2+py2*iWidth]), loadu(&iImg[px4+py2*iWidth]));
+            f32x4 inner = toFloat(sub(sub(p242,p132),sub(p241,p131)));
+            store(&ratingImg[x/RATING_SCALE+y/RATING_SCALE*rWidth], roundToInt(mul(inner,areaInner)));
         }
     }
 }
 
-void HypothesesGeneratorScanlines::calculateBlockBlurSSERatingScale4(const float objectRadius, const int px, const int py){
+void HypothesesGeneratorScanlines::calculateBlockBlurSimdRatingScale4(const float objectRadius, const int px, const int py){
+    using namespace simd::native;
     int r=(int)(objectRadius*0.6f/IntegralImage::INTEGRAL_SCALE);
 
     int iWidth = IntegralImage::iWidth;
@@ -246,27 +234,18 @@ void HypothesesGeneratorScanlines::calculateBlockBlurSSERatingScale4(const float
     for(int y=py+RATING_SCALE/2;y<py+blockSize;y+=RATING_SCALE){
         int py1=std::max(0,y-r);
         int py2=std::min(IntegralImage::iHeight-1,y+r);
-        __m128 areaInner = _mm_set1_ps(3.f/(2.f*r*(py2-py1)));
+        f32x4 areaInner = set1(3.f/(2.f*r*(py2-py1)));
         for(int x=px+RATING_SCALE/2;x<px+blockSize;x+=2*RATING_SCALE){
             int px1=x-r;
             int px2=x+r;
             int px3=x+2*RATING_SCALE-r;
             int px4=std::min(IntegralImage::iWidth-4, x+2*RATING_SCALE+r);
-            __m128i p11 = _mm_loadu_si128((__m128i*)&iImg[px1+py1*iWidth]);
-            __m128i p31 = _mm_loadu_si128((__m128i*)&iImg[px3+py1*iWidth]);
-            __m128i p131 = _mm_shuffle2_epi32(p11,p31,_MM_SHUFFLE(2,0,2,0));
-            __m128i p12 = _mm_loadu_si128((__m128i*)&iImg[px1+py2*iWidth]);
-            __m128i p32 = _mm_loadu_si128((__m128i*)&iImg[px3+py2*iWidth]);
-            __m128i p132 = _mm_shuffle2_epi32(p12,p32,_MM_SHUFFLE(2,0,2,0));
-            __m128i p21 = _mm_loadu_si128((__m128i*)&iImg[px2+py1*iWidth]);
-            __m128i p41 = _mm_loadu_si128((__m128i*)&iImg[px4+py1*iWidth]);
-            __m128i p241 = _mm_shuffle2_epi32(p21,p41,_MM_SHUFFLE(2,0,2,0));
-            __m128i p22 = _mm_loadu_si128((__m128i*)&iImg[px2+py2*iWidth]);
-            __m128i p42 = _mm_loadu_si128((__m128i*)&iImg[px4+py2*iWidth]);
-            __m128i p242 = _mm_shuffle2_epi32(p22,p42,_MM_SHUFFLE(2,0,2,0));
-            __m128 inner = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_sub_epi32(p242,p132),_mm_sub_epi32(p241,p131)));
-            __m128i rating = _mm_cvtps_epi32(_mm_mul_ps(inner,areaInner));
-            _mm_storeu_si128((__m128i*)&ratingImg[x/RATING_SCALE+y/RATING_SCALE*rWidth],rating);
+            i32x4 p131 = evenLanes(loadu(&iImg[px1+py1*iWidth]), loadu(&iImg[px3+py1*iWidth]));
+            i32x4 p132 = evenLanes(loadu(&iImg[px1+py2*iWidth]), loadu(&iImg[px3+py2*iWidth]));
+            i32x4 p241 = evenLanes(loadu(&iImg[px2+py1*iWidth]), loadu(&iImg[px4+py1*iWidth]));
+            i32x4 p242 = evenLanes(loadu(&iImg[px2+py2*iWidth]), loadu(&iImg[px4+py2*iWidth]));
+            f32x4 inner = toFloat(sub(sub(p242,p132),sub(p241,p131)));
+            storeu(&ratingImg[x/RATING_SCALE+y/RATING_SCALE*rWidth], roundToInt(mul(inner,areaInner)));
         }
     }
 }
@@ -280,13 +259,13 @@ void HypothesesGeneratorScanlines::calculateBlockBlur(const float objectRadius,
 
     if(RATING_SCALE == 2) {
         if(px+RATING_SCALE/2-r>=0 && px+blockSize+r<IntegralImage::iWidth) {
-            calculateBlockBlurSSERatingScale2(objectRadius, px, py);
+            calculateBlockBlurSimdRatingScale2(objectRadius, px, py);
         } else {
             calculateBlockBlurBorder(objectRadius, px, py);
         }
     } else if(RATING_SCALE == 4) {
         if(px+RATING_SCALE/2-r>=0 && px+blockSize+r<IntegralImage::iWidth) {
-            calculateBlockBlurSSERatingScale4(objectRadius, px, py);
+            calculateBlockBlurSimdRatingScale4(objectRadius, px, py);
         } else {
             calculateBlockBlurBorder(objectRadius, px, py);
         }
@@ -64,8 +64,8 @@ private:
     void selectBestHypotheses(std::vector<ObjectHypothesis>& maxList);
     bool containsObject(const std::vector<ObjectHypothesis>& maxList, const ObjectHypothesis& hyp);
     void calculateBlockBlur(const float objectRadius, const int px, const int py, const int* const border);
-    void calculateBlockBlurSSERatingScale2(const float objectRadius, const int px, const int py);
-    void calculateBlockBlurSSERatingScale4(const float objectRadius, const int px, const int py);
+    void calculateBlockBlurSimdRatingScale2(const float objectRadius, const int px, const int py);
+    void calculateBlockBlurSimdRatingScale4(const float objectRadius, const int px, const int py);
     void calculateBlockBlurBorder(const float objectRadius, const int px, const int py);
 
     void calculateBlockRadii();
@@ -0,0 +1,173 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) && !defined(HTWK_SIMD_SCALAR)
+#define HTWK_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(HTWK_SIMD_SCALAR)
+#define HTWK_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ * Minimal portable 4x32 bit SIMD layer for the vision kernels.
+ *
+ * htwk::simd::scalar is always available and defines the reference semantics,
+ * htwk::simd::native is SSE2 on x86, NEON on aarch64 and the scalar version
+ * everywhere else (or if HTWK_SIMD_SCALAR is defined).
+ * All backends produce bit-identical results (tests/simdtests.cpp).
+ *
+ * Byte loads interpret 16 bytes as 4 little endian 32 bit words,
+ * i.e. one YUYV macro pixel per lane.
+ */
+namespace htwk {
+namespace simd {
+
+namespace scalar {
+
+struct i32x4 { int32_t v[4]; };
+struct f32x4 { float v[4]; };
+
+inline i32x4 set1(int32_t a) { return {{a, a, a, a}}; }
+inline f32x4 set1(float a) { return {{a, a, a, a}}; }
+inline i32x4 set(int32_t a, int32_t b, int32_t c, int32_t d) { return {{a, b, c, d}}; }
+
+inline i32x4 load(const int32_t *p) { i32x4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+inline i32x4 loadu(const int32_t *p) { return load(p); }
+inline i32x4 loadu(const uint8_t *p) { i32x4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+inline f32x4 loadu(const float *p) { f32x4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+inline void store(int32_t *p, i32x4 a) { std::memcpy(p, a.v, sizeof(a.v)); }
+inline void storeu(int32_t *p, i32x4 a) { store(p, a); }
+// bypass the cache, call fence() before other threads read the data
+inline void stream(int32_t *p, i32x4 a) { store(p, a); }
+inline void fence() {}
+
+// integer arithmetic wraps around like the vector instructions
+inline i32x4 add(i32x4 a, i32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = int32_t(uint32_t(a.v[i]) + uint32_t(b.v[i])); return a; }
+inline i32x4 sub(i32x4 a, i32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = int32_t(uint32_t(a.v[i]) - uint32_t(b.v[i])); return a; }
+inline i32x4 bitAnd(i32x4 a, i32x4 b) { for (int i = 0; i < 4; i++) a.v[i] &= b.v[i]; return a; }
+template<int N> inline i32x4 srli(i32x4 a) {
+    for (int i = 0; i < 4; i++) a.v[i] = int32_t(uint32_t(a.v[i]) >> N);
+    return a;
+}
+
+// inclusive prefix sum over the lanes: (a0, a0+a1, a0+a1+a2, a0+a1+a2+a3)
+inline i32x4 prefixSum(i32x4 a) {
+    for (int i = 1; i < 4; i++) a.v[i] = int32_t(uint32_t(a.v[i]) + uint32_t(a.v[i - 1]));
+    return a;
+}
+inline i32x4 broadcastLast(i32x4 a) { return set1(a.v[3]); }
+// (a0, a2, b0, b2)
+inline i32x4 evenLanes(i32x4 a, i32x4 b) { return {{a.v[0], a.v[2], b.v[0], b.v[2]}}; }
+inline int32_t get(i32x4 a, int i) { return a.v[i]; }
+
+inline f32x4 toFloat(i32x4 a) { f32x4 r; for (int i = 0; i < 4; i++) r.v[i] = float(a.v[i]); return r; }
+inline f32x4 mul(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+// round to nearest, ties to even
+inline i32x4 roundToInt(f32x4 a) {
+    i32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = int32_t(std::nearbyint(a.v[i]));
+    return r;
+}
+
+} // namespace scalar
+
+#if HTWK_SIMD_SSE
+namespace sse {
+
+struct i32x4 { __m128i v; };
+struct f32x4 { __m128 v; };
+
+inline i32x4 set1(int32_t a) { return {_mm_set1_epi32(a)}; }
+inline f32x4 set1(float a) { return {_mm_set1_ps(a)}; }
+inline i32x4 set(int32_t a, int32_t b, int32_t c, int32_t d) { return {_mm_setr_epi32(a, b, c, d)}; }
+
+inline i32x4 load(const int32_t *p) { return {_mm_load_si128((const __m128i *)p)}; }
+inline i32x4 loadu(const int32_t *p) { return {_mm_loadu_si128((const __m128i *)p)}; }
+inline i32x4 loadu(const uint8_t *p) { return {_mm_loadu_si128((const __m128i *)p)}; }
+inline f32x4 loadu(const float *p) { return {_mm_loadu_ps(p)}; }
+inline void store(int32_t *p, i32x4 a) { _mm_store_si128((__m128i *)p, a.v); }
+inline void storeu(int32_t *p, i32x4 a) { _mm_storeu_si128((__m128i *)p, a.v); }
+inline void stream(int32_t *p, i32x4 a) { _mm_stream_si128((__m128i *)p, a.v); }
+inline void fence() { _mm_sfence(); }
+
+inline i32x4 add(i32x4 a, i32x4 b) { return {_mm_add_epi32(a.v, b.v)}; }
+inline i32x4 sub(i32x4 a, i32x4 b) { return {_mm_sub_epi32(a.v, b.v)}; }
+inline i32x4 bitAnd(i32x4 a, i32x4 b) { return {_mm_and_si128(a.v, b.v)}; }
+template<int N> inline i32x4 srli(i32x4 a) { return {_mm_srli_epi32(a.v, N)}; }
+
+inline i32x4 prefixSum(i32x4 a) {
+    __m128i s = _mm_add_epi32(a.v, _mm_slli_si128(a.v, 4));
+    return {_mm_add_epi32(s, _mm_slli_si128(s, 8))};
+}
+inline i32x4 broadcastLast(i32x4 a) { return {_mm_shuffle_epi32(a.v, _MM_SHUFFLE(3, 3, 3, 3))}; }
+inline i32x4 evenLanes(i32x4 a, i32x4 b) {
+    return {_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a.v), _mm_castsi128_ps(b.v), _MM_SHUFFLE(2, 0, 2, 0)))};
+}
+inline int32_t get(i32x4 a, int i) { int32_t r[4]; _mm_storeu_si128((__m128i *)r, a.v); return r[i]; }
+
+inline f32x4 toFloat(i32x4 a) { return {_mm_cvtepi32_ps(a.v)}; }
+inline f32x4 mul(f32x4 a, f32x4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+// uses the MXCSR rounding mode, round to nearest even by default
+inline i32x4 roundToInt(f32x4 a) { return {_mm_cvtps_epi32(a.v)}; }
+
+} // namespace sse
+namespace native = sse;
+
+#elif HTWK_SIMD_NEON
+namespace neon {
+
+struct i32x4 { int32x4_t v; };
+struct f32x4 { float32x4_t v; };
+
+inline i32x4 set1(int32_t a) { return {vdupq_n_s32(a)}; }
+inline f32x4 set1(float a) { return {vdupq_n_f32(a)}; }
+inline i32x4 set(int32_t a, int32_t b, int32_t c, int32_t d) {
+    const int32_t v[4] = {a, b, c, d};
+    return {vld1q_s32(v)};
+}
+
+inline i32x4 load(const int32_t *p) { return {vld1q_s32(p)}; }
+inline i32x4 loadu(const int32_t *p) { return {vld1q_s32(p)}; }
+inline i32x4 loadu(const uint8_t *p) { return {vreinterpretq_s32_u8(vld1q_u8(p))}; }
+inline f32x4 loadu(const float *p) { return {vld1q_f32(p)}; }
+inline void store(int32_t *p, i32x4 a) { vst1q_s32(p, a.v); }
+inline void storeu(int32_t *p, i32x4 a) { vst1q_s32(p, a.v); }
+inline void stream(int32_t *p, i32x4 a) { vst1q_s32(p, a.v); }
+inline void fence() {}
+
+inline i32x4 add(i32x4 a, i32x4 b) { return {vaddq_s32(a.v, b.v)}; }
+inline i32x4 sub(i32x4 a, i32x4 b) { return {vsubq_s32(a.v, b.v)}; }
+inline i32x4 bitAnd(i32x4 a, i32x4 b) { return {vandq_s32(a.v, b.v)}; }
+template<int N> inline i32x4 srli(i32x4 a) {
+    return {vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a.v), N))};
+}
+
+inline i32x4 prefixSum(i32x4 a) {
+    const int32x4_t zero = vdupq_n_s32(0);
+    int32x4_t s = vaddq_s32(a.v, vextq_s32(zero, a.v, 3));
+    return {vaddq_s32(s, vextq_s32(zero, s, 2))};
+}
+inline i32x4 broadcastLast(i32x4 a) { return {vdupq_laneq_s32(a.v, 3)}; }
+inline i32x4 evenLanes(i32x4 a, i32x4 b) { return {vuzp1q_s32(a.v, b.v)}; }
+inline int32_t get(i32x4 a, int i) { int32_t r[4]; vst1q_s32(r, a.v); return r[i]; }
+
+inline f32x4 toFloat(i32x4 a) { return {vcvtq_f32_s32(a.v)}; }
+inline f32x4 mul(f32x4 a, f32x4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline i32x4 roundToInt(f32x4 a) { return {vcvtnq_s32_f32(a.v)}; }
+
+} // namespace neon
+namespace native = neon;
+
+#else
+namespace native = scalar;
+#endif
+
+} // namespace simd
+} // namespace htwk
+
+#endif // SIMD_H
@@ -0,0 +1,146 @@
+#include "simdtests.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <integral_image.h>
+#include <simd.h>
+
+using namespace htwk;
+namespace nat = htwk::simd::native;
+namespace ref = htwk::simd::scalar;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SimdTests);
+
+static const int iterations = 10000;
+
+static bool equal(nat::i32x4 a, ref::i32x4 b)
+{
+    for(int i=0;i<4;i++){
+        if(nat::get(a,i) != ref::get(b,i))
+            return false;
+    }
+    return true;
+}
+
+static void randomLanes(std::mt19937 &rng, int32_t *out)
+{
+    // full 32 bit range, so overflow and sign handling are covered, too
+    for(int i=0;i<4;i++)
+        out[i]=int32_t(rng());
+}
+
+void SimdTests::testIntegerOps()
+{
+    std::mt19937 rng(42);
+    alignas(16) int32_t a[4];
+    alignas(16) int32_t b[4];
+
+    for(int n=0;n<iterations;n++){
+        randomLanes(rng, a);
+        randomLanes(rng, b);
+        const nat::i32x4 na=nat::load(a), nb=nat::load(b);
+        const ref::i32x4 ra=ref::load(a), rb=ref::load(b);
+
+        CPPUNIT_ASSERT(equal(nat::add(na,nb), ref::add(ra,rb)));
+        CPPUNIT_ASSERT(equal(nat::sub(na,nb), ref::sub(ra,rb)));
+        CPPUNIT_ASSERT(equal(nat::bitAnd(na,nb), ref::bitAnd(ra,rb)));
+        CPPUNIT_ASSERT(equal(nat::srli<23>(na), ref::srli<23>(ra)));
+        CPPUNIT_ASSERT(equal(nat::srli<24>(na), ref::srli<24>(ra)));
+
+        alignas(16) int32_t out[4];
+        nat::store(out, na);
+        CPPUNIT_ASSERT(equal(nat::loadu(out), ra));
+    }
+}
+
+void SimdTests::testLaneOps()
+{
+    std::mt19937 rng(23);
+    alignas(16) int32_t a[4];
+    alignas(16) int32_t b[4];
+    uint8_t bytes[17];
+
+    for(int n=0;n<iterations;n++){
+        randomLanes(rng, a);
+        randomLanes(rng, b);
+        const nat::i32x4 na=nat::load(a), nb=nat::load(b);
+        const ref::i32x4 ra=ref::load(a), rb=ref::load(b);
+
+        CPPUNIT_ASSERT(equal(nat::prefixSum(na), ref::prefixSum(ra)));
+        CPPUNIT_ASSERT(equal(nat::broadcastLast(na), ref::broadcastLast(ra)));
+        CPPUNIT_ASSERT(equal(nat::evenLanes(na,nb), ref::evenLanes(ra,rb)));
+
+        // unaligned byte loads, as used for yuyv rows
+        for(uint8_t &c : bytes)
+            c=uint8_t(rng());
+        CPPUNIT_ASSERT(equal(nat::loadu(bytes+1), ref::loadu(bytes+1)));
+    }
+}
+
+void SimdTests::testRounding()
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+
+    // ties have to round to even on every backend
+    const float ties[4]={0.5f, 1.5f, -2.5f, 1e5f+0.5f};
+    const float one[4]={1.f, 1.f, 1.f, 1.f};
+    const nat::f32x4 nt=nat::loadu(ties), n1=nat::loadu(one);
+    const ref::f32x4 rt=ref::loadu(ties), r1=ref::loadu(one);
+    CPPUNIT_ASSERT(equal(nat::roundToInt(nat::mul(nt,n1)), ref::roundToInt(ref::mul(rt,r1))));
+    CPPUNIT_ASSERT_EQUAL(0, ref::get(ref::roundToInt(rt),0));
+    CPPUNIT_ASSERT_EQUAL(-2, ref::get(ref::roundToInt(rt),2));
+
+    for(int n=0;n<iterations;n++){
+        // same computation as the rating image: integer box sum times 1/area
+        const int32_t sum=int32_t(rng()%2000000)-1000000;
+        const float scale=dist(rng)*1e-6f;
+        const nat::f32x4 nv=nat::mul(nat::toFloat(nat::set1(sum)), nat::set1(scale));
+        const ref::f32x4 rv=ref::mul(ref::toFloat(ref::set1(sum)), ref::set1(scale));
+        CPPUNIT_ASSERT(equal(nat::roundToInt(nv), ref::roundToInt(rv)));
+    }
+}
+
+void SimdTests::testIntegralImage()
+{
+    const int width=IntegralImage::SRC_IMAGE_WIDTH;
+    const int height=IntegralImage::SRC_IMAGE_HEIGHT;
+    const int scale=IntegralImage::INTEGRAL_SCALE;
+    const int iWidth=IntegralImage::iWidth;
+    const int iHeight=IntegralImage::iHeight;
+
+    std::vector<int8_t> lutCb(width), lutCr(width);
+    for(int i=0;i<width;i++){
+        lutCb[i]=(i&1) ? -1 : 1;
+        lutCr[i]=(i&1) ? 1 : 3;
+    }
+    IntegralImage integral(width, height, lutCb.data(), lutCr.data());
+
+    std::mt19937 rng(1);
+    std::vector<uint8_t> img(width*height*2);
+    std::vector<int> expected(iWidth*iHeight);
+
+    for(int n=0;n<4;n++){
+        // random content, the last one saturated to catch overflows
+        for(uint8_t &c : img)
+            c=(n==3) ? 255 : uint8_t(rng());
+
+        // scalar reference: sum of y+3*cr of every scale-th pixel
+        for(int y=0;y<iHeight;y++){
+            int sum=0;
+            for(int x=0;x<iWidth;x++){
+                const int addr=(x*scale+y*scale*width)*2;
+                sum+=img[addr]+3*img[addr|3];
+                expected[x+y*iWidth]=sum+(y>0 ? expected[x+(y-1)*iWidth] : 0);
+            }
+        }
+
+        integral.proceed(img.data());
+        const int *result=integral.getIntegralImg();
+        for(int i=0;i<iWidth*iHeight;i++){
+            CPPUNIT_ASSERT_EQUAL(expected[i], result[i]);
+        }
+    }
+}
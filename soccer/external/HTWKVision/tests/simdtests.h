@@ -0,0 +1,26 @@
+#ifndef SIMDTESTS_H
+#define SIMDTESTS_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Checks that the native SIMD backend (SSE2 / NEON) and the kernels built on it
+ * are bit-exact with the scalar code.
+ */
+class SimdTests : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE(SimdTests);
+CPPUNIT_TEST(testIntegerOps);
+CPPUNIT_TEST(testLaneOps);
+CPPUNIT_TEST(testRounding);
+CPPUNIT_TEST(testIntegralImage);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testIntegerOps();
+    void testLaneOps();
+    void testRounding();
+    void testIntegralImage();
+};
+
+#endif // SIMDTESTS_H
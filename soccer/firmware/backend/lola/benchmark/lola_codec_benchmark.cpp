@@ -0,0 +1,253 @@
+/**
+ * Compares the fixed schema LoLA codec with generic msgpack-c,
+ * by replaying recorded LoLA sensor packets.
+ *
+ * usage: lola_codec_benchmark [recording]
+ *
+ * A recording is a raw dump of the LoLA socket, i.e. a sequence of 896 byte packets.
+ * Without a recording, packets with random sensor values are generated.
+ */
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <msgpack.hpp>
+
+#include <framework/benchmark/latency.h>
+#include <lola/msgpack_codec.h>
+
+static constexpr size_t LOLA_PKT_SIZE{896};
+static constexpr int generatedPackets{1000};
+static constexpr int repetitions{20};
+
+using Packet = std::vector<char>;
+using clock_type = std::chrono::steady_clock;
+
+// previous implementation of lola::Connector::readSensors
+static void referenceDecode(const Packet &pkt, bbipc::Sensors &sensors, std::array<std::string, 4> &config) {
+    msgpack::object_handle oh = msgpack::unpack(pkt.data(), pkt.size());
+    for (const auto &e : oh.get().via.map) {
+        const std::string key(e.key.via.str.ptr, e.key.via.str.size);
+        const auto &val{e.val};
+
+        if (key == "Stiffness") {
+            sensors.joints.stiffness = val.as<bbipc::JointArray>();
+        } else if (key == "Position") {
+            sensors.joints.position = val.as<bbipc::JointArray>();
+        } else if (key == "Temperature") {
+            sensors.joints.temperature = val.as<bbipc::JointArray>();
+        } else if (key == "Current") {
+            sensors.joints.current = val.as<bbipc::JointArray>();
+        } else if (key == "Status") {
+            sensors.joints.status = val.as<bbipc::JointStatus>();
+        } else if (key == "Battery") {
+            const auto &[charge, status, current, temp] = val.as<std::array<float, 4>>();
+            sensors.battery = {.charge = charge, .current = current, .status = status, .temperature = temp};
+        } else if (key == "Accelerometer") {
+            const auto &[x, y, z] = val.as<std::array<float, 3>>();
+            sensors.imu.accelerometer << x, y, z;
+        } else if (key == "Gyroscope") {
+            const auto &[x, y, z] = val.as<std::array<float, 3>>();
+            sensors.imu.gyroscope << x, y, z;
+        } else if (key == "Angles") {
+            const auto &[x, y] = val.as<std::array<float, 2>>();
+            sensors.imu.angles << x, y;
+        } else if (key == "Sonar") {
+            const auto &[l, r] = val.as<std::array<float, 2>>();
+            sensors.sonar = {l, r};
+        } else if (key == "FSR") {
+            const auto &[lfl, lfr, lrl, lrr, rfl, rfr, rrl, rrr] = val.as<std::array<float, 8>>();
+            sensors.fsr.left.arr = {lfl, lfr, lrl, lrr};
+            sensors.fsr.right.arr = {rfl, rfr, rrl, rrr};
+        } else if (key == "Touch") {
+            const auto &a = val.as<std::array<float, 14>>();
+            sensors.touch.chest.button = a[0];
+            sensors.touch.head = {a[1], a[2], a[3]};
+            sensors.touch.feet.left = {a[4], a[5]};
+            sensors.touch.hands.left = {a[6], a[7], a[8]};
+            sensors.touch.feet.right = {a[9], a[10]};
+            sensors.touch.hands.right = {a[11], a[12], a[13]};
+        } else if (key == "RobotConfig") {
+            config = val.as<std::array<std::string, 4>>();
+        }
+    }
+}
+
+template<typename T>
+static void packArray(msgpack::packer<msgpack::sbuffer> &pk, const T *a, size_t n) {
+    pk.pack_array(n);
+    for (size_t i = 0; i < n; ++i)
+        pk.pack_float(a[i]);
+}
+
+// previous implementation of lola::Connector::writeActuators
+static const msgpack::sbuffer &referenceEncode(const bbipc::Actuators &a) {
+    static msgpack::sbuffer buffer;
+    buffer.clear();
+    msgpack::packer<msgpack::sbuffer> pk(&buffer);
+
+    auto eye = [&pk](const bbipc::LEDString<8> &e) {
+        pk.pack_array(3 * e.NUM_LEDS);
+        for (const auto *c : {&e.r, &e.g, &e.b})
+            for (const auto &v : *c)
+                pk.pack_float(v);
+    };
+    auto single = [&pk](const bbipc::LEDSingle &l) {
+        const float rgb[3]{l.r, l.g, l.b};
+        packArray(pk, rgb, 3);
+    };
+
+    pk.pack_map(lola::LOLA_ACTUATOR_NAMES.size());
+    pk.pack("Position");
+    packArray(pk, a.joints.position.data(), a.joints.position.size());
+    pk.pack("Stiffness");
+    packArray(pk, a.joints.stiffness.data(), a.joints.stiffness.size());
+    pk.pack("REar");
+    packArray(pk, a.led.ears.right.data(), a.led.ears.right.size());
+    pk.pack("LEar");
+    packArray(pk, a.led.ears.left.data(), a.led.ears.left.size());
+    pk.pack("Chest");
+    single(a.led.chest);
+    pk.pack("LEye");
+    eye(a.led.eyes.left);
+    pk.pack("REye");
+    eye(a.led.eyes.right);
+    pk.pack("LFoot");
+    single(a.led.feet.left);
+    pk.pack("RFoot");
+    single(a.led.feet.right);
+    pk.pack("Skull");
+    packArray(pk, a.led.skull.data(), a.led.skull.size());
+    pk.pack("Sonar");
+    pk.pack_array(2);
+    pk.pack(a.sonar.left);
+    pk.pack(a.sonar.right);
+    return buffer;
+}
+
+static std::vector<Packet> loadRecording(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<Packet> packets;
+    Packet pkt(LOLA_PKT_SIZE);
+    while (in.read(pkt.data(), pkt.size()))
+        packets.push_back(pkt);
+    return packets;
+}
+
+static std::vector<Packet> generatePackets(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> dist(-1, 1);
+    auto floats = [&](msgpack::packer<msgpack::sbuffer> &pk, const char *key, size_t n) {
+        pk.pack(key);
+        pk.pack_array(n);
+        for (size_t i = 0; i < n; ++i)
+            pk.pack_float(dist(rng));
+    };
+
+    std::vector<Packet> packets;
+    for (int i = 0; i < generatedPackets; ++i) {
+        msgpack::sbuffer buffer;
+        msgpack::packer<msgpack::sbuffer> pk(&buffer);
+        pk.pack_map(13);
+        pk.pack("RobotConfig");
+        pk.pack(std::array<std::string, 4>{"P0000000000000000000", "6.0.0", "P0000000000000000001", "6.0.2"});
+        floats(pk, "Accelerometer", 3);
+        floats(pk, "Angles", 2);
+        floats(pk, "Battery", 4);
+        floats(pk, "Current", LOLA_NUMBER_OF_JOINTS);
+        floats(pk, "FSR", 8);
+        floats(pk, "Gyroscope", 3);
+        floats(pk, "Position", LOLA_NUMBER_OF_JOINTS);
+        floats(pk, "Sonar", 2);
+        floats(pk, "Stiffness", LOLA_NUMBER_OF_JOINTS);
+        floats(pk, "Temperature", LOLA_NUMBER_OF_JOINTS);
+        pk.pack("Status");
+        pk.pack_array(LOLA_NUMBER_OF_JOINTS);
+        for (size_t j = 0; j < LOLA_NUMBER_OF_JOINTS; ++j)
+            pk.pack(static_cast<int>(rng() % 5));
+        floats(pk, "Touch", 14);
+        packets.emplace_back(buffer.data(), buffer.data() + buffer.size());
+    }
+    return packets;
+}
+
+template<typename F>
+static void measure(const std::string &name, size_t count, F &&f) {
+    std::vector<int64_t> ns;
+    ns.reserve(count * repetitions);
+    for (int r = 0; r < repetitions; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto start{clock_type::now()};
+            f(i);
+            ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count());
+        }
+    }
+    benchmark::printLatency(name, ns);
+}
+
+int main(int argc, char **argv) {
+    std::mt19937 rng(42);
+    const auto packets{(argc > 1) ? loadRecording(argv[1]) : generatePackets(rng)};
+    if (packets.empty()) {
+        std::cerr << "no LoLA packets found" << std::endl;
+        return 1;
+    }
+    std::cout << "replaying " << packets.size() << " LoLA packets, " << repetitions << " times" << std::endl;
+
+    // decoded values must be identical
+    for (const auto &pkt : packets) {
+        bbipc::Sensors expected{}, actual{};
+        std::array<std::string, 4> config;
+        lola::RobotConfigView rc;
+        std::string_view key;
+        referenceDecode(pkt, expected, config);
+        if (lola::decodeSensors(pkt.data(), pkt.size(), actual, rc, key) != lola::DecodeResult::OK) {
+            std::cerr << "failed to decode packet at key '" << key << "'" << std::endl;
+            return 1;
+        }
+        if (!(expected == actual) || config[0] != rc.bodyId || config[2] != rc.headId) {
+            std::cerr << "decoded sensor values differ" << std::endl;
+            return 1;
+        }
+    }
+
+    // actuator packets must be byte identical
+    std::uniform_real_distribution<float> dist(0, 1);
+    std::vector<bbipc::Actuators> actuators(packets.size());
+    lola::ActuatorEncoder encoder;
+    for (auto &a : actuators) {
+        for (auto &v : a.joints.position)
+            v = dist(rng);
+        a.led.eyes.left.fill(dist(rng), dist(rng), dist(rng));
+        a.led.chest = {dist(rng), dist(rng), dist(rng)};
+        a.sonar.right = dist(rng) > 0.5f;
+
+        const auto &expected{referenceEncode(a)};
+        const auto actual{encoder.encode(a)};
+        if (std::string_view(expected.data(), expected.size()) != actual) {
+            std::cerr << "encoded actuator packets differ" << std::endl;
+            return 1;
+        }
+    }
+
+    bbipc::Sensors sensors;
+    std::array<std::string, 4> config;
+    std::cout << std::endl << "Latency [ns]" << std::endl;
+    benchmark::printLatencyHeader("codec");
+    measure("decode msgpack-c", packets.size(), [&](size_t i) { referenceDecode(packets[i], sensors, config); });
+    measure("decode fixed schema", packets.size(), [&](size_t i) {
+        lola::RobotConfigView rc;
+        std::string_view key;
+        lola::decodeSensors(packets[i].data(), packets[i].size(), sensors, rc, key);
+    });
+
+    size_t bytes{0};
+    measure("encode msgpack-c", actuators.size(), [&](size_t i) { bytes += referenceEncode(actuators[i]).size(); });
+    measure("encode fixed schema", actuators.size(), [&](size_t i) { bytes += encoder.encode(actuators[i]).size(); });
+
+    return (bytes > 0) ? 0 : 1;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
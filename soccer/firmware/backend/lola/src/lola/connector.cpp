@@ -34,13 +34,6 @@ using std::this_thread::sleep_for;
 
 namespace lola {
 
-static constexpr std::array<std::string_view, 11> LOLA_ACTUATOR_NAMES{
-        "Position", "Stiffness", "REar", "LEar", "Chest", "LEye", "REye", "LFoot", "RFoot", "Skull", "Sonar"};
-
-static inline std::string to_string(const msgpack::object &o) {
-    return std::string(o.via.str.ptr, o.via.str.size);
-}
-
 bool forkexec(const char *cmd, const char *arg = nullptr) {
     pid_t pid = fork();
     if (pid == 0) { // child
@@ -86,31 +79,6 @@ msgpack::sbuffer Connector::stiffnessRequest(const float &stiffness) {
     return buffer;
 }
 
-template<size_t N>
-void msgpackPack(msgpack::packer<msgpack::sbuffer> &pk, const std::array<float, N> &a) {
-    pk.pack_array(a.size());
-    for (const auto &i : a)
-        pk.pack_float(i);
-}
-
-template<size_t N>
-void msgpackPack(msgpack::packer<msgpack::sbuffer> &pk, const bbipc::LEDString<N> &eye) {
-    pk.pack_array(3 * N);
-    for (const auto &i : eye.r)
-        pk.pack_float(i);
-    for (const auto &i : eye.g)
-        pk.pack_float(i);
-    for (const auto &i : eye.b)
-        pk.pack_float(i);
-}
-
-void msgpackPack(msgpack::packer<msgpack::sbuffer> &pk, const bbipc::LEDSingle &led) {
-    pk.pack_array(3);
-    pk.pack_float(led.r);
-    pk.pack_float(led.g);
-    pk.pack_float(led.b);
-}
-
 Connector::Connector(Connector::socket_t &s, const Connector::endpoint_t &e)
   : sock(s)
   , ep(e)
@@ -177,11 +145,9 @@ bool Connector::run() {
             continue;
         }
 
-        // create msgpack object & parse sensor values
-        msgpack::object_handle oh = msgpack::unpack(pkt, pkt_len);
-        msgpack::object obj = oh.get();
-
-        readSensors(obj);
+        // parse sensor values
+        if (!readSensors(pkt, pkt_len))
+            continue;
 
         if (!robotConfigReceived) {
             const auto &rc{*sensorMsg.robotConfig};
@@ -194,8 +160,8 @@ bool Connector::run() {
             robotConfigReceived = true;
         }
 
-        // generate msgpack object & write to socket
-        const auto &buf{writeActuators()};
+        // generate msgpack packet & write to socket
+        const auto buf{writeActuators()};
         sock.send(boost::asio::buffer(buf.data(), buf.size()), 0, ec);
         if (ec) {
             std::cerr << __PRETTY_FUNCTION__ << " - socket error, reconnecting: " << ec.message() << std::endl;
@@ -348,66 +314,32 @@ void Connector::buttonHandler() {
     }
 }
 
-void Connector::readSensors(const msgpack::object &obj) {
-    for (const auto &e : obj.via.map) {
-        // enumerate
-        const auto &key{to_string(e.key)};
-        const auto &val{e.val};
-
-        if (key == "Stiffness") {
-            sensors.joints.stiffness = val.as<bbipc::JointArray>();
-        } else if (key == "Position") {
-            sensors.joints.position = val.as<bbipc::JointArray>();
-        } else if (key == "Temperature") {
-            sensors.joints.temperature = val.as<bbipc::JointArray>();
-        } else if (key == "Current") {
-            sensors.joints.current = val.as<bbipc::JointArray>();
-        } else if (key == "Status") {
-            sensors.joints.status = val.as<bbipc::JointStatus>();
-        } else if (key == "Battery") {
-            const auto &[charge, status, current, temp] = val.as<std::array<float, 4>>();
-            sensors.battery = {.charge = charge, .current = current, .status = status, .temperature = temp};
-        } else if (key == "Accelerometer") {
-            const auto &[x, y, z] = val.as<std::array<float, 3>>();
-            sensors.imu.accelerometer << x, y, z;
-        } else if (key == "Gyroscope") {
-            const auto &[x, y, z] = val.as<std::array<float, 3>>();
-            sensors.imu.gyroscope << x, y, z;
-        } else if (key == "Angles") {
-            const auto &[x, y] = val.as<std::array<float, 2>>();
-            sensors.imu.angles << x, y;
-        } else if (key == "Sonar") {
-            const auto &[l, r] = val.as<std::array<float, 2>>();
-            sensors.sonar = {l, r};
-        } else if (key == "FSR") {
-            const auto &[lfl, lfr, lrl, lrr, rfl, rfr, rrl, rrr] = val.as<std::array<float, 8>>();
-            sensors.fsr.left.arr = {lfl, lfr, lrl, lrr};
-            sensors.fsr.right.arr = {rfl, rfr, rrl, rrr};
-        } else if (key == "Touch") {
-            const auto &a = val.as<std::array<float, 14>>();
-            sensors.touch.chest.button = a[0];
-            sensors.touch.head = {a[1], a[2], a[3]};
-            sensors.touch.feet.left = {a[4], a[5]};
-            sensors.touch.hands.left = {a[6], a[7], a[8]};
-            sensors.touch.feet.right = {a[9], a[10]};
-            sensors.touch.hands.right = {a[11], a[12], a[13]};
-        } else if (key == "RobotConfig") {
-            const auto &[bodyId, bodyVersion, headId, headVersion] = val.as<std::array<std::string, 4>>();
-            auto robotName = DEFS::headid2name(headId);
-
-            sensorMsg.robotName = DEFS::headid2name(headId);
-            sensorMsg.simulator = (robotName == RobotName::SIMULATOR);
-            sensorMsg.backendVersion = BB_BACKEND_VERSION;
-
-            auto &rc = *sensorMsg.robotConfig;
-            rc.head->serial = headId;
-            rc.head->version = headVersion;
-            rc.body->serial = bodyId;
-            rc.body->version = bodyVersion;
-        } else {
+bool Connector::readSensors(const char *pkt, const size_t len) {
+    RobotConfigView config;
+    std::string_view key;
+
+    switch (decodeSensors(pkt, len, sensors, config, key)) {
+        case DecodeResult::OK:
+            break;
+        case DecodeResult::UNKNOWN_KEY:
             std::cerr << "Error: unhandled key '" << key << "' in LoLa sensor message!" << std::endl;
             exit(69);
-        }
+        case DecodeResult::MALFORMED:
+            std::cerr << "Error: malformed LoLa sensor message at key '" << key << "'!" << std::endl;
+            return false;
+    }
+
+    if (!config.empty()) {
+        sensorMsg.robotName = DEFS::headid2name(config.headId);
+        sensorMsg.simulator = (sensorMsg.robotName == RobotName::SIMULATOR);
+        sensorMsg.backendVersion = BB_BACKEND_VERSION;
+
+        // strings keep their capacity, so this only allocates once
+        auto &rc = *sensorMsg.robotConfig;
+        rc.head->serial.assign(config.headId);
+        rc.head->version.assign(config.headVersion);
+        rc.body->serial.assign(config.bodyId);
+        rc.body->version.assign(config.bodyVersion);
     }
 
     calibrateGyro();
@@ -424,7 +356,7 @@ void Connector::readSensors(const msgpack::object &obj) {
     // increase sensor tick
     ++sensorMsg.tick;
 
-    //std::cerr << std::endl << obj << std::endl;
+    return true;
 }
 
 void Connector::setIdleLeds() {
@@ -468,22 +400,22 @@ void Connector::setEarLeds() {
     }
 }
 
-msgpack::sbuffer &Connector::writeActuators() {
+std::string_view Connector::writeActuators() {
     bb_shm->actuators.timedProduce(11);
     const auto &ipc{bb_shm->actuators.producedData()};
 
-    // use temporary buffer, to avoid issues with old data in tripple buffer if frontend is not running
-    bbapi::BembelIpcActuatorMessageT am;
-    if (!ipc.get(am)) {
+    // only look at the SHM buffer, to avoid issues with old data in tripple buffer if frontend is not running
+    const auto *am{ipc.view()};
+    if (am == nullptr) {
         // SHM does not contain valid flatbuffer after creation, so silently ignore error until we are connected
         std::cerr << "Error: invalid actuator message flatbuffer received." << std::endl;
         exit(2);
     }
 
     // check if frontend has increased actuator tick
-    if (am.tick != last_tick) {
+    if (am->tick() != last_tick) {
         last_tick = actuatorMsg.tick;
-        actuatorMsg = am;
+        am->UnPackTo(&actuatorMsg);
         connCnt = std::min(connCnt + 1, 15U);
     } else if (connCnt > 0) {
         --connCnt;
@@ -519,47 +451,8 @@ msgpack::sbuffer &Connector::writeActuators() {
     
     setEarLeds();
 
-    // create msgpack buffer
-    static msgpack::sbuffer buffer;
-    buffer.clear();
-    msgpack::packer<msgpack::sbuffer> pk(&buffer);
-
-    pk.pack_map(LOLA_ACTUATOR_NAMES.size());
-
-    for (const auto &name : LOLA_ACTUATOR_NAMES) {
-        pk.pack(name);
-        if (name == "Position") {
-            msgpackPack(pk, actuators.joints.position);
-        } else if (name == "Stiffness") {
-            msgpackPack(pk, actuators.joints.stiffness);
-        } else if (name == "REar") {
-            msgpackPack(pk, actuators.led.ears.right);
-        } else if (name == "LEar") {
-            msgpackPack(pk, actuators.led.ears.left);
-        } else if (name == "Chest") {
-            msgpackPack(pk, actuators.led.chest);
-        } else if (name == "LEye") {
-            msgpackPack(pk, actuators.led.eyes.left);
-        } else if (name == "REye") {
-            msgpackPack(pk, actuators.led.eyes.right);
-        } else if (name == "LFoot") {
-            msgpackPack(pk, actuators.led.feet.left);
-        } else if (name == "RFoot") {
-            msgpackPack(pk, actuators.led.feet.right);
-        } else if (name == "Skull") {
-            msgpackPack(pk, actuators.led.skull);
-        } else if (name == "Sonar") {
-            pk.pack_array(2);
-            pk.pack(actuators.sonar.left);
-            pk.pack(actuators.sonar.right);
-        } else {
-            std::cerr << "Error: no handler for actuator chain '" << name << "' defined!" << std::endl;
-            exit(3);
-        }
-    }
-
-    //std::cerr << std::endl << msgpack::unpack(buffer.data(), buffer.size()).get() << std::endl;
-    return buffer;
+    // patch actuator values into msgpack template
+    return actuatorEncoder.encode(actuators);
 }
 
 void Connector::say(const std::string &text) {
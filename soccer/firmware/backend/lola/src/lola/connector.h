@@ -9,12 +9,12 @@
 
 #include <libbembelbots/monitor_shm.hpp>
 #include <libbembelbots/bembelbots_shm.h>
-#include <msgpack/v2/object_fwd.hpp>
-#include <msgpack/v2/object_fwd_decl.hpp>
 
 #include <ipc_sensor_message_generated.h>
 #include <ipc_actuator_message_generated.h>
 
+#include "msgpack_codec.h"
+
 namespace lola {
 
 class Connector {
@@ -54,6 +54,8 @@ private:
     bbipc::Sensors &sensors;
     bbipc::Actuators &actuators;
 
+    ActuatorEncoder actuatorEncoder;
+
     void calibrateGyro();
     void setIdleLeds();
     void setEarLeds();
@@ -61,8 +63,8 @@ private:
     void toggleFrontend(const bool start) const;
     void buttonHandler();
 
-    void readSensors(const msgpack::object &obj);
-    msgpack::sbuffer &writeActuators();
+    bool readSensors(const char *pkt, size_t len);
+    std::string_view writeActuators();
 
     static void say(const std::string &text);
 };
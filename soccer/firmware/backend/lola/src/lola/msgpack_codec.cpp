@@ -0,0 +1,366 @@
+#include "msgpack_codec.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <endian.h>
+
+namespace lola {
+
+namespace {
+
+// msgpack format tags, see https://github.com/msgpack/msgpack/blob/master/spec.md
+enum Tag : uint8_t {
+    FIXMAP = 0x80,
+    FIXARRAY = 0x90,
+    FIXSTR = 0xa0,
+    BOOL_FALSE = 0xc2,
+    BOOL_TRUE = 0xc3,
+    FLOAT32 = 0xca,
+    FLOAT64 = 0xcb,
+    UINT8 = 0xcc,
+    UINT16 = 0xcd,
+    UINT32 = 0xce,
+    UINT64 = 0xcf,
+    INT8 = 0xd0,
+    INT16 = 0xd1,
+    INT32 = 0xd2,
+    INT64 = 0xd3,
+    STR8 = 0xd9,
+    STR16 = 0xda,
+    STR32 = 0xdb,
+    ARRAY16 = 0xdc,
+    ARRAY32 = 0xdd,
+    MAP16 = 0xde,
+    MAP32 = 0xdf,
+};
+
+class Reader {
+public:
+    Reader(const char *pkt, size_t len)
+      : p(reinterpret_cast<const uint8_t *>(pkt))
+      , end(p + len) {}
+
+    bool mapSize(uint32_t &n) {
+        const uint8_t t{tag()};
+        if ((t & 0xf0) == FIXMAP) {
+            n = t & 0x0f;
+            return ok;
+        }
+        return sized(t, MAP16, MAP32, n);
+    }
+
+    bool arraySize(uint32_t &n) {
+        const uint8_t t{tag()};
+        if ((t & 0xf0) == FIXARRAY) {
+            n = t & 0x0f;
+            return ok;
+        }
+        return sized(t, ARRAY16, ARRAY32, n);
+    }
+
+    bool str(std::string_view &s) {
+        const uint8_t t{tag()};
+        uint32_t n{0};
+        if ((t & 0xe0) == FIXSTR) {
+            n = t & 0x1f;
+        } else if (t == STR8) {
+            n = be<uint8_t>();
+        } else if (!sized(t, STR16, STR32, n)) {
+            return false;
+        }
+
+        if (!ok || static_cast<size_t>(end - p) < n)
+            return ok = false;
+        s = {reinterpret_cast<const char *>(p), n};
+        p += n;
+        return true;
+    }
+
+    template<typename T>
+    bool number(T &v) {
+        const uint8_t t{tag()};
+        if (t < 0x80) { // positive fixint
+            v = static_cast<T>(t);
+            return ok;
+        }
+        if (t >= 0xe0) { // negative fixint
+            v = static_cast<T>(static_cast<int8_t>(t));
+            return ok;
+        }
+
+        switch (t) {
+            case FLOAT32: {
+                const uint32_t u{be<uint32_t>()};
+                float f;
+                std::memcpy(&f, &u, sizeof(f));
+                v = static_cast<T>(f);
+                break;
+            }
+            case FLOAT64: {
+                const uint64_t u{be<uint64_t>()};
+                double d;
+                std::memcpy(&d, &u, sizeof(d));
+                v = static_cast<T>(d);
+                break;
+            }
+            case UINT8: v = static_cast<T>(be<uint8_t>()); break;
+            case UINT16: v = static_cast<T>(be<uint16_t>()); break;
+            case UINT32: v = static_cast<T>(be<uint32_t>()); break;
+            case UINT64: v = static_cast<T>(be<uint64_t>()); break;
+            case INT8: v = static_cast<T>(static_cast<int8_t>(be<uint8_t>())); break;
+            case INT16: v = static_cast<T>(static_cast<int16_t>(be<uint16_t>())); break;
+            case INT32: v = static_cast<T>(static_cast<int32_t>(be<uint32_t>())); break;
+            case INT64: v = static_cast<T>(static_cast<int64_t>(be<uint64_t>())); break;
+            default: return ok = false;
+        }
+        return ok;
+    }
+
+    // array of exactly N numbers
+    template<typename T, size_t N>
+    bool array(std::array<T, N> &a) {
+        uint32_t n{0};
+        if (!arraySize(n) || n != N)
+            return ok = false;
+        for (auto &v : a) {
+            if (!number(v))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    const uint8_t *p;
+    const uint8_t *end;
+    bool ok{true};
+
+    uint8_t tag() {
+        if (p >= end) {
+            ok = false;
+            return 0;
+        }
+        return *p++;
+    }
+
+    template<typename U>
+    U be() {
+        if (static_cast<size_t>(end - p) < sizeof(U)) {
+            ok = false;
+            return 0;
+        }
+        U u;
+        std::memcpy(&u, p, sizeof(U));
+        p += sizeof(U);
+        if constexpr (sizeof(U) == 2) {
+            return be16toh(u);
+        } else if constexpr (sizeof(U) == 4) {
+            return be32toh(u);
+        } else if constexpr (sizeof(U) == 8) {
+            return be64toh(u);
+        }
+        return u;
+    }
+
+    bool sized(uint8_t t, uint8_t tag16, uint8_t tag32, uint32_t &n) {
+        if (t == tag16) {
+            n = be<uint16_t>();
+        } else if (t == tag32) {
+            n = be<uint32_t>();
+        } else {
+            ok = false;
+        }
+        return ok;
+    }
+};
+
+// float32 tag + big endian value, a bool is a single tag byte
+static constexpr size_t FLOAT_SIZE{5};
+
+class Writer {
+public:
+    explicit Writer(std::vector<char> &buf)
+      : buf(buf) {}
+
+    void map(uint8_t n) { put(FIXMAP | n); }
+
+    void str(std::string_view s) {
+        put(FIXSTR | s.size());
+        buf.insert(buf.end(), s.begin(), s.end());
+    }
+
+    void array(uint16_t n) {
+        if (n < 16) {
+            put(FIXARRAY | n);
+        } else {
+            put(ARRAY16);
+            put(n >> 8);
+            put(n & 0xff);
+        }
+    }
+
+    // placeholder values, @return offset of the first value
+    size_t floats(size_t n) {
+        const size_t offset{buf.size()};
+        for (size_t i = 0; i < n; ++i) {
+            put(FLOAT32);
+            buf.insert(buf.end(), 4, 0);
+        }
+        return offset;
+    }
+
+    size_t bools(size_t n) {
+        const size_t offset{buf.size()};
+        buf.insert(buf.end(), n, static_cast<char>(BOOL_FALSE));
+        return offset;
+    }
+
+private:
+    std::vector<char> &buf;
+
+    void put(uint8_t b) { buf.push_back(static_cast<char>(b)); }
+};
+
+// overwrite n values of an already tagged float32 run
+inline void patch(char *dst, const float *src, size_t n) {
+    for (size_t i = 0; i < n; ++i, dst += FLOAT_SIZE) {
+        uint32_t u;
+        std::memcpy(&u, &src[i], sizeof(u));
+        u = htobe32(u);
+        std::memcpy(dst + 1, &u, sizeof(u));
+    }
+}
+
+inline void patch(char *dst, const bbipc::LEDSingle &led) {
+    const float rgb[3]{led.r, led.g, led.b};
+    patch(dst, rgb, 3);
+}
+
+template<size_t N>
+inline void patch(char *dst, const bbipc::LEDString<N> &led) {
+    patch(dst, led.r.data(), N);
+    patch(dst + N * FLOAT_SIZE, led.g.data(), N);
+    patch(dst + 2 * N * FLOAT_SIZE, led.b.data(), N);
+}
+
+} // namespace
+
+DecodeResult decodeSensors(const char *pkt, size_t len, bbipc::Sensors &sensors, RobotConfigView &rc,
+        std::string_view &key) {
+    Reader r(pkt, len);
+
+    uint32_t entries{0};
+    if (!r.mapSize(entries))
+        return DecodeResult::MALFORMED;
+
+    rc = {};
+    for (uint32_t i = 0; i < entries; ++i) {
+        if (!r.str(key))
+            return DecodeResult::MALFORMED;
+
+        bool ok{false};
+        if (key == "Stiffness") {
+            ok = r.array(sensors.joints.stiffness);
+        } else if (key == "Position") {
+            ok = r.array(sensors.joints.position);
+        } else if (key == "Temperature") {
+            ok = r.array(sensors.joints.temperature);
+        } else if (key == "Current") {
+            ok = r.array(sensors.joints.current);
+        } else if (key == "Status") {
+            ok = r.array(sensors.joints.status);
+        } else if (key == "Battery") {
+            std::array<float, 4> a;
+            ok = r.array(a);
+            const auto &[charge, status, current, temp] = a;
+            sensors.battery = {.charge = charge, .current = current, .status = status, .temperature = temp};
+        } else if (key == "Accelerometer") {
+            std::array<float, 3> a;
+            ok = r.array(a);
+            sensors.imu.accelerometer << a[0], a[1], a[2];
+        } else if (key == "Gyroscope") {
+            std::array<float, 3> a;
+            ok = r.array(a);
+            sensors.imu.gyroscope << a[0], a[1], a[2];
+        } else if (key == "Angles") {
+            std::array<float, 2> a;
+            ok = r.array(a);
+            sensors.imu.angles << a[0], a[1];
+        } else if (key == "Sonar") {
+            std::array<float, 2> a;
+            ok = r.array(a);
+            sensors.sonar = {a[0], a[1]};
+        } else if (key == "FSR") {
+            std::array<float, 8> a;
+            ok = r.array(a);
+            sensors.fsr.left.arr = {a[0], a[1], a[2], a[3]};
+            sensors.fsr.right.arr = {a[4], a[5], a[6], a[7]};
+        } else if (key == "Touch") {
+            std::array<float, 14> a;
+            ok = r.array(a);
+            sensors.touch.chest.button = a[0];
+            sensors.touch.head = {a[1], a[2], a[3]};
+            sensors.touch.feet.left = {a[4], a[5]};
+            sensors.touch.hands.left = {a[6], a[7], a[8]};
+            sensors.touch.feet.right = {a[9], a[10]};
+            sensors.touch.hands.right = {a[11], a[12], a[13]};
+        } else if (key == "RobotConfig") {
+            uint32_t n{0};
+            ok = r.arraySize(n) && (n == 4) && r.str(rc.bodyId) && r.str(rc.bodyVersion) && r.str(rc.headId) &&
+                 r.str(rc.headVersion);
+        } else {
+            return DecodeResult::UNKNOWN_KEY;
+        }
+
+        if (!ok)
+            return DecodeResult::MALFORMED;
+    }
+
+    return DecodeResult::OK;
+}
+
+ActuatorEncoder::ActuatorEncoder() {
+    static constexpr std::array<size_t, LOLA_ACTUATOR_NAMES.size()> sizes{
+            LOLA_NUMBER_OF_JOINTS,                   // Position
+            LOLA_NUMBER_OF_JOINTS,                   // Stiffness
+            std::tuple_size_v<bbipc::LEDEar>,        // REar
+            std::tuple_size_v<bbipc::LEDEar>,        // LEar
+            3,                                       // Chest
+            3 * bbipc::LEDString<8>::NUM_LEDS,       // LEye
+            3 * bbipc::LEDString<8>::NUM_LEDS,       // REye
+            3,                                       // LFoot
+            3,                                       // RFoot
+            std::tuple_size_v<bbipc::LEDSkull>,      // Skull
+            2,                                       // Sonar
+    };
+
+    Writer w(buf);
+    w.map(LOLA_ACTUATOR_NAMES.size());
+    for (size_t i = 0; i < LOLA_ACTUATOR_NAMES.size(); ++i) {
+        w.str(LOLA_ACTUATOR_NAMES[i]);
+        w.array(sizes[i]);
+        offsets[i] = (LOLA_ACTUATOR_NAMES[i] == "Sonar") ? w.bools(sizes[i]) : w.floats(sizes[i]);
+    }
+}
+
+std::string_view ActuatorEncoder::encode(const bbipc::Actuators &a) {
+    char *b{buf.data()};
+    patch(b + offsets[0], a.joints.position.data(), a.joints.position.size());
+    patch(b + offsets[1], a.joints.stiffness.data(), a.joints.stiffness.size());
+    patch(b + offsets[2], a.led.ears.right.data(), a.led.ears.right.size());
+    patch(b + offsets[3], a.led.ears.left.data(), a.led.ears.left.size());
+    patch(b + offsets[4], a.led.chest);
+    patch(b + offsets[5], a.led.eyes.left);
+    patch(b + offsets[6], a.led.eyes.right);
+    patch(b + offsets[7], a.led.feet.left);
+    patch(b + offsets[8], a.led.feet.right);
+    patch(b + offsets[9], a.led.skull.data(), a.led.skull.size());
+    b[offsets[10]] = static_cast<char>(a.sonar.left ? BOOL_TRUE : BOOL_FALSE);
+    b[offsets[10] + 1] = static_cast<char>(a.sonar.right ? BOOL_TRUE : BOOL_FALSE);
+
+    return {buf.data(), buf.size()};
+}
+
+} // namespace lola
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include <representations/flatbuffers/types/actuators.h>
+#include <representations/flatbuffers/types/sensors.h>
+
+namespace lola {
+
+static constexpr std::array<std::string_view, 11> LOLA_ACTUATOR_NAMES{
+        "Position", "Stiffness", "REar", "LEar", "Chest", "LEye", "REye", "LFoot", "RFoot", "Skull", "Sonar"};
+
+// hardware ids from the "RobotConfig" key, pointing into the received packet
+struct RobotConfigView {
+    std::string_view bodyId, bodyVersion, headId, headVersion;
+
+    bool empty() const { return headId.empty() && bodyId.empty(); }
+};
+
+enum class DecodeResult { OK, MALFORMED, UNKNOWN_KEY };
+
+/**
+ * Fixed schema msgpack decoder for LoLA sensor packets.
+ * Walks the packet in place and writes all values straight into sensors,
+ * without building a msgpack object tree, so nothing is allocated.
+ * @param key: last key that has been read, useful for error messages
+ */
+DecodeResult decodeSensors(const char *pkt, size_t len, bbipc::Sensors &sensors, RobotConfigView &rc,
+        std::string_view &key);
+
+/**
+ * Fixed schema msgpack encoder for LoLA actuator packets.
+ * The complete packet (keys, array headers, type tags) is built once,
+ * encode() only patches the values in place.
+ * Output is byte identical to packing every value with msgpack::packer::pack_float.
+ */
+class ActuatorEncoder {
+public:
+    ActuatorEncoder();
+
+    // returned view stays valid until the next call
+    std::string_view encode(const bbipc::Actuators &actuators);
+
+private:
+    std::vector<char> buf;
+
+    // offset of the first value of every chain, in order of LOLA_ACTUATOR_NAMES
+    std::array<size_t, LOLA_ACTUATOR_NAMES.size()> offsets;
+};
+
+} // namespace lola
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -6,7 +6,7 @@
 #include <framework/ipc/tripple_buffer.h>
 #include "flatbuffers_shm.hpp"
 
-static constexpr uint8_t BB_BACKEND_VERSION{4};
+static constexpr uint8_t BB_BACKEND_VERSION{6};
 
 struct BembelbotsShmContent {
     ipc::TrippleBuffer<BembelbotsShmFlatbuffer<bbapi::BembelIpcSensorMessage>> sensors;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <new>
+
 #include <flatbuffers/flatbuffer_builder.h>
 
 template<typename FB>
@@ -10,33 +14,77 @@ public:
     // ensure buffer always contains valid flatbuffer string
     BembelbotsShmFlatbuffer() { set(); }
 
+    // Pack flatbuffer directly into SHM, the builder neither allocates nor copies.
     bool set(const NativeTableType &sm = {}) {
-        // pack flatbuffer
-        flatbuffers::FlatBufferBuilder builder;
-        auto packed = FB::Pack(builder, &sm);
-        builder.FinishSizePrefixed(packed);
-
-        // sanity check
-        if (builder.GetSize() > BB_SHM_BUF_SIZE)
+        ShmAllocator allocator(data, BB_SHM_BUF_SIZE);
+        flatbuffers::FlatBufferBuilder builder(BB_SHM_BUF_SIZE, &allocator);
+        try {
+            auto packed = FB::Pack(builder, &sm);
+            builder.FinishSizePrefixed(packed);
+        } catch (const std::bad_alloc &) {
+            // message does not fit into SHM
+            offset = BB_SHM_BUF_SIZE;
             return false;
+        }
 
-        // copy to SHM
-        std::memcpy(data, builder.GetBufferPointer(), builder.GetSize());
+        // flatbuffers are built back to front, so the message ends at the end of the buffer
+        offset = builder.GetBufferPointer() - data;
         return true;
     }
 
+    // Zero copy access to the flatbuffer in SHM, nullptr if it is invalid.
+    // The pointer stays valid until the buffer is written again.
+    const FB *view() const {
+        if (offset >= BB_SHM_BUF_SIZE) {
+            return nullptr;
+        }
+
+        flatbuffers::Verifier v(data + offset, BB_SHM_BUF_SIZE - offset);
+        if (!v.VerifySizePrefixedBuffer<FB>(nullptr)) {
+            return nullptr;
+        }
+
+        return ::flatbuffers::GetSizePrefixedRoot<FB>(data + offset);
+    }
+
+    // Unpack into an existing object. Members are reused, so this does not
+    // allocate after the first call.
     bool get(NativeTableType &fb) const {
-        flatbuffers::Verifier v(data, BB_SHM_BUF_SIZE);
-        if (!v.VerifySizePrefixedBuffer<FB>(nullptr))
+        auto *root{view()};
+        if (root == nullptr) {
             return false;
+        }
 
-        auto *root{::flatbuffers::GetSizePrefixedRoot<FB>(data)};
         root->UnPackTo(&fb);
-
         return true;
     }
 
 private:
     static constexpr size_t BB_SHM_BUF_SIZE{2048};
-    uint8_t data[BB_SHM_BUF_SIZE];
+
+    // hands out the SHM buffer to the FlatBufferBuilder, which must never grow beyond it
+    class ShmAllocator : public flatbuffers::Allocator {
+    public:
+        ShmAllocator(uint8_t *buf, size_t size) : buf(buf), size(size) {}
+
+        uint8_t *allocate(size_t n) override {
+            if (n > size) {
+                throw std::bad_alloc();
+            }
+            return buf + (size - n);
+        }
+
+        void deallocate(uint8_t *, size_t) override {}
+
+        uint8_t *reallocate_downward(uint8_t *, size_t, size_t, size_t, size_t) override {
+            throw std::bad_alloc();
+        }
+
+    private:
+        uint8_t *buf;
+        size_t size;
+    };
+
+    uint32_t offset{BB_SHM_BUF_SIZE};
+    alignas(8) uint8_t data[BB_SHM_BUF_SIZE];
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Latency statistics for the offline benchmarks.
+ *
+ * Every benchmark reports the same table, one row per measured thing:
+ *
+ *   benchmark::printLatencyHeader("stage");
+ *   benchmark::printLatency("frame", frameNs, 1000.0); // ns -> us
+ *
+ *   stage                     mean     p50     p90     p99      max       n
+ *   frame                    812.4   790.0   901.0  1204.0   2210.0    3000
+ */
+namespace benchmark {
+
+// nearest rank percentile, samples have to be sorted
+inline int64_t percentile(const std::vector<int64_t> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+inline void printLatencyHeader(const std::string &title, std::ostream &os = std::cout) {
+    os << "  " << std::left << std::setw(22) << title << std::right
+       << std::setw(9) << "mean" << std::setw(9) << "p50" << std::setw(9) << "p90"
+       << std::setw(9) << "p99" << std::setw(10) << "max" << std::setw(8) << "n" << std::endl;
+}
+
+// prints one row, samples are sorted and divided by divisor for printing
+inline void printLatency(const std::string &name, std::vector<int64_t> &samples,
+        double divisor = 1.0, std::ostream &os = std::cout) {
+    std::sort(samples.begin(), samples.end());
+    double mean = 0;
+    for (int64_t t : samples) {
+        mean += t / divisor / samples.size();
+    }
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+       << std::setw(9) << mean
+       << std::setw(9) << percentile(samples, 50) / divisor
+       << std::setw(9) << percentile(samples, 90) / divisor
+       << std::setw(9) << percentile(samples, 99) / divisor
+       << std::setw(10) << (samples.empty() ? 0 : samples.back()) / divisor
+       << std::setw(8) << samples.size() << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace benchmark
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
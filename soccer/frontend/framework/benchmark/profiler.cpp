@@ -0,0 +1,243 @@
+#include "profiler.h"
+
+#include <framework/common/macros.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define PROFILER_USE_TSC 1
+#else
+# define PROFILER_USE_TSC 0
+#endif
+
+namespace profiler {
+
+namespace {
+
+int64_t rawNanoseconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// written by every thread, read by collect()
+// Only the owning thread writes, so load + store is enough and avoids locked instructions.
+struct ZoneCounters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> maxTicks{0};
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> histogram{};
+};
+
+struct ThreadStats {
+    std::array<ZoneCounters, MAX_ZONES> zones;
+};
+
+struct Registry {
+    std::mutex mtx;
+    std::vector<std::string> names;
+    bool overflowReported{false};
+    // stats of the running threads
+    std::vector<std::unique_ptr<ThreadStats>> threads;
+    // sums of exited threads, so the sums never decrease
+    ThreadStats retired;
+    // zeroed stats of exited threads, reused by new threads.
+    // Threads come and go every frame (std::async), this keeps memory bounded.
+    std::vector<std::unique_ptr<ThreadStats>> spare;
+};
+
+Registry &registry() {
+    static Registry r;
+    return r;
+}
+
+double calibrate() {
+#if PROFILER_USE_TSC
+    const int64_t ns0 = rawNanoseconds();
+    const int64_t tsc0 = static_cast<int64_t>(__rdtsc());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const int64_t ns1 = rawNanoseconds();
+    const int64_t tsc1 = static_cast<int64_t>(__rdtsc());
+    return (ns1 - ns0) / 1000.0 / (tsc1 - tsc0);
+#else
+    return 1.0 / 1000.0;
+#endif
+}
+
+// set before the first zone is returned, so record() always sees it
+std::atomic<double> usPerTick{0};
+
+// the id past the last zone, calls are dropped
+constexpr ZoneId INVALID_ZONE{MAX_ZONES};
+
+// read by record(), trivially destructible to keep the access cheap
+thread_local ThreadStats *localStats{nullptr};
+
+void retireThreadStats(ThreadStats *stats);
+
+// retires the stats of its thread, when the thread exits
+struct ThreadStatsOwner {
+    ThreadStats *stats{nullptr};
+
+    ~ThreadStatsOwner() {
+        if (stats != nullptr) {
+            retireThreadStats(stats);
+            localStats = nullptr;
+        }
+    }
+};
+
+thread_local ThreadStatsOwner localOwner;
+
+ThreadStats *createThreadStats() {
+    auto &r = registry();
+    std::scoped_lock lock(r.mtx);
+    if (r.spare.empty()) {
+        r.threads.push_back(std::make_unique<ThreadStats>());
+    } else {
+        r.threads.push_back(std::move(r.spare.back()));
+        r.spare.pop_back();
+    }
+    localOwner.stats = r.threads.back().get();
+    return localOwner.stats;
+}
+
+void retireThreadStats(ThreadStats *stats) {
+    auto &r = registry();
+    std::scoped_lock lock(r.mtx);
+    for (size_t z = 0; z < MAX_ZONES; z++) {
+        ZoneCounters &from = stats->zones[z];
+        ZoneCounters &to = r.retired.zones[z];
+        to.count += from.count.exchange(0, std::memory_order_relaxed);
+        to.ticks += from.ticks.exchange(0, std::memory_order_relaxed);
+        const uint64_t maxTicks = from.maxTicks.exchange(0, std::memory_order_relaxed);
+        if (maxTicks > to.maxTicks.load(std::memory_order_relaxed)) {
+            to.maxTicks.store(maxTicks, std::memory_order_relaxed);
+        }
+        for (size_t b = 0; b < NUM_BUCKETS; b++) {
+            to.histogram[b] += from.histogram[b].exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    auto it = std::find_if(r.threads.begin(), r.threads.end(),
+            [stats](const auto &thread) { return thread.get() == stats; });
+    r.spare.push_back(std::move(*it));
+    r.threads.erase(it);
+}
+
+void add(std::vector<ZoneStats> &result, ThreadStats &thread) {
+    for (size_t z = 0; z < result.size(); z++) {
+        ZoneCounters &c = thread.zones[z];
+        ZoneStats &s = result[z];
+        s.count += c.count.load(std::memory_order_relaxed);
+        s.ticks += c.ticks.load(std::memory_order_relaxed);
+        // a racing store of the owner only moves its maximum into the next period
+        s.maxTicks = std::max(s.maxTicks, c.maxTicks.exchange(0, std::memory_order_relaxed));
+        for (size_t b = 0; b < NUM_BUCKETS; b++) {
+            s.histogram[b] += c.histogram[b].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+inline void increment(std::atomic<uint64_t> &counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline size_t bucket(int64_t ticks) {
+    const auto us = static_cast<uint64_t>(ticks * usPerTick.load(std::memory_order_relaxed));
+    if (us == 0) {
+        return 0;
+    }
+    return std::min<size_t>(64 - __builtin_clzll(us), NUM_BUCKETS - 1);
+}
+
+} // namespace
+
+int64_t now() {
+#if PROFILER_USE_TSC
+    return static_cast<int64_t>(__rdtsc());
+#else
+    return rawNanoseconds();
+#endif
+}
+
+double microsecondsPerTick() {
+    static const double value = calibrate();
+    return value;
+}
+
+float bucketUpperUs(size_t b) {
+    if (b + 1 >= NUM_BUCKETS) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return static_cast<float>(uint64_t{1} << b);
+}
+
+Zone::Zone(std::string_view name) {
+    const double tick = microsecondsPerTick();
+
+    auto &r = registry();
+    std::scoped_lock lock(r.mtx);
+    usPerTick.store(tick, std::memory_order_relaxed);
+
+    auto it = std::find(r.names.begin(), r.names.end(), name);
+    if (it != r.names.end()) {
+        zoneId = static_cast<ZoneId>(it - r.names.begin());
+    } else if (r.names.size() < MAX_ZONES) {
+        zoneId = static_cast<ZoneId>(r.names.size());
+        r.names.emplace_back(name);
+    } else {
+        zoneId = INVALID_ZONE;
+        if (not r.overflowReported) {
+            r.overflowReported = true;
+            LOG_WARN << "profiler: more than " << MAX_ZONES << " zones, ignoring " << name;
+        }
+    }
+}
+
+void record(ZoneId zone, int64_t ticks) {
+    if (UNLIKELY(zone >= MAX_ZONES)) {
+        return;
+    }
+    if (UNLIKELY(localStats == nullptr)) {
+        localStats = createThreadStats();
+    }
+
+    // the TSC of different cores may differ slightly, when a thread migrates
+    const auto t = static_cast<uint64_t>(std::max<int64_t>(ticks, 0));
+    ZoneCounters &c = localStats->zones[zone];
+    increment(c.count, 1);
+    increment(c.ticks, t);
+    increment(c.histogram[bucket(t)], 1);
+    if (t > c.maxTicks.load(std::memory_order_relaxed)) {
+        c.maxTicks.store(t, std::memory_order_relaxed);
+    }
+}
+
+std::vector<ZoneStats> collect() {
+    auto &r = registry();
+    std::scoped_lock lock(r.mtx);
+
+    std::vector<ZoneStats> result(r.names.size());
+    for (size_t z = 0; z < result.size(); z++) {
+        result[z].name = r.names[z];
+    }
+
+    add(result, r.retired);
+    for (auto &thread : r.threads) {
+        add(result, *thread);
+    }
+    return result;
+}
+
+} // namespace profiler
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
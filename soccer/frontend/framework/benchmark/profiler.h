@@ -0,0 +1,92 @@
+#pragma once
+
+#include <framework/logger/logger.h> // BUILD_VARNAME
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Always-on scope profiler.
+ *
+ * A zone is a named code region. Its name is interned once per call site,
+ * afterwards entering and leaving a zone reads the cycle counter twice and
+ * updates a few counters in a buffer of the calling thread, without locks
+ * and without shared cache lines.
+ *
+ *   void Vision::process() {
+ *       PROFILE_ZONE("vision.process");
+ *       ...
+ *   }
+ *
+ * collect() sums all threads up, the Profiling module publishes the result
+ * once per second as bbapi::ProfilerMessageT.
+ */
+namespace profiler {
+
+using ZoneId = uint16_t;
+
+static constexpr size_t MAX_ZONES{256};
+// bucket b counts durations below 2^b us, the last bucket is open
+static constexpr size_t NUM_BUCKETS{20};
+
+// raw timestamp in ticks: the TSC on x86, else CLOCK_MONOTONIC_RAW in ns
+int64_t now();
+
+// tick length in microseconds
+double microsecondsPerTick();
+
+// exclusive upper bound of bucket b in microseconds, infinity for the last one
+float bucketUpperUs(size_t b);
+
+class Zone {
+public:
+    // zones with the same name share their statistics
+    explicit Zone(std::string_view name);
+
+    ZoneId id() const { return zoneId; }
+
+private:
+    ZoneId zoneId;
+};
+
+// add one call of zone, that took ticks
+void record(ZoneId zone, int64_t ticks);
+
+class Scope {
+public:
+    explicit Scope(const Zone &zone) : zone(zone.id()), start(now()) {}
+    ~Scope() { record(zone, now() - start); }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    ZoneId zone;
+    int64_t start;
+};
+
+struct ZoneStats {
+    std::string name;
+    uint64_t count{0};
+    uint64_t ticks{0};
+    uint64_t maxTicks{0};   // since the previous collect()
+    std::array<uint64_t, NUM_BUCKETS> histogram{};
+};
+
+// Statistics of every zone summed over all threads since the start of the process,
+// indexed by ZoneId. Must not be called concurrently.
+std::vector<ZoneStats> collect();
+
+} // namespace profiler
+
+// profile the rest of the enclosing scope, name must be a string literal
+#define PROFILE_ZONE(name) \
+    static const ::profiler::Zone BUILD_VARNAME(profilerZone_, __LINE__){name}; \
+    const ::profiler::Scope BUILD_VARNAME(profilerScope_, __LINE__){BUILD_VARNAME(profilerZone_, __LINE__)}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -1,6 +1,7 @@
 #include "introspection.h"
 
 #include "../logger/logger.h"
+#include "../util/assert.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -9,33 +10,59 @@ using namespace std;
 using namespace boost::property_tree;
 
 Introspection::Introspection() :
-    _varPrefix("snapshot")
+    Introspection("snapshot")
 { }
 
 Introspection::Introspection(const std::string &varPrefix) :
-    _varPrefix(varPrefix)
+    _varPrefix(varPrefix),
+    _schema(std::make_shared<Schema>())
 { }
 
+Introspection::SymbolId Introspection::findSymbol(const std::string &name) const {
+    auto it = _schema->ids.find(name);
+    return it != _schema->ids.end() ? it->second : INVALID_SYMBOL;
+}
+
+BlackboardDataContainer Introspection::getValue(SymbolId id) const {
+    const Symbol &symbol = symbols()[id];
+    return symbol.format(_varPrefix + "." + symbol.name, valuePtr(id));
+}
+
+bool Introspection::setValue(const std::string &name, const std::string &s) {
+    const SymbolId id = findSymbol(name);
+    if (id == INVALID_SYMBOL || symbols()[id].parse == nullptr) {
+        return false;
+    }
+    symbols()[id].parse(s, at<void>(symbols()[id].value));
+    return true;
+}
+
 void Introspection::setDebugSymbol(const std::string &name,
                                    const bool &value) {
-    if (_debugValues.count(name) == 0) {
+    const SymbolId id = findSymbol(name);
+    if (id == INVALID_SYMBOL) {
 #ifndef STANDALONE_BEHAVIOR
         LOG_WARN << "key " << name << " not found in debug map!";
 #endif
         return;
     }
-    *_debugValues[name] = value;
+    *at<bool>(symbols()[id].debug) = value;
 }
 
 std::vector<std::string> Introspection::getDebugSymbols() const {
-    return _debugVariables;
+    std::vector<std::string> r;
+    r.reserve(symbols().size());
+    for (const auto &symbol : symbols()) {
+        r.push_back(symbol.name);
+    }
+    return r;
 }
 
-std::vector<bool> Introspection::getDebugValues() {
-    std::vector<std::string> symbols = getDebugSymbols();
+std::vector<bool> Introspection::getDebugValues() const {
     std::vector<bool> r;
-    for (size_t i = 0; i < symbols.size(); ++i) {
-        r.push_back(*_debugValues[symbols[i]]);
+    r.reserve(symbols().size());
+    for (SymbolId id = 0; id < symbols().size(); ++id) {
+        r.push_back(isDebugged(id));
     }
     return r;
 }
@@ -45,24 +72,27 @@ void Introspection::updateDebugSymbols(const std::vector< std::pair<std::string,
 #ifndef STANDALONE_BEHAVIOR
         LOG_INFO << "set symbol " << p.first << " to " << p.second;
 #endif
-        try {
-            auto &val = _debugValues.at(p.first);
-            *val = (p.second == std::string("1"));
-        } catch(...) {
+        const SymbolId id = findSymbol(p.first);
+        if (id == INVALID_SYMBOL) {
             LOG_ERROR << "failed to set symbol " << p.first << " to " << p.second;
+            continue;
         }
+        *at<bool>(symbols()[id].debug) = (p.second == std::string("1"));
     }
 }
 
-bool Introspection::isEditable(const std::string &key) {
-    auto it = _set_funcs.find(key);
-    return it != _set_funcs.end();
+bool Introspection::isEditable(const std::string &key) const {
+    const SymbolId id = findSymbol(key);
+    return id != INVALID_SYMBOL && symbols()[id].parse != nullptr;
 }
 
 string Introspection::toJson() const {
     ptree asPt;
-    for (const auto &val : _get_funcs) {
-        BlackboardDataContainer con = val.second();
+    for (SymbolId id = 0; id < symbols().size(); ++id) {
+        if (not hasValue(id)) {
+            continue;
+        }
+        BlackboardDataContainer con = getValue(id);
         asPt.put(con.getKey(), con.getValue());
     }
     stringstream ss;
@@ -71,10 +101,30 @@ string Introspection::toJson() const {
 }
 
 void Introspection::addSwitch(bool *dbg, const std::string &name, const std::string &desc) {
+    addSymbol(dbg, name, desc, nullptr, 0, nullptr, nullptr);
+}
+
+void Introspection::addSymbol(bool *dbg, const std::string &name, const std::string &desc, const void *var,
+                              size_t size, tBBFormatFunc format, tBBParseFunc parse) {
     *dbg = false;
-    _debugVariables.push_back(name);
-    _debugDescriptions.insert(tStringPair(name, std::string(desc)));
-    _debugValues.insert(tStringBoolPair(name, dbg));
+
+    if (_schema.use_count() > 1) {
+        _schema = std::make_shared<Schema>(*_schema);
+    }
+    jsassert(_schema->symbols.size() < INVALID_SYMBOL) << "too many symbols in " << _varPrefix;
+
+    const SymbolId id = static_cast<SymbolId>(_schema->symbols.size());
+    auto [it, inserted] = _schema->ids.emplace(name, id);
+    if (not inserted) {
+        // setup() may run more than once, only a different variable with the same name is an error
+        const Symbol &existing = _schema->symbols[it->second];
+        if (existing.debug != offsetOf(dbg) || existing.value != (var ? offsetOf(var) : NO_VALUE)) {
+            LOG_WARN << "symbol " << _varPrefix << "." << name << " registered twice";
+        }
+        return;
+    }
+    _schema->symbols.push_back({name, desc, offsetOf(dbg), var ? offsetOf(var) : NO_VALUE,
+                                static_cast<uint32_t>(size), format, parse});
 }
 
 // vim: set ts=4 sw=4 sts=4 expandtab:
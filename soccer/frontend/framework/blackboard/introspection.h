@@ -2,11 +2,16 @@
 
 #include "datacontainer.h"
 
-#include <map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
 #include <sstream>
-#include <functional>
+#include <type_traits>
+#include <unordered_map>
 
 #include <boost/tokenizer.hpp>
 #include <boost/token_functions.hpp>
@@ -31,14 +36,13 @@ typedef std::pair<std::string, bool *> tStringBoolPair;
 #define INIT_VAR(varname, val, description) \
     _INIT_DEBUGGABLE(varname, val, description); \
     addVariable(&varname, &varname##_debug, #varname, description)
-/* _get_funcs[#varname] = getter_fabric(_varPrefix + "." + #varname, &varname) */
 
 #define INIT_VAR_RW(varname, val, description) \
     _INIT_DEBUGGABLE(varname, val, description); \
     addVariableRW(&varname, &varname##_debug, #varname, description)
 
 // macros for enums
-// reinterpret them as ints to avoid base64 encode & setter_fabric issues
+// reinterpret them as ints to avoid base64 encode & parse issues
 #define INIT_ENUM(varname, val, description) \
     _INIT_DEBUGGABLE(varname, val, description); \
     addVariable<int>(reinterpret_cast<int *>(&varname), &varname##_debug, #varname, description)
@@ -56,31 +60,55 @@ typedef std::pair<std::string, bool *> tStringBoolPair;
 // check if a variable is being debugged by bembelDbug
 #define DEBUG_ON(varname) varname##_debug
 
-class BlackboardDataContainer;
 class Introspection {
 
 public:
-    typedef std::function<void(const std::string &s)> tBBSetFunc;
-    typedef std::function<BlackboardDataContainer(void)> tBBGetFunc;
-
-    std::vector<std::string> _debugVariables;
-    std::map<std::string, std::string> _debugDescriptions;
-    std::map<std::string, bool *> _debugValues;
-    std::map<std::string, tBBSetFunc> _set_funcs;
-    std::map<std::string, tBBGetFunc> _get_funcs;
+    // dense index into symbols(), stable for the lifetime of the blackboard
+    using SymbolId = uint16_t;
+    static constexpr SymbolId INVALID_SYMBOL{std::numeric_limits<SymbolId>::max()};
+
+    typedef BlackboardDataContainer (*tBBFormatFunc)(const std::string &key, const void *value);
+    typedef void (*tBBParseFunc)(const std::string &s, void *value);
+
+    // Variables are stored as offsets from the Introspection object, so a copy
+    // of the blackboard (e.g. a Snapshot) shares the schema with the original.
+    struct Symbol {
+        std::string name;
+        std::string description;
+        ptrdiff_t debug;        // offset of the debug flag
+        ptrdiff_t value;        // offset of the variable, NO_VALUE for switches
+        uint32_t size;          // bytes of a trivially copyable variable, 0 if it has to be formatted
+        tBBFormatFunc format;   // nullptr for switches
+        tBBParseFunc parse;     // nullptr, if read only
+    };
+    static constexpr ptrdiff_t NO_VALUE{-1};
+    // larger variables are always formatted, comparing them is not worth it
+    static constexpr uint32_t MAX_RAW_SIZE{64};
 
     explicit Introspection();
     explicit Introspection(const std::string &varPrefix);
 
+    const std::vector<Symbol> &symbols() const { return _schema->symbols; }
+    SymbolId findSymbol(const std::string &name) const;
+
+    bool isDebugged(SymbolId id) const { return *at<bool>(symbols()[id].debug); }
+    bool hasValue(SymbolId id) const { return symbols()[id].value != NO_VALUE; }
+    // raw bytes of the variable, symbols()[id].size of them are trivially copyable
+    const void *valuePtr(SymbolId id) const { return at<void>(symbols()[id].value); }
+    // value serialized with framework/serialize, the symbol must have a value
+    BlackboardDataContainer getValue(SymbolId id) const;
+    // parse s into a writable variable, false if name is unknown or read only
+    bool setValue(const std::string &name, const std::string &s);
+
     // get symbols and values
     std::vector<std::string> getDebugSymbols() const;
-    std::vector<bool> getDebugValues();
+    std::vector<bool> getDebugValues() const;
 
     // set value(s) and update symbol state (broadcast: yes/no)
     void setDebugSymbol(const std::string &name, const bool &value);
     void updateDebugSymbols(const tStringPairList &pairs);
 
-    bool isEditable(const std::string &);
+    bool isEditable(const std::string &) const;
 
     //Convert the child-class to json.
     std::string toJson() const;
@@ -92,49 +120,71 @@ protected:
 
     template<typename T>
     void addVariable(T *var, bool *dbg, const std::string &name, const std::string &desc) {
-        addSwitch(dbg, name, desc);
-        _get_funcs[name] = getter_fabric(_varPrefix + "." + name, var);
+        addSymbol(dbg, name, desc, var, rawSize<T>(), &formatValue<T>, nullptr);
     }
 
     template<typename T>
     void addVariableRW(T *var, bool *dbg, const std::string &name, const std::string &desc) {
-        addVariable(var, dbg, name, desc);
-        _set_funcs[name] = setter_fabric(var);
+        addSymbol(dbg, name, desc, var, rawSize<T>(), &formatValue<T>, &parseValue<T>);
     }
 
-    //////  used inside the INIT_VAR-macro:
-    // when called, returns a function to ecapsulate the passed 'target'
-    // inside a "closure", a 'setter' (naodebug) actually calls the inner func
-    // and provides 's', which is den parsed and assigned.
+private:
+    struct Schema {
+        std::vector<Symbol> symbols;
+        std::unordered_map<std::string, SymbolId> ids;
+    };
+    // shared by all copies, copied before a symbol is added to a shared schema
+    std::shared_ptr<Schema> _schema;
+
+    void addSymbol(bool *dbg, const std::string &name, const std::string &desc, const void *var, size_t size,
+                   tBBFormatFunc format, tBBParseFunc parse);
+
     template<typename T>
-    static std::function<void(const std::string &)> setter_fabric(T *target) {
-        return [=](const std::string &s) -> void {
-            std::stringstream ss;
-            ss << s;
-            ss >> *target;
-        };
+    static constexpr size_t rawSize() {
+        return (std::is_trivially_copyable_v<T> && sizeof(T) <= MAX_RAW_SIZE) ? sizeof(T) : 0;
     }
 
-    template<typename T, size_t N>
-    static std::function<void(const std::string &)> setter_fabric(std::array<T, N> *target) {
-        return [=](const std::string &s) -> void {
-            size_t i{0};
-            boost::char_separator<char> sep{";"};
-            boost::tokenizer<boost::char_separator<char>> tok{s, sep};
-            for (const auto &t : tok) {
-                std::stringstream ss;
-                ss << t;
-                ss >> target->at(i);
-                ++i;
-            }
-        };
+    ptrdiff_t offsetOf(const void *p) const {
+        return reinterpret_cast<const char *>(p) - reinterpret_cast<const char *>(this);
+    }
+
+    template<typename T>
+    T *at(ptrdiff_t offset) const {
+        if (offset == NO_VALUE) {
+            return nullptr;
+        }
+        return reinterpret_cast<T *>(const_cast<char *>(reinterpret_cast<const char *>(this)) + offset);
     }
 
-    // the same pattern for the getter, the fabric returns a 'customized'
-    // function, which delivers the containing value as 'string', if being asked for
     template<typename T>
-    static std::function<BlackboardDataContainer(void)> getter_fabric(const std::string &key, const T *source) {
-        return [=](void) -> BlackboardDataContainer { return {key, *source}; };
+    static BlackboardDataContainer formatValue(const std::string &key, const void *value) {
+        return {key, *static_cast<const T *>(value)};
+    }
+
+    // used by INIT_VAR_RW: parses the string sent by naodebug into the variable
+    template<typename T>
+    static void parseValue(const std::string &s, void *value) {
+        parse(s, static_cast<T *>(value));
+    }
+
+    template<typename T>
+    static void parse(const std::string &s, T *target) {
+        std::stringstream ss;
+        ss << s;
+        ss >> *target;
+    }
+
+    template<typename T, size_t N>
+    static void parse(const std::string &s, std::array<T, N> *target) {
+        size_t i{0};
+        boost::char_separator<char> sep{";"};
+        boost::tokenizer<boost::char_separator<char>> tok{s, sep};
+        for (const auto &t : tok) {
+            std::stringstream ss;
+            ss << t;
+            ss >> target->at(i);
+            ++i;
+        }
     }
 };
 
@@ -2,8 +2,9 @@ set(BBBENCHMARK_PATH ${BBFRAMEWORK_PATH}/benchmark)
 
 target_sources(bbframework
 PRIVATE
-    ${BBBENCHMARK_PATH}/timer.cpp
+    ${BBBENCHMARK_PATH}/profiler.cpp
 )
 
 add_library(bbbenchmark INTERFACE)
 target_compile_features(bbbenchmark INTERFACE cxx_std_17)
+target_include_directories(bbbenchmark INTERFACE ${BBFRAMEWORK_PATH}/..)
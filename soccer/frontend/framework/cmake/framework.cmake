@@ -11,6 +11,7 @@ include(${BBFRAMEWORK_CMAKE_PATH}/network.cmake)
 include(${BBFRAMEWORK_CMAKE_PATH}/serialize.cmake)
 include(${BBFRAMEWORK_CMAKE_PATH}/benchmark.cmake)
 include(${BBFRAMEWORK_CMAKE_PATH}/thread.cmake)
+include(${BBFRAMEWORK_CMAKE_PATH}/ipc.cmake)
 
 target_include_directories(bbframework
 PUBLIC
@@ -31,6 +32,7 @@ PUBLIC
     bbserialize
     bbbenchmark
     bbthread
+    bbipc
     ${OpenCV_LIBS}
     PkgConfig::SPEECHD
 )
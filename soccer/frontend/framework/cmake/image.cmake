@@ -7,6 +7,7 @@ PRIVATE
     ${BBIMAGE_PATH}/yuv422.cpp
     ${BBIMAGE_PATH}/rgb.cpp
     ${BBIMAGE_PATH}/bl2.cpp
+    ${BBIMAGE_PATH}/jpeg.cpp
     ${BBIMAGE_PATH}/svg/body.cpp
     ${BBIMAGE_PATH}/svg/header.cpp
     ${BBIMAGE_PATH}/svg/image.cpp
@@ -14,4 +15,5 @@ PRIVATE
 
 add_library(bbimage INTERFACE)
 target_compile_features(bbimage INTERFACE cxx_std_17)
-target_link_libraries(bbimage INTERFACE bbrepr)
+target_link_libraries(bbimage INTERFACE bbrepr ${JPEG_LIBRARIES})
+target_include_directories(bbimage INTERFACE ${JPEG_INCLUDE_DIR})
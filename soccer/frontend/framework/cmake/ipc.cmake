@@ -0,0 +1,15 @@
+set(BBIPC_PATH ${BBFRAMEWORK_PATH}/ipc)
+
+add_library(bbipc INTERFACE)
+target_compile_features(bbipc INTERFACE cxx_std_17)
+target_link_libraries(bbipc INTERFACE pthread rt)
+
+add_executable(tripple_buffer_benchmark EXCLUDE_FROM_ALL
+    ${BBIPC_PATH}/benchmark/tripple_buffer_benchmark.cpp
+)
+target_include_directories(tripple_buffer_benchmark PRIVATE ${BBFRAMEWORK_PATH}/..)
+target_link_libraries(tripple_buffer_benchmark
+    bbipc
+    bbbenchmark
+    ${Boost_PROGRAM_OPTIONS_LIBRARY}
+)
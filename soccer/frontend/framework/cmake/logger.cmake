@@ -3,6 +3,7 @@ set(BBLOGGER_PATH ${BBFRAMEWORK_PATH}/logger)
 target_sources(bbframework
 PRIVATE
     ${BBLOGGER_PATH}/backends.cpp
+    ${BBLOGGER_PATH}/binarylog.cpp
     ${BBLOGGER_PATH}/logstream.cpp
     ${BBLOGGER_PATH}/xlogger.cpp
     #${BBLOGGER_PATH}/nao_say_backend.cpp
@@ -10,4 +11,12 @@ PRIVATE
 
 add_library(bblogger INTERFACE)
 target_compile_features(bblogger INTERFACE cxx_std_17)
-target_link_libraries(bblogger INTERFACE pthread)
\ No newline at end of file
+target_link_libraries(bblogger INTERFACE pthread)
+
+add_executable(log_benchmark EXCLUDE_FROM_ALL
+    ${BBLOGGER_PATH}/benchmark/log_benchmark.cpp
+)
+target_link_libraries(log_benchmark
+    bbframework
+    ${Boost_PROGRAM_OPTIONS_LIBRARY}
+)
@@ -4,6 +4,8 @@ target_sources(bbframework
 PRIVATE
     ${BBRUNTIME_PATH}/kernel.cpp
     ${BBRUNTIME_PATH}/meta.cpp
+    ${BBRUNTIME_PATH}/trace.cpp
+    ${BBRUNTIME_PATH}/stage_graph.cpp
     ${BBRUNTIME_PATH}/util/util.cpp
     ${BBRUNTIME_PATH}/util/type_info.cpp
     ${BBRUNTIME_PATH}/util/depth_first_search.cpp
@@ -134,6 +134,24 @@ void CamImage::write(std::ofstream &file) const {
     file.write(reinterpret_cast<const char *>(&principalPointY), sizeof(float)); // cppcheck-suppress invalidPointerCast
 }
 
+bool CamImage::read(std::ifstream &file) {
+    jsassert(data != nullptr);
+    file.read(reinterpret_cast<char *>(data), width * height * channels);
+
+    for (int i = 0; i < _eulers.v.size(); i++) {
+        file.read(reinterpret_cast<char *>(&_eulers.v[i]), sizeof(float));
+    }
+    for (int i = 0; i < _eulers.r.size(); i++) {
+        file.read(reinterpret_cast<char *>(&_eulers.r[i]), sizeof(float));
+    }
+    _eulerMatrixCached = false;
+
+    file.read(reinterpret_cast<char *>(&principalPointX), sizeof(float)); // cppcheck-suppress invalidPointerCast
+    file.read(reinterpret_cast<char *>(&principalPointY), sizeof(float)); // cppcheck-suppress invalidPointerCast
+
+    return static_cast<bool>(file);
+}
+
 CamImage CamImage::deepCopy() const {
     CamImage other(*this);
     uint8_t *d = new u_int8_t[height * width * channels];
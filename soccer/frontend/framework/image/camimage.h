@@ -71,6 +71,10 @@ public:
     // write image to a given filename destination.
     virtual void write(std::ofstream &file) const;
 
+    // read an image written by write(), data has to be allocated by the caller.
+    // @return false, if the file ended before a full image was read
+    bool read(std::ifstream &file);
+
     Eigen::Vector2f getAngleFromPosition(const int &x, const int &y) const;
     Eigen::Vector2f getAngleFromPosition(const cv::Point2f &p);
 
@@ -115,16 +115,26 @@ bool ImageBase::hasLock(const ImgLock &lt) const {
     return l[int(lt)];
 }
 
-void ImageBase::lock(const ImgLock &lt) {
+bool ImageBase::lock(const ImgLock &lt) {
     auto l = locks.get()->load();
-    l.set(int(lt));
-    locks.get()->store(l);
+    std::bitset<8> locked;
+    do {
+        if (l[int(lt)]) {
+            return false;
+        }
+        locked = l;
+        locked.set(int(lt));
+    } while (!locks.get()->compare_exchange_weak(l, locked));
+    return true;
 }
 
 void ImageBase::unlock(const ImgLock &lt) {
     auto l = locks.get()->load();
-    l.reset(int(lt));
-    locks.get()->store(l);
+    std::bitset<8> unlocked;
+    do {
+        unlocked = l;
+        unlocked.reset(int(lt));
+    } while (!locks.get()->compare_exchange_weak(l, unlocked));
 }
 
 
@@ -51,7 +51,8 @@ public:
 
     bool isLocked() const;
     bool hasLock(const ImgLock &lt) const;
-    void lock(const ImgLock &lt);
+    // atomically sets the lock, returns false if it was set already
+    bool lock(const ImgLock &lt);
     void unlock(const ImgLock &lt);
 
 protected:
@@ -0,0 +1,206 @@
+#include "jpeg.h"
+#include "yuv422.h"
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <jpeglib.h>
+
+namespace jpeg {
+
+namespace {
+
+struct ErrorManager {
+    jpeg_error_mgr pub;
+    std::jmp_buf jmp;
+    char msg[JMSG_LENGTH_MAX];
+};
+
+void onError(j_common_ptr cinfo) {
+    auto *err = reinterpret_cast<ErrorManager *>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->msg);
+    std::longjmp(err->jmp, 1);
+}
+
+// libjpeg wants whole MCUs, so plane widths are rounded up and padded with the last pixel
+constexpr size_t roundUp(size_t v, size_t m) {
+    return (v + m - 1) / m * m;
+}
+
+} // namespace
+
+void encodeYuv422(const uint8_t *yuyv, size_t width, size_t height, buffer_t &out, int quality, int scale) {
+    if (scale != 1 && scale != 2 && scale != 4) {
+        throw std::invalid_argument("jpeg: unsupported scale");
+    }
+
+    const size_t outW = width / scale;
+    const size_t outH = height / scale;
+    const size_t srcStride = width * 2;
+
+    // one MCU row of 4:2:2 data: 8 lines, luma in 16px blocks, chroma in 8px blocks
+    const size_t yStride = roundUp(outW, 2 * DCTSIZE);
+    const size_t cStride = yStride / 2;
+    std::vector<uint8_t> planes((yStride + 2 * cStride) * DCTSIZE);
+    JSAMPROW yRows[DCTSIZE], uRows[DCTSIZE], vRows[DCTSIZE];
+    for (int i = 0; i < DCTSIZE; i++) {
+        yRows[i] = planes.data() + i * yStride;
+        uRows[i] = planes.data() + DCTSIZE * yStride + i * cStride;
+        vRows[i] = planes.data() + DCTSIZE * (yStride + cStride) + i * cStride;
+    }
+    JSAMPARRAY data[3] = {yRows, uRows, vRows};
+
+    jpeg_compress_struct cinfo;
+    ErrorManager err;
+    unsigned char *mem = nullptr;
+    unsigned long memSize = 0;
+
+    cinfo.err = jpeg_std_error(&err.pub);
+    err.pub.error_exit = onError;
+    if (setjmp(err.jmp)) {
+        jpeg_destroy_compress(&cinfo);
+        free(mem);
+        throw std::runtime_error(std::string("jpeg: ") + err.msg);
+    }
+
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &mem, &memSize);
+
+    cinfo.image_width = outW;
+    cinfo.image_height = outH;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_YCbCr;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    cinfo.raw_data_in = TRUE;
+    cinfo.dct_method = JDCT_IFAST;
+    cinfo.comp_info[0].h_samp_factor = 2;
+    cinfo.comp_info[0].v_samp_factor = 1;
+    cinfo.comp_info[1].h_samp_factor = 1;
+    cinfo.comp_info[1].v_samp_factor = 1;
+    cinfo.comp_info[2].h_samp_factor = 1;
+    cinfo.comp_info[2].v_samp_factor = 1;
+
+    jpeg_start_compress(&cinfo, TRUE);
+
+    while (cinfo.next_scanline < cinfo.image_height) {
+        for (int i = 0; i < DCTSIZE; i++) {
+            // repeat the last line, if height is not a multiple of 8
+            size_t line = std::min<size_t>(cinfo.next_scanline + i, outH - 1);
+            const uint8_t *src = yuyv + line * scale * srcStride;
+
+            uint8_t *y = yRows[i];
+            for (size_t x = 0; x < outW; x++) {
+                y[x] = src[x * scale * 2];
+            }
+            std::fill(y + outW, y + yStride, y[outW - 1]);
+
+            // chroma is shared by two output pixels, so take it from every scale-th macro pixel
+            uint8_t *u = uRows[i];
+            uint8_t *v = vRows[i];
+            const size_t outCW = (outW + 1) / 2;
+            for (size_t x = 0; x < outCW; x++) {
+                const uint8_t *macro = src + x * scale * 4;
+                u[x] = macro[1];
+                v[x] = macro[3];
+            }
+            std::fill(u + outCW, u + cStride, u[outCW - 1]);
+            std::fill(v + outCW, v + cStride, v[outCW - 1]);
+        }
+        jpeg_write_raw_data(&cinfo, data, DCTSIZE);
+    }
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+
+    out.assign(mem, mem + memSize);
+    free(mem);
+}
+
+
+Encoder &Encoder::instance() {
+    static Encoder encoder;
+    return encoder;
+}
+
+Encoder::Encoder() : worker(&Encoder::run, this) {
+}
+
+Encoder::~Encoder() {
+    {
+        std::scoped_lock lock(mtx);
+        running = false;
+    }
+    onNewJob.notify_all();
+    worker.join();
+}
+
+void Encoder::submit(std::function<void()> job) {
+    {
+        std::scoped_lock lock(mtx);
+        jobs.push(std::move(job));
+    }
+    onNewJob.notify_one();
+}
+
+void Encoder::run() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mtx);
+            onNewJob.wait(lock, [this]() { return not jobs.empty() || not running; });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+        job();
+    }
+}
+
+
+LazyFrame::LazyFrame(const YuvImage &img, int quality)
+    : w(img.width)
+    , h(img.height)
+    , quality(quality)
+    , raw(img.data, img.data + img.width * img.height * YuvImage::channels) {
+}
+
+void LazyFrame::prefetch(int scale, int quality) {
+    request(scale, quality);
+}
+
+buffer_ptr LazyFrame::get(int scale, int quality) {
+    return request(scale, quality).get();
+}
+
+std::shared_future<buffer_ptr> LazyFrame::request(int scale, int quality) {
+    if (quality <= 0) {
+        quality = this->quality;
+    }
+
+    std::scoped_lock lock(mtx);
+    auto it = cache.find({scale, quality});
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    // the task only references this frame, so it has to be kept alive
+    // until the task ran, even if all consumers dropped it already
+    auto task = std::make_shared<std::packaged_task<buffer_ptr()>>([this, scale, quality]() {
+        auto out = std::make_shared<buffer_t>();
+        encodeYuv422(raw.data(), w, h, *out, quality, scale);
+        return buffer_ptr(out);
+    });
+    std::shared_future<buffer_ptr> result = task->get_future().share();
+    cache.emplace(std::make_pair(scale, quality), result);
+    Encoder::instance().submit([self = shared_from_this(), task]() { (*task)(); });
+    return result;
+}
+
+} // namespace jpeg
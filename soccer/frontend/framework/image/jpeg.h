@@ -0,0 +1,87 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class YuvImage;
+
+namespace jpeg {
+
+using buffer_t = std::vector<uint8_t>;
+using buffer_ptr = std::shared_ptr<const buffer_t>;
+
+static constexpr int DEFAULT_QUALITY = 80;
+
+// Encode a YUYV (YUV 4:2:2) buffer as JPEG without converting to RGB first.
+// Luma and chroma planes are handed to libjpeg as raw 4:2:2 data.
+// scale = 2 or 4 subsamples the image to 1/2 or 1/4 of its size.
+void encodeYuv422(const uint8_t *yuyv, size_t width, size_t height, buffer_t &out,
+        int quality = DEFAULT_QUALITY, int scale = 1);
+
+/**
+ * Single background thread, that does all the lazy encoding, so
+ * neither vision nor the consumers have to block their own thread for it.
+ */
+class Encoder {
+public:
+    static Encoder &instance();
+
+    ~Encoder();
+
+    void submit(std::function<void()> job);
+
+private:
+    Encoder();
+
+    std::thread worker;
+    std::mutex mtx;
+    std::condition_variable onNewJob;
+    std::queue<std::function<void()>> jobs;
+    bool running = true;
+
+    void run();
+};
+
+/**
+ * Copy of a camera frame, that is encoded to JPEG on first request.
+ * Every scale and quality is encoded at most once and cached, so multiple
+ * consumers (logger, debug server, ...) share the result.
+ * quality = 0 uses the quality, the frame was created with.
+ * Must be owned by a shared_ptr.
+ */
+class LazyFrame : public std::enable_shared_from_this<LazyFrame> {
+public:
+    explicit LazyFrame(const YuvImage &img, int quality = DEFAULT_QUALITY);
+
+    // Start encoding in the background, returns immediately.
+    void prefetch(int scale = 1, int quality = 0);
+
+    // Encoded frame, blocks until encoding is done.
+    buffer_ptr get(int scale = 1, int quality = 0);
+
+    size_t width() const { return w; }
+    size_t height() const { return h; }
+    const uint8_t *yuyv() const { return raw.data(); }
+
+private:
+    size_t w;
+    size_t h;
+    int quality;
+    std::vector<uint8_t> raw;
+
+    std::mutex mtx;
+    std::map<std::pair<int, int>, std::shared_future<buffer_ptr>> cache;   // (scale, quality)
+
+    std::shared_future<buffer_ptr> request(int scale, int quality);
+};
+
+} // namespace jpeg
@@ -2,6 +2,10 @@
 
 #include "rgb.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 // CV_LOAD_IMAGE_COLOR
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
@@ -283,3 +287,62 @@ void YuvImage::createLUT(size_t width, bool recreate) {
     lutU[0]=1;
     lutV[0]=3;
 }
+
+namespace {
+
+// bilinear filter tap: source indices a, b and weight of b in 1/256
+struct Tap {
+    size_t a, b;
+    int wb;
+};
+
+std::vector<Tap> bilinearTaps(size_t start, size_t length, size_t outLength) {
+    std::vector<Tap> taps(outLength);
+    const float scale = static_cast<float>(length) / outLength;
+    for (size_t i = 0; i < outLength; i++) {
+        // sample at pixel centers, like cv::INTER_LINEAR
+        float s = std::clamp((i + 0.5f) * scale - 0.5f, 0.f, static_cast<float>(length - 1));
+        size_t a = static_cast<size_t>(s);
+        taps[i] = {start + a, start + std::min(a + 1, length - 1), static_cast<int>(std::lround((s - a) * 256))};
+    }
+    return taps;
+}
+
+inline uint8_t clamp8(int v) {
+    return static_cast<uint8_t>(std::clamp(v, 0, 255));
+}
+
+} // namespace
+
+void cropYuv422ToRgb(const uint8_t *yuyv, size_t width, size_t x, size_t y, size_t w, size_t h, uint8_t *rgb,
+        size_t outWidth, size_t outHeight) {
+    const size_t stride = width * 2;
+    const std::vector<Tap> cols = bilinearTaps(x, w, outWidth);
+    const std::vector<Tap> rows = bilinearTaps(y, h, outHeight);
+
+    for (const Tap &ty : rows) {
+        const uint8_t *top = yuyv + ty.a * stride;
+        const uint8_t *bottom = yuyv + ty.b * stride;
+
+        for (const Tap &tx : cols) {
+            // interpolate the byte at offsets a, b of both rows, result is 8 bit
+            auto sample = [&](size_t a, size_t b) {
+                int t = top[a] * (256 - tx.wb) + top[b] * tx.wb;
+                int l = bottom[a] * (256 - tx.wb) + bottom[b] * tx.wb;
+                return (t * (256 - ty.wb) + l * ty.wb + (1 << 15)) >> 16;
+            };
+
+            // Y0 U Y1 V, chroma is shared by both pixels of a macro pixel
+            const size_t ma = (tx.a & ~size_t(1)) * 2;
+            const size_t mb = (tx.b & ~size_t(1)) * 2;
+            const int Y = sample(tx.a * 2, tx.b * 2);
+            const int U = sample(ma + 1, mb + 1) - 128;
+            const int V = sample(ma + 3, mb + 3) - 128;
+
+            // 16 bit fixed point
+            *rgb++ = clamp8(Y + ((91881 * V + (1 << 15)) >> 16));
+            *rgb++ = clamp8(Y - ((22554 * U + 46802 * V + (1 << 15)) >> 16));
+            *rgb++ = clamp8(Y + ((116130 * U + (1 << 15)) >> 16));
+        }
+    }
+}
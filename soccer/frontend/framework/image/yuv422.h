@@ -87,3 +87,12 @@ protected:
     static void createMsvLUT();
     static void createLUT(size_t width, bool recreate = false);
 };
+
+/**
+ * Crop the region (x, y, w, h) from a YUYV buffer of the given width, convert it to RGB
+ * and resize it bilinearly to outWidth x outHeight, all in one pass.
+ * Writes packed RGB888 to rgb, e.g. straight into the input tensor of a network.
+ * Colors are converted like JPEG (full range BT.601).
+ */
+void cropYuv422ToRgb(const uint8_t *yuyv, size_t width, size_t x, size_t y, size_t w, size_t h, uint8_t *rgb,
+        size_t outWidth, size_t outHeight);
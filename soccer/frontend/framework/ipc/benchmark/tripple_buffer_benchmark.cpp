@@ -0,0 +1,216 @@
+/**
+ * Measures the wakeup latency of ipc::TrippleBuffer across processes, the
+ * way the backend hands sensor data to the frontend: a forked producer
+ * publishes a timestamp every interval, the consumer blocks in
+ * timedProduce() and records how long after consume() it returned.
+ *
+ * "mutex" is the previous implementation (interprocess_mutex and
+ * interprocess_condition around every swap) as baseline.
+ *
+ * Build:
+ *   cd build/<target>
+ *   make tripple_buffer_benchmark
+ *
+ * Usage:
+ *   bin/tripple_buffer_benchmark [--frames 2000] [--interval-us 12000] [--load 0]
+ *
+ * --load starts busy processes on every core, to see the effect of
+ * preemption on both implementations.
+ */
+
+#include <framework/benchmark/latency.h>
+#include <framework/ipc/shared_memory.h>
+#include <framework/ipc/tripple_buffer.h>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+// baseline: the interprocess mutex triple buffer, that ipc::TrippleBuffer replaced
+template<typename T>
+class MutexTrippleBuffer {
+    using ipc_lock = boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>;
+
+public:
+    const T &producedData() const { return buffers[frontIdx]; }
+
+    bool timedProduce(int timeoutMs) {
+        ipc_lock lock(middleMutex);
+        const auto timeout =
+                boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(timeoutMs);
+        if (!newData && !middleOld.timed_wait(lock, timeout, [this]() { return newData; })) {
+            return false;
+        }
+        std::swap(frontIdx, middleIdx);
+        newData = false;
+        return true;
+    }
+
+    T &consumedData() { return buffers[backIdx]; }
+
+    void consume() {
+        {
+            ipc_lock lock(middleMutex);
+            std::swap(backIdx, middleIdx);
+            newData = true;
+        }
+        middleOld.notify_one();
+    }
+
+private:
+    T buffers[3];
+    unsigned char backIdx = 0, middleIdx = 1, frontIdx = 2;
+    bool newData = false;
+    boost::interprocess::interprocess_mutex middleMutex;
+    boost::interprocess::interprocess_condition middleOld;
+};
+
+// about the size of a sensor flatbuffer
+struct Message {
+    int64_t sentNs;
+    int32_t tick;
+    char payload[4096];
+};
+
+struct Shm {
+    ipc::TrippleBuffer<Message> futex;
+    MutexTrippleBuffer<Message> mutex;
+    std::atomic<bool> stop{false};
+};
+
+const std::string shmName = "/tripple_buffer_benchmark";
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Result {
+    std::vector<int64_t> latencyNs;
+    int skipped = 0;
+    int timeouts = 0;
+};
+
+template<typename Buffer>
+void producer(Buffer &buffer, std::atomic<bool> &stop, int intervalUs) {
+    auto next = std::chrono::steady_clock::now();
+    for (int32_t tick = 0; !stop.load(); tick++) {
+        next += std::chrono::microseconds(intervalUs);
+        std::this_thread::sleep_until(next);
+
+        Message &msg = buffer.consumedData();
+        msg.tick = tick;
+        msg.payload[tick % sizeof(msg.payload)] = static_cast<char>(tick);
+        msg.sentNs = nowNs();
+        buffer.consume();
+    }
+}
+
+template<typename Buffer>
+Result run(Shm &shm, Buffer &buffer, int frames, int intervalUs) {
+    shm.stop = false;
+    const pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "fork failed" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0) {
+        producer(buffer, shm.stop, intervalUs);
+        _exit(0);
+    }
+
+    const int timeoutMs = std::max(1, 2 * intervalUs / 1000);
+    Result result;
+    result.latencyNs.reserve(frames);
+    int lastTick = -1;
+    while (static_cast<int>(result.latencyNs.size()) < frames) {
+        if (!buffer.timedProduce(timeoutMs)) {
+            result.timeouts++;
+            continue;
+        }
+        const int64_t receivedNs = nowNs();
+        const Message &msg = buffer.producedData();
+        if (lastTick >= 0) {
+            result.skipped += msg.tick - lastTick - 1;
+        }
+        lastTick = msg.tick;
+        result.latencyNs.push_back(receivedNs - msg.sentNs);
+    }
+
+    shm.stop = true;
+    waitpid(pid, nullptr, 0);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    int frames, intervalUs, load;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("frames", po::value<int>(&frames)->default_value(2000), "frames to receive per implementation")
+        ("interval-us", po::value<int>(&intervalUs)->default_value(12000), "time between two frames")
+        ("load", po::value<int>(&load)->default_value(0), "busy processes per core")
+        ("help,h", "produce help message.");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << std::endl << desc << std::endl;
+        return 0;
+    }
+
+    std::vector<pid_t> busy;
+    const int cores = static_cast<int>(std::thread::hardware_concurrency());
+    for (int i = 0; i < load * cores; i++) {
+        const pid_t pid = fork();
+        if (pid < 0) {
+            // never push -1, kill(-1) below would hit every process of the user
+            std::cerr << "fork failed, running with " << busy.size() << " busy processes" << std::endl;
+            break;
+        }
+        if (pid == 0) {
+            for (volatile uint64_t x = 0;; x = x + 1) {
+            }
+        }
+        busy.push_back(pid);
+    }
+
+    ipc::SharedMemory<Shm> shm(shmName, true);
+    std::cout << frames << " frames every " << intervalUs << " us, " << busy.size() << " busy processes"
+              << std::endl;
+    Result mutex = run(*shm, shm->mutex, frames, intervalUs);
+    Result futex = run(*shm, shm->futex, frames, intervalUs);
+
+    std::cout << std::endl << "Wakeup latency [us]" << std::endl;
+    benchmark::printLatencyHeader("");
+    benchmark::printLatency("mutex", mutex.latencyNs, 1000.0);
+    benchmark::printLatency("futex", futex.latencyNs, 1000.0);
+    std::cout << std::endl << "mutex: skipped " << mutex.skipped << ", timeouts " << mutex.timeouts << std::endl;
+    std::cout << "futex: skipped " << futex.skipped << ", timeouts " << futex.timeouts << std::endl;
+
+    for (pid_t pid : busy) {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+    }
+    return 0;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
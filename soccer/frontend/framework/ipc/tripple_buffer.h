@@ -1,23 +1,33 @@
 #pragma once
 
-#include <boost/date_time/posix_time/posix_time.hpp>
+#include <framework/rt/util/futex.h>
 
-#include <boost/interprocess/sync/interprocess_mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/interprocess_condition.hpp>
-
-#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 
 
 namespace ipc {
 
+/**
+ * Triple buffer between two processes, placed in shared memory.
+ *
+ * The writing process fills consumedData() and publishes it with consume(),
+ * the reading process takes the newest published buffer with tryProduce() /
+ * timedProduce() and reads it via producedData().
+ *
+ * Both sides swap their buffer with the middle one by a CAS on a single
+ * state word, neither ever blocks the other. A reader waiting for new data
+ * sleeps on that word with a process-shared futex and is woken by consume().
+ */
 template<typename T>
 class TrippleBuffer {
-    using ipc_lock = boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>;
-
 public:
     TrippleBuffer() = default;
 
+    TrippleBuffer(const TrippleBuffer &) = delete;
+    TrippleBuffer &operator=(const TrippleBuffer &) = delete;
+
     // returns reference to data produced by other process
     const T &producedData() const {
         return buffers[frontIdx];
@@ -25,30 +35,41 @@ public:
 
     // produce data from other process
     bool tryProduce() {
-        ipc_lock lock(middleMutex);
-        return switchNewMiddleToFront(newData);
+        uint32_t s = state.load(std::memory_order_relaxed);
+        do {
+            if (!(s & NEW_DATA)) {
+                return false;
+            }
+        } while (!state.compare_exchange_weak(s, frontIdx, std::memory_order_acq_rel, std::memory_order_relaxed));
+        frontIdx = s & IDX_MASK;
+        return true;
     }
 
     // produce data from other process (with timeout)
     bool timedProduce(int timeoutMs) {
-        ipc_lock lock(middleMutex);
-        boost::posix_time::ptime timeout = boost::get_system_time() 
-            + boost::posix_time::milliseconds(timeoutMs);
-
-        bool newData = 
-            (this->newData) ? true 
-                            : middleOld.timed_wait(lock, timeout,
-                                [this]() { return this->newData; });
-
-        return switchNewMiddleToFront(newData);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        for (;;) {
+            if (tryProduce()) {
+                return true;
+            }
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= remaining.zero()) {
+                return false;
+            }
+            uint32_t expected;
+            if (announceWaiting(expected)) {
+                rt::futex::wait(state, expected, remaining, rt::futex::Scope::Shared);
+            }
+        }
     }
 
     void waitForNewData() {
-        ipc_lock lock(middleMutex);
-
-        middleOld.wait(lock, [this]() { return this->newData; }); 
-
-        switchFrontAndMiddle();
+        while (!tryProduce()) {
+            uint32_t expected;
+            if (announceWaiting(expected)) {
+                rt::futex::wait(state, expected, rt::futex::Scope::Shared);
+            }
+        }
     }
 
 
@@ -59,44 +80,42 @@ public:
 
     // consume data from current process
     void consume() {
-        unsigned char oldBack = backIdx;
-        {
-            ipc_lock lock(middleMutex);
-            backIdx = middleIdx;
-            middleIdx = oldBack;
-            newData = true;
+        const uint32_t prev = state.exchange(backIdx | NEW_DATA, std::memory_order_acq_rel);
+        backIdx = prev & IDX_MASK;
+        if (prev & WAITING) {
+            rt::futex::wake(state, 1, rt::futex::Scope::Shared);
         }
-        middleOld.notify_one();
     }
 
 private:
-    T buffers[3];
-
-    unsigned char backIdx   = 0; //< Index of current back buffer
-    unsigned char middleIdx = 1; //< Index of current middle buffer
-    unsigned char frontIdx  = 2; //< Index of current front buffer
-
-    bool newData = false; //< if data in middle buffer is newer than front buffer
+    static constexpr uint32_t IDX_MASK = 0b11;  //< index of the middle buffer
+    static constexpr uint32_t NEW_DATA = 0b100; //< middle buffer is newer than the front buffer
+    static constexpr uint32_t WAITING = 0b1000; //< reader sleeps on the state word
 
-    boost::interprocess::interprocess_mutex middleMutex; //< mutex for access to the middle buffer
-    boost::interprocess::interprocess_condition middleOld; 
-
-    void switchFrontAndMiddle() {
-        unsigned char oldFront = frontIdx;
-        frontIdx = middleIdx;
-        middleIdx = oldFront;
-        newData = false;
-    }
+    T buffers[3];
 
-    bool switchNewMiddleToFront(bool newData) {
-        if (newData) {
-            switchFrontAndMiddle();
-        }
-        return newData;
+    uint32_t backIdx = 0;  //< Index of current back buffer, writer only
+    uint32_t frontIdx = 2; //< Index of current front buffer, reader only
+
+    std::atomic<uint32_t> state{1}; //< middle buffer index and flags
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex word must be a plain uint32_t");
+
+    // set WAITING, unless new data arrived meanwhile
+    // @param expected state to sleep on
+    bool announceWaiting(uint32_t &expected) {
+        uint32_t s = state.load(std::memory_order_relaxed);
+        do {
+            if (s & NEW_DATA) {
+                return false;
+            }
+        } while (!(s & WAITING) &&
+                 !state.compare_exchange_weak(s, s | WAITING, std::memory_order_relaxed, std::memory_order_relaxed));
+        expected = s | WAITING;
+        return true;
     }
-
 };
-    
+
 
 }; // namespace ipc
 
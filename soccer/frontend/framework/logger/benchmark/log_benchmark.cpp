@@ -0,0 +1,157 @@
+/**
+ * Measures the cost of a LOG_INFO call on the calling thread, for the
+ * text mode (LogMessage + stringstream + lockfree queue) and the binary mode
+ * (record on the stack + ring per thread).
+ *
+ * Messages are written to a backend, that discards them, so only the
+ * call site and the IO worker are measured, not the console.
+ *
+ * Build:
+ *   cd build/<target>
+ *   make log_benchmark
+ *
+ * Usage:
+ *   bin/log_benchmark [--calls 100000] [--threads 1] [--interval-us 0]
+ */
+
+#include <framework/benchmark/latency.h>
+#include <framework/logger/logger.h>
+#include <framework/logger/backends.h>
+#include <framework/thread/simplethreadmanager.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+ThreadManager* GetThreadManager() {
+    using T = SimpleThreadManager<Thread>;
+    static ThreadManager manager(new T());
+    return &manager;
+}
+
+void CreateXLoggerThread(XLogger *logger) {
+    using namespace std::placeholders;
+    GetThreadManager()->create(Thread::LOW_PRIORITY, std::bind(&XLogger::io_worker, logger, _1));
+}
+
+// counts messages, writes nothing
+class NullBackend : public BaseLoggerBackend {
+public:
+    explicit NullBackend(const std::string &my_id) : BaseLoggerBackend(my_id, "null") {}
+    void write(const std::string &) override { written++; }
+
+    std::atomic<size_t> written{0};
+};
+
+struct Result {
+    std::vector<int64_t> ns;
+    double meanNs = 0; //!< wall time per call, includes the loop
+    size_t written = 0;
+    uint64_t dropped = 0;
+};
+
+static void producer(size_t calls, int intervalUs, std::vector<int64_t> &ns, double &meanNs) {
+    using clock = std::chrono::steady_clock;
+    const std::string joint = "LShoulderPitch";
+    ns.reserve(calls);
+
+    const auto start = clock::now();
+    for (size_t i = 0; i < calls; i++) {
+        const auto t0 = clock::now();
+        LOG_INFO << "step " << i << " took " << 0.25f * i << " ms, joint " << joint << " ok: " << (i % 2 == 0);
+        const auto t1 = clock::now();
+        ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+
+        if (intervalUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(intervalUs));
+        }
+    }
+    const auto end = clock::now();
+    meanNs = std::chrono::duration<double, std::nano>(end - start).count() / calls;
+    if (intervalUs > 0) {
+        // sleeping dominates, use the timed calls only
+        meanNs = 0;
+        for (auto t : ns) {
+            meanNs += t;
+        }
+        meanNs /= calls;
+    }
+}
+
+static Result run(bool binary, size_t calls, int threads, int intervalUs) {
+    auto xlog = std::make_unique<XLogger>(LOGID);
+    auto *backend = new NullBackend(LOGID);
+    xlog->add_backend(backend, "[%%FANCYLVL%%] %%MSG%%\n", false);
+    xlog->set_loglvl_desc(5, "i");
+    xlog->set_binary_mode(binary);
+
+    std::vector<std::vector<int64_t>> ns(threads);
+    std::vector<double> mean(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back(producer, calls, intervalUs, std::ref(ns[t]), std::ref(mean[t]));
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    xlog->flush();
+
+    Result result;
+    for (int t = 0; t < threads; t++) {
+        result.ns.insert(result.ns.end(), ns[t].begin(), ns[t].end());
+        result.meanNs += mean[t] / threads;
+    }
+    result.written = backend->written;
+    result.dropped = xlog->get_dropped();
+
+    xlog->stop();
+    return result;
+}
+
+int main(int argc, const char *argv[]) {
+    size_t calls;
+    int threads, intervalUs;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("calls", po::value<size_t>(&calls)->default_value(100000), "LOG_INFO calls per thread")
+        ("threads", po::value<int>(&threads)->default_value(1), "logging threads")
+        ("interval-us", po::value<int>(&intervalUs)->default_value(0), "sleep between calls, 0: as fast as possible")
+        ("help,h", "produce help message.");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << std::endl << desc << std::endl;
+        return 0;
+    }
+
+    std::cout << calls << " calls in " << threads << " thread(s), timed values include the clock overhead"
+              << std::endl;
+    Result text = run(false, calls, threads, intervalUs);
+    Result binary = run(true, calls, threads, intervalUs);
+
+    std::cout << std::endl << "LOG_INFO call [ns]" << std::endl;
+    benchmark::printLatencyHeader("mode");
+    benchmark::printLatency("text", text.ns);
+    benchmark::printLatency("binary", binary.ns);
+
+    auto summary = [](const char *name, const Result &r) {
+        std::cout << name << ": " << r.meanNs << " ns/call including the loop, written " << r.written
+                  << ", dropped " << r.dropped << std::endl;
+    };
+    std::cout << std::endl << std::fixed << std::setprecision(1);
+    summary("text", text);
+    summary("binary", binary);
+
+    return 0;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,105 @@
+#include "binarylog.h"
+
+#include <algorithm>
+
+void LogRecordWriter::addString(std::string_view s) {
+    auto &hdr = header();
+    const size_t tagSize = 1 + sizeof(uint16_t);
+    if (hdr.size + tagSize > MAX_SIZE) {
+        truncate();
+        return;
+    }
+
+    const uint16_t len = std::min(s.size(), MAX_SIZE - hdr.size - tagSize);
+    if (len < s.size()) {
+        truncate();
+    }
+    buf[hdr.size] = static_cast<char>(LogArg::STRING);
+    std::memcpy(buf.data() + hdr.size + 1, &len, sizeof(len));
+    std::memcpy(buf.data() + hdr.size + tagSize, s.data(), len);
+    hdr.size += tagSize + len;
+}
+
+namespace {
+
+template<typename T>
+T get(const char *&pos) {
+    T value;
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+void LogRecordWriter::format(const char *record, size_t size, std::ostream &out) {
+    LogRecordHeader hdr;
+    std::memcpy(&hdr, record, sizeof(hdr));
+
+    const char *pos = record + sizeof(hdr);
+    const char *end = record + std::min<size_t>(size, hdr.size);
+    while (pos < end) {
+        switch (static_cast<LogArg>(*pos++)) {
+            case LogArg::INT:
+                out << get<int64_t>(pos);
+                break;
+            case LogArg::UINT:
+                out << get<uint64_t>(pos);
+                break;
+            case LogArg::FLOAT:
+                out << get<float>(pos);
+                break;
+            case LogArg::DOUBLE:
+                out << get<double>(pos);
+                break;
+            case LogArg::BOOL:
+                out << static_cast<bool>(get<uint8_t>(pos));
+                break;
+            case LogArg::CHAR:
+                out << get<char>(pos);
+                break;
+            case LogArg::POINTER:
+                out << get<const void *>(pos);
+                break;
+            case LogArg::STRING: {
+                const uint16_t len = get<uint16_t>(pos);
+                out << std::string_view(pos, len);
+                pos += len;
+                break;
+            }
+            default:
+                // corrupt record
+                return;
+        }
+    }
+
+    if (hdr.flags & LogRecordHeader::TRUNCATED) {
+        out << " [...]";
+    }
+}
+
+bool LogRing::push(const char *record, size_t size) {
+    const size_t h = head.load(std::memory_order_relaxed);
+    const size_t t = tail.load(std::memory_order_acquire);
+    if (CAPACITY - (h - t) < size) {
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const size_t offset = h % CAPACITY;
+    const size_t first = std::min(size, CAPACITY - offset);
+    std::memcpy(data.data() + offset, record, first);
+    std::memcpy(data.data(), record + first, size - first);
+
+    head.store(h + size, std::memory_order_release);
+    return true;
+}
+
+void LogRing::read(size_t pos, char *out, size_t size) const {
+    const size_t offset = pos % CAPACITY;
+    const size_t first = std::min(size, CAPACITY - offset);
+    std::memcpy(out, data.data() + offset, first);
+    std::memcpy(out + first, data.data(), size - first);
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Binary log records, written by LogStream in binary mode and formatted
+// later by the IO worker of the XLogger.
+//
+// A record is a LogRecordHeader followed by the arguments, each one is a
+// LogArg tag and its raw value. Strings are copied, so the record stays
+// valid after the call site returned. File and function name are pointers
+// to the static strings of the call site, so they cost nothing to record.
+
+enum class LogArg : uint8_t {
+    INT = 0,      // int64_t
+    UINT,         // uint64_t
+    FLOAT,        // float
+    DOUBLE,       // double
+    BOOL,         // uint8_t
+    CHAR,         // char
+    POINTER,      // const void *
+    STRING,       // uint16_t length, chars
+};
+
+struct LogRecordHeader {
+    uint16_t size;          // whole record including this header
+    uint8_t flags;
+    int8_t loglevel;
+    int32_t line;
+    const char *fn;
+    const char *func;
+
+    static constexpr uint8_t TRUNCATED{1};
+};
+
+// encodes one record into a fixed buffer on the stack, never allocates
+class LogRecordWriter {
+public:
+    static constexpr size_t MAX_SIZE{512};
+
+    LogRecordWriter(int loglevel, int line, const char *fn, const char *func) {
+        LogRecordHeader hdr{sizeof(LogRecordHeader), 0, static_cast<int8_t>(loglevel), line, fn, func};
+        std::memcpy(buf.data(), &hdr, sizeof(hdr));
+    }
+
+    // arithmetic types and pointers
+    template<typename T>
+    void add(const T &value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            put(LogArg::BOOL, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_same_v<T, char>) {
+            put(LogArg::CHAR, value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            put(LogArg::INT, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            put(LogArg::UINT, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_same_v<T, float>) {
+            put(LogArg::FLOAT, value);
+        } else if constexpr (std::is_same_v<T, double>) {
+            put(LogArg::DOUBLE, value);
+        } else {
+            static_assert(std::is_pointer_v<T>, "no binary encoding for this type");
+            put(LogArg::POINTER, static_cast<const void *>(value));
+        }
+    }
+
+    // copies s, truncated to the free space
+    void addString(std::string_view s);
+
+    void truncate() { header().flags |= LogRecordHeader::TRUNCATED; }
+
+    const char *data() const { return buf.data(); }
+    size_t size() const { return header().size; }
+
+    // append the formatted arguments of record (size bytes) to out
+    static void format(const char *record, size_t size, std::ostream &out);
+
+private:
+    alignas(LogRecordHeader) std::array<char, MAX_SIZE> buf;
+
+    LogRecordHeader &header() { return *reinterpret_cast<LogRecordHeader *>(buf.data()); }
+    const LogRecordHeader &header() const { return *reinterpret_cast<const LogRecordHeader *>(buf.data()); }
+
+    template<typename T>
+    void put(LogArg tag, const T &value) {
+        auto &hdr = header();
+        if (hdr.size + 1 + sizeof(T) > MAX_SIZE) {
+            truncate();
+            return;
+        }
+        buf[hdr.size] = static_cast<char>(tag);
+        std::memcpy(buf.data() + hdr.size + 1, &value, sizeof(T));
+        hdr.size += 1 + sizeof(T);
+    }
+};
+
+/**
+ * Single producer, single consumer ring of log records.
+ * Every thread gets its own ring per logger, so writing a record is a
+ * memcpy and a release store. Records, that don't fit, are dropped and counted.
+ */
+class LogRing {
+public:
+    static constexpr size_t CAPACITY{64 * 1024};
+
+    // producer
+    bool push(const char *record, size_t size);
+
+    // consumer, calls fn(const char *record, size_t size) for every record
+    template<typename F>
+    size_t consume(F &&fn);
+
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    uint64_t dropped() const { return droppedRecords.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<size_t> head{0};    // written by producer
+    alignas(64) std::atomic<size_t> tail{0};    // written by consumer
+    alignas(64) std::atomic<uint64_t> droppedRecords{0};
+    std::array<char, CAPACITY> data;
+
+    void read(size_t pos, char *out, size_t size) const;
+};
+
+template<typename F>
+size_t LogRing::consume(F &&fn) {
+    const size_t h = head.load(std::memory_order_acquire);
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t count = 0;
+
+    std::array<char, LogRecordWriter::MAX_SIZE> record;
+    while (t != h) {
+        uint16_t size;
+        read(t, reinterpret_cast<char *>(&size), sizeof(size));
+        read(t, record.data(), size);
+        fn(record.data(), size);
+        t += size;
+        count++;
+    }
+    tail.store(t, std::memory_order_release);
+    return count;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
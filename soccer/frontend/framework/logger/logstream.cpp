@@ -6,16 +6,27 @@
 
 // LogStream provides the interface for logging
 LogStream::LogStream(XLogger *logobj, const int &loglvl, const int &line, const std::string_view &fn, const std::string_view &func)
-  : obj(logobj), lm(new LogMessage(loglvl, line, fn, func)) {
+  : obj(logobj) {
+    // call sites pass __FILE__ and __FUNCTION__, so the views point to static, null terminated strings
+    if (obj->get_binary_mode())
+        record.emplace(loglvl, line, fn.data(), func.data());
+    else
+        lm = new LogMessage(loglvl, line, fn, func);
 }
 
 // Save the streamed data for the logger (during object destruction)
 LogStream::~LogStream() {
-    obj->log_msg(lm);
+    if (lm) {
+        obj->log_msg(lm);
+        return;
+    }
+
+    if (fallback)
+        record->addString(fallback->str());
+    obj->log_record(*record);
 }
 
 LogStream &LogStream::operator<<(tEndl) {
     // just append \n
-    lm->msg << "\n";
-    return *this;
+    return *this << '\n';
 }
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 #include <sstream>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
 #include <lola_names_generated.h>
 
+#include "binarylog.h"
+
 class XLogger;
 
 class LogMessage {
@@ -26,12 +31,31 @@ public:
 // LogStream object which performs the piping magic,
 // instanciated on every LOG(lvl, LOGID) macro call,
 // renders and delivers the the log message during object desctruction
-// TODO: alot of performance optimization possible, e.g.:
-// - static stringstream (violates thread-safety)
+//
+// In binary mode (XLogger::set_binary_mode()) strings, numbers and pointers
+// are recorded into a LogRecordWriter on the stack and pushed to a ring of
+// the calling thread, formatting happens in the IO worker.
+// Other types are formatted by a stringstream right away. As they may change
+// the stream state (e.g. std::setprecision), all following values of the
+// message are formatted by that stream, too.
 class LogStream {
 private:
     XLogger *obj;
-    LogMessage *lm;
+    LogMessage *lm{nullptr};
+    std::optional<LogRecordWriter> record;
+    std::unique_ptr<std::ostringstream> fallback;
+
+    template<class T>
+    static constexpr bool is_string_v = std::is_convertible_v<const T &, std::string_view>;
+
+    template<class T>
+    static constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char>
+            || std::is_same_v<T, unsigned char>;
+
+    template<class T>
+    static constexpr bool is_binary_v = is_string_v<T> || std::is_same_v<T, bool> || std::is_integral_v<T>
+            || std::is_same_v<T, float> || std::is_same_v<T, double>
+            || (std::is_pointer_v<T> && std::is_object_v<std::remove_pointer_t<T>>);
 
 public:
     typedef std::basic_ostream<char, std::char_traits<char>> tCout;
@@ -48,8 +72,21 @@ public:
 
     // default pipe-to handler
     template<class T>
-    LogStream &operator<<(const T &obj) {
-        lm->msg << obj;
+    LogStream &operator<<(const T &value) {
+        if (lm) {
+            lm->msg << value;
+        } else if (fallback) {
+            *fallback << value;
+        } else if constexpr (is_string_v<T>) {
+            record->addString(value);
+        } else if constexpr (is_char_v<T>) {
+            record->add(static_cast<char>(value));
+        } else if constexpr (is_binary_v<T>) {
+            record->add(value);
+        } else {
+            fallback = std::make_unique<std::ostringstream>();
+            *fallback << value;
+        }
         return *this;
     }
 };
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
 #include <cstring>
 #include <iostream>
@@ -11,6 +14,8 @@
 #include "thread/util.h"
 #include "xlogger.h"
 #include "backends.h"
+#include "binarylog.h"
+#include "loglvl.h"
 
 #include "../common/platform.h"
 #include "../util/converter.h"
@@ -29,12 +34,34 @@ public:
     boost::lockfree::queue<LogMessage *> q{1000};
     std::atomic<bool> stop;
     std::atomic<bool> finished;
+
+    // binary mode: one ring per thread, shared with the thread local cache,
+    // so the ring is released by whoever is last
+    std::mutex ringsMtx;
+    std::vector<std::shared_ptr<LogRing>> rings;
+    uint64_t retiredDrops{0};   // dropped by rings of finished threads
+    uint64_t reportedDrops{0};
+};
+
+namespace {
+
+std::atomic<uint64_t> loggerSerial{0};
+
+// rings of this thread, a thread rarely logs to more than "system" and "logsay"
+struct ThreadRing {
+    const XLogger *logger{nullptr};
+    uint64_t serial{0};
+    std::shared_ptr<LogRing> ring;
 };
+thread_local std::array<ThreadRing, 4> threadRings;
+
+} // namespace
 
 // Logger main class
 // Make sure you place an instance of this logger inside the heap! No STACK use!
 XLogger::XLogger(const std::string &id)
-  : id(id), min_loglvl(0), strip_msg(true), to_strip({"\n", "\t", " ", "\r"}), time_format("%d.%m - %T") {
+  : id(id), min_loglvl(0), serial(++loggerSerial), strip_msg(true), to_strip({"\n", "\t", " ", "\r"}),
+    time_format("%d.%m - %T") {
 
     // early in initalization-phase - exit hard!
     if (log_map.find(id) != log_map.end())
@@ -168,6 +195,18 @@ int XLogger::get_min_loglvl() const {
     return XLogger::min_loglvl;
 }
 
+void XLogger::set_binary_mode(bool binary) {
+    this->binary = binary;
+}
+
+uint64_t XLogger::get_dropped() const {
+    std::scoped_lock lock(io->ringsMtx);
+    uint64_t dropped = io->retiredDrops;
+    for (auto &ring : io->rings)
+        dropped += ring->dropped();
+    return dropped;
+}
+
 // render the message
 std::string XLogger::render_msg(BaseLoggerBackend *back, LogMessage *lm) {
     std::string out(back2tmpl[back]);
@@ -218,6 +257,45 @@ std::string XLogger::render_msg(BaseLoggerBackend *back, LogMessage *lm) {
     return out;
 }
 
+// ring of the calling thread, registered on first use
+LogRing *XLogger::thread_ring() {
+    for (auto &t : threadRings) {
+        if (t.logger == this && t.serial == serial)
+            return t.ring.get();
+    }
+
+    // (re)use a slot, that is free or belongs to a logger, that is gone
+    for (auto &t : threadRings) {
+        if (t.logger && t.ring.use_count() > 1)
+            continue;
+
+        t.logger = this;
+        t.serial = serial;
+        t.ring = std::make_shared<LogRing>();
+
+        std::scoped_lock lock(io->ringsMtx);
+        io->rings.push_back(t.ring);
+        return t.ring.get();
+    }
+    return nullptr;
+}
+
+// binary mode, never blocks: the record is dropped, if the ring is full
+void XLogger::log_record(const LogRecordWriter &record) {
+    LogRing *ring = thread_ring();
+    if (LIKELY(ring != nullptr)) {
+        ring->push(record.data(), record.size());
+        return;
+    }
+
+    // more loggers in this thread than cached rings
+    LogRecordHeader hdr;
+    std::memcpy(&hdr, record.data(), sizeof(hdr));
+    auto *lm = new LogMessage(hdr.loglevel, hdr.line, hdr.fn, hdr.func);
+    LogRecordWriter::format(record.data(), record.size(), lm->msg);
+    log_msg(lm);
+}
+
 // log message (including meta data)
 void XLogger::log_msg(LogMessage *lm) {
     // if not fn_filter.empty() show only msg from given files
@@ -251,17 +329,79 @@ void XLogger::flush() {
     // sleep until queue is empty
     while (!io->q.empty())
         sleep_for(10ms);
+
+    // and the rings of all threads
+    for (bool empty = false; !empty; ) {
+        {
+            std::scoped_lock lock(io->ringsMtx);
+            empty = std::all_of(io->rings.begin(), io->rings.end(), [](auto &r) { return r->empty(); });
+        }
+        if (!empty)
+            sleep_for(10ms);
+    }
+}
+
+void XLogger::deliver(LogMessage *lm) {
+    // render and write to all backends
+    for (BaseLoggerBackend *back : backends)
+        back->write(render_msg(back, lm));
 }
 
 int XLogger::consume() {
-    return io->q.consume_all([&](LogMessage *lm) {
+    int count = io->q.consume_all([&](LogMessage *lm) {
         // flush() may push nullptr, to ensure all messages are written to disk
         if (UNLIKELY(!lm))
             return;
 
-        // render and write to all backends
-        for (BaseLoggerBackend *back : backends)
-            back->write(render_msg(back, lm));
+        deliver(lm);
         delete lm;
     });
+
+    // don't hold the lock while writing, threads register their ring with it
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::scoped_lock lock(io->ringsMtx);
+        rings = io->rings;
+    }
+
+    for (auto &ring : rings) {
+        count += ring->consume([&](const char *record, size_t size) {
+            LogRecordHeader hdr;
+            std::memcpy(&hdr, record, sizeof(hdr));
+            LogMessage lm(hdr.loglevel, hdr.line, hdr.fn, hdr.func);
+
+            // filters of log_msg(), applied here to keep the calling thread fast
+            if (hdr.loglevel < min_loglvl || (!fn_filter.empty() && fn_filter.find(lm.fn) == fn_filter.end()))
+                return;
+
+            LogRecordWriter::format(record, size, lm.msg);
+            deliver(&lm);
+        });
+    }
+    rings.clear();
+
+    uint64_t dropped;
+    {
+        std::scoped_lock lock(io->ringsMtx);
+        // remove rings of finished threads, once everything is written
+        auto retired = std::remove_if(io->rings.begin(), io->rings.end(), [&](auto &ring) {
+            if (ring.use_count() > 1 || !ring->empty())
+                return false;
+            io->retiredDrops += ring->dropped();
+            return true;
+        });
+        io->rings.erase(retired, io->rings.end());
+
+        dropped = io->retiredDrops;
+        for (auto &ring : io->rings)
+            dropped += ring->dropped();
+    }
+
+    if (UNLIKELY(dropped > io->reportedDrops)) {
+        LogMessage lm(LOG_LVL_WARN, __LINE__, __FILE__, __FUNCTION__);
+        lm.msg << "[XLogger] " << dropped - io->reportedDrops << " messages dropped, ring of a thread was full";
+        deliver(&lm);
+        io->reportedDrops = dropped;
+    }
+    return count;
 }
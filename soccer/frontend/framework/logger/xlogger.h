@@ -12,6 +12,8 @@
 class ThreadContext;
 class BaseLoggerBackend;
 class LogIO;
+class LogRing;
+class LogRecordWriter;
 
 class XLogger;
 extern void CreateXLoggerThread(XLogger *logger);
@@ -74,8 +76,17 @@ public:
     void set_min_loglvl(int loglvl);
     int get_min_loglvl() const;
 
+    // binary mode: LogStream records into a ring per thread, without
+    // allocating or locking, the IO worker formats the messages
+    void set_binary_mode(bool binary);
+    bool get_binary_mode() const { return binary; }
+
+    // messages dropped in binary mode, because the ring of a thread was full
+    uint64_t get_dropped() const;
+
     // actual log-msg handling methods
     void log_msg(LogMessage *lm);
+    void log_record(const LogRecordWriter &record);
 
     // block until all messages are written (should only be in special cases)
     void flush();
@@ -91,6 +102,8 @@ private:
     std::string id;
 
     int min_loglvl;
+    bool binary{false};
+    const uint64_t serial;  // tells thread local rings of a previous logger at the same address apart
 
     bool strip_msg;
     std::vector<std::string> to_strip;
@@ -108,6 +121,9 @@ private:
     std::string render_msg(BaseLoggerBackend *back, LogMessage *lm);
     std::string get_fancy_level(int lvl);
 
+    LogRing *thread_ring();
+    void deliver(LogMessage *lm);
+
     void io_worker(ThreadContext*);
     int consume();
 };
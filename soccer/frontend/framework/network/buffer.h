@@ -13,19 +13,38 @@ class shared_const_buffer {
 public:
     // Construct from a std::string.
     explicit shared_const_buffer(const std::string &data)
-      : data_(new std::vector<char>(data.begin(), data.end())), buffer_(boost::asio::buffer(*data_)) {}
+      : shared_const_buffer(std::make_shared<std::vector<char>>(data.begin(), data.end())) {}
 
     // Construct from data pointer & size
     explicit shared_const_buffer(const char *data, size_t size)
       : shared_const_buffer(std::string(data, size)) {}
 
+    // Zero-copy: send a vector owned by someone else, it is kept alive until sent.
+    template<typename T>
+    explicit shared_const_buffer(std::shared_ptr<const std::vector<T>> data)
+      : buffers_{boost::asio::buffer(*data)} {
+        owners_.push_back(std::move(data));
+    }
+
+    // Zero-copy: gather all parts of both buffers into one write.
+    shared_const_buffer &append(const shared_const_buffer &other) {
+        buffers_.insert(buffers_.end(), other.buffers_.begin(), other.buffers_.end());
+        owners_.insert(owners_.end(), other.owners_.begin(), other.owners_.end());
+        return *this;
+    }
+
+    size_t size() const { return boost::asio::buffer_size(buffers_); }
+
     // Implement the ConstBufferSequence requirements.
     typedef boost::asio::const_buffer value_type;
     typedef const boost::asio::const_buffer *const_iterator;
-    const boost::asio::const_buffer *begin() const { return &buffer_; }
-    const boost::asio::const_buffer *end() const { return &buffer_ + 1; }
+    const boost::asio::const_buffer *begin() const { return buffers_.data(); }
+    const boost::asio::const_buffer *end() const { return buffers_.data() + buffers_.size(); }
 
 private:
-    std::shared_ptr<std::vector<char>> data_;
-    boost::asio::const_buffer buffer_;
+    explicit shared_const_buffer(std::shared_ptr<std::vector<char>> data)
+      : shared_const_buffer(std::shared_ptr<const std::vector<char>>(std::move(data))) {}
+
+    std::vector<std::shared_ptr<const void>> owners_;
+    std::vector<boost::asio::const_buffer> buffers_;
 };
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <cstring>
 #include <iostream>
@@ -34,11 +35,13 @@ void TCPServer::accept() {
 }
 
 void TCPServer::write(const char *msg, const size_t size) {
+    write(shared_const_buffer(msg, size));
+}
+
+void TCPServer::write(const shared_const_buffer &buf) {
     // remove dead sessions
     _sessions.remove_if([](const std::shared_ptr<TCPSession> &s) { return !s->is_open(); });
 
-    shared_const_buffer buf(msg, size);
-
     for (auto &s : _sessions)
         s->write(buf);
 }
@@ -51,4 +54,12 @@ bool TCPServer::is_busy() const {
     return busy;
 }
 
+size_t TCPServer::queued_bytes() const {
+    size_t queued{0};
+    for (auto &s : _sessions)
+        queued = std::max(queued, s->queued_bytes());
+
+    return queued;
+}
+
 // vim: set ts=4 sw=4 sts=4 expandtab:
@@ -26,8 +26,14 @@ class TCPServer : Network {
 
         void write(const char *msg, const size_t size);
 
+        // zero-copy, buf keeps referencing its data until sent
+        void write(const shared_const_buffer &buf);
+
         bool is_busy() const;
 
+        // bytes not sent yet to the slowest client
+        size_t queued_bytes() const;
+
     private:
         tcp::socket *_socket;
         tcp::acceptor *_acceptor;
@@ -5,6 +5,9 @@
 
 #include <boost/bind/bind.hpp>
 
+#include <sys/ioctl.h>
+#include <linux/sockios.h>
+
 #include "tcp_server.h"
 #include "network.h"
 
@@ -32,6 +35,8 @@ void TCPSession::close() {
             // don't care about errors here
         }
         _socket.close();
+        for (auto &buf : _queue)
+            _queuedBytes -= buf.size();
         _queue.clear();
     } catch (std::exception &e) {
         std::cerr << __func__ << ": " << e.what() << std::endl;
@@ -46,7 +51,18 @@ bool TCPSession::is_busy() const {
     return !_queue.empty();
 }
 
+size_t TCPSession::queued_bytes() {
+    size_t queued = _queuedBytes;
+
+    int unsent{0};
+    if (_socket.is_open() && ioctl(_socket.native_handle(), SIOCOUTQ, &unsent) == 0 && unsent > 0)
+        queued += unsent;
+
+    return queued;
+}
+
 void TCPSession::write(const shared_const_buffer &buf) {
+    _queuedBytes += buf.size();
     _strand.post(boost::bind(&TCPSession::addWrite, this, buf));
 }
 
@@ -73,7 +89,10 @@ void TCPSession::doWrite() {
 }
 
 void TCPSession::writeHandler(boost::system::error_code ec, std::size_t length) {
-    _queue.pop_front();
+    if (!_queue.empty()) {
+        _queuedBytes -= _queue.front().size();
+        _queue.pop_front();
+    }
     if (ec)
         close();
 
@@ -2,6 +2,7 @@
 
 #include <boost/asio/io_service.hpp>
 #include <boost/lockfree/queue.hpp>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <memory>
@@ -24,12 +25,16 @@ class TCPSession : public std::enable_shared_from_this<TCPSession> {
         bool is_open() const;
         bool is_busy() const;
 
+        // bytes waiting to be sent: own queue and socket send buffer (not yet acknowledged)
+        size_t queued_bytes();
+
         void write(const shared_const_buffer &buf);
 
     private:
         tcp::socket _socket;
         boost::asio::io_service::strand _strand;
         std::deque<shared_const_buffer> _queue;
+        std::atomic<size_t> _queuedBytes{0};
 
         void addWrite(const shared_const_buffer &buf);
         void doWrite();
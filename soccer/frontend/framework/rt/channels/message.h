@@ -1,12 +1,14 @@
 #pragma once
 
 #include "../message_utils.h"
+#include "../util/versioned_buffer.h"
+#include "../util/snoop_queue.h"
 
 #include <mutex>
 #include <vector>
-#include <condition_variable>
 #include <optional>
 #include <functional>
+#include <variant>
 
 namespace rt {
 
@@ -15,13 +17,20 @@ class MessageChannel {
 public:
     using TapFunction = std::function<void(const T &)>;
 
+    // Listeners of lock-free channels read the newest message in place, see RT_LOCKFREE_CHANNEL.
+    static constexpr bool LockFree = is_lockfree_channel_v<T>;
+
     int addListener() {
-        listeners.emplace_back(new ListenerCtx{});
-        return listeners.size() - 1;
+        if constexpr (LockFree) {
+            return versioned.addReader();
+        } else {
+            listeners.emplace_back(new ListenerCtx{});
+            return listeners.size() - 1;
+        }
     }
 
     int addSnoopingListener() {
-        snoopers.emplace_back(new SnoopingCtx{});
+        snoopers.emplace_back(new SnoopQueue<T>(snoop_policy<T>::capacity, snoop_policy<T>::overflow));
         return snoopers.size() - 1;
     }
     
@@ -34,6 +43,10 @@ public:
            func(data); 
         }
 
+        if constexpr (LockFree) {
+            versioned.write(data);
+        }
+
         for (auto &ctx : listeners) {
             std::lock_guard lock{ctx->mtx};
             if (ctx->queue == std::nullopt) {
@@ -43,62 +56,89 @@ public:
             }
         }
 
-        for (auto &ctx : snoopers) {
-            std::lock_guard lock{ctx->mtx};
-            ctx->queue.push_back(data);
-            ctx->onNewEntry.notify_one();
+        for (auto &queue : snoopers) {
+            queue->push(data);
+        }
+    }
+
+    bool hasNewData(int id) const {
+        if constexpr (LockFree) {
+            return versioned.hasNewData(id);
+        } else {
+            return assureListener(id).queue.has_value();
         }
     }
 
-    bool hasNewData(int id) const { return assureListener(id).queue.has_value(); }
+    // Zero-copy fetch, only available on lock-free channels.
+    // `view` stays valid until the next call to fetchView() / maybeFetchView().
+    void fetchView(int id, const T *&view) {
+        static_assert(LockFree, "fetchView() requires RT_LOCKFREE_CHANNEL");
+        jsassert(versioned.hasNewData(id));
+        view = &versioned.acquire(id);
+    }
 
-    void fetch(int id, T &out) {
-        auto &ctx = assureListener(id);
-        std::lock_guard lock{ctx.mtx};
-        jsassert(ctx.queue.has_value());
-        out = *ctx.queue;
-        ctx.queue = std::nullopt;
+    void maybeFetchView(int id, const T *&view) {
+        static_assert(LockFree, "maybeFetchView() requires RT_LOCKFREE_CHANNEL");
+        if (versioned.hasNewData(id)) {
+            view = &versioned.acquire(id);
+        }
     }
 
-    void maybeFetch(int id, T &out) {
-        auto &ctx = assureListener(id);
-        std::lock_guard lock{ctx.mtx};
-        if (ctx.queue.has_value()) {
+    void fetch(int id, T &out) {
+        if constexpr (LockFree) {
+            const T *view = nullptr;
+            fetchView(id, view);
+            out = *view;
+        } else {
+            auto &ctx = assureListener(id);
+            std::lock_guard lock{ctx.mtx};
+            jsassert(ctx.queue.has_value());
             out = *ctx.queue;
             ctx.queue = std::nullopt;
         }
     }
 
+    void maybeFetch(int id, T &out) {
+        if constexpr (LockFree) {
+            if (versioned.hasNewData(id)) {
+                out = versioned.acquire(id);
+            }
+        } else {
+            auto &ctx = assureListener(id);
+            std::lock_guard lock{ctx.mtx};
+            if (ctx.queue.has_value()) {
+                out = *ctx.queue;
+                ctx.queue = std::nullopt;
+            }
+        }
+    }
+
+    // Sleeps until a message arrives. The timeout only bounds how long
+    // a module takes to notice a shutdown.
     void waitWhileEmpty(int id) {
-        using namespace std::chrono;
-        auto &ctx = assureSnoop(id);
-        std::unique_lock lock{ctx.mtx};
-        auto timeout = high_resolution_clock::now() + milliseconds(1);
-        ctx.onNewEntry.wait_until(lock, timeout, [&]() { return not ctx.queue.empty(); });
+        assureSnoop(id).waitWhileEmpty(std::chrono::milliseconds(100));
     }
 
     std::vector<T> snoopFetch(int id) {
-        auto &ctx = assureSnoop(id);
-        std::lock_guard lock{ctx.mtx};
-        std::vector<T> out = std::move(ctx.queue);
-        ctx.queue.clear();
+        std::vector<T> out;
+        assureSnoop(id).popAll(out);
         return out;
     }
 
+    // messages this snooping listener lost, because it didn't fetch fast enough
+    uint64_t snoopDropped(int id) const {
+        return assureSnoop(id).dropped();
+    }
+
 private:
     struct ListenerCtx {
         std::mutex mtx;
         std::optional<T> queue;
     };
 
-    struct SnoopingCtx {
-        std::mutex mtx;
-        std::condition_variable onNewEntry;
-        std::vector<T> queue;
-    };
-
     std::vector<std::unique_ptr<ListenerCtx>> listeners;
-    std::vector<std::unique_ptr<SnoopingCtx>> snoopers;
+    std::conditional_t<LockFree, VersionedBuffer<T>, std::monostate> versioned;
+    std::vector<std::unique_ptr<SnoopQueue<T>>> snoopers;
 
     std::vector<TapFunction> taps;
 
@@ -112,12 +152,12 @@ private:
         return *listeners[id];
     }
 
-    SnoopingCtx &assureSnoop(int id) {
+    SnoopQueue<T> &assureSnoop(int id) {
         jsassert(id > -1 && size_t(id) < snoopers.size());
         return *snoopers[id];
     }
 
-    const SnoopingCtx &assureSnoop(int id) const {
+    const SnoopQueue<T> &assureSnoop(int id) const {
         jsassert(id > -1 && size_t(id) < snoopers.size());
         return *snoopers[id];
     }
@@ -40,13 +40,14 @@ namespace  detail {
         friend class rt::Linker;
 
         T data = {};
+        const T *view = nullptr; // set instead of data by lock-free channels
         int id = -1;
 
         inline bool connected() const { return id != -1; }
 
         const T &assure() const {
             jsassert(connected());
-            return data;
+            return (view != nullptr) ? *view : data;
         }
     };
     
@@ -59,6 +60,8 @@ namespace  detail {
     public:
         std::vector<T> fetch() { return assertLink().snoopFetch(id); }
         void waitWhileEmpty() { assertLink().waitWhileEmpty(id); }
+        // messages lost so far, because the queue was full, see RT_SNOOP_POLICY
+        uint64_t dropped() { return assertLink().snoopDropped(id); }
 
     private:
         friend class rt::Linker;
@@ -5,6 +5,7 @@
 #include "output.h"
 
 #include <atomic>
+#include <tuple>
 
 namespace rt {
 
@@ -66,6 +67,22 @@ namespace  detail {
     private:
         std::shared_ptr<TaskMetadata<context_type>> meta {nullptr};
     };
+}
+
+// tasks and their results must never be dropped, so dispatchers and handlers wait instead
+template<typename ContextT>
+struct snoop_policy<detail::TaskData<ContextT>> {
+    static constexpr size_t capacity = 1024;
+    static constexpr SnoopOverflow overflow = SnoopOverflow::Block;
+};
+
+template<typename ContextT, typename ResultT>
+struct snoop_policy<std::tuple<detail::TaskData<ContextT>, ResultT>> {
+    static constexpr size_t capacity = 1024;
+    static constexpr SnoopOverflow overflow = SnoopOverflow::Block;
+};
+
+namespace detail {
     
     template<typename ContextT>
     class TaskResultEmitter {
@@ -3,12 +3,15 @@
 #include "util/stacktrace.h"
 #include "util/depth_first_search.h"
 #include "meta.h"
+#include "trace.h"
 
+#include "../benchmark/profiler.h"
 #include "../blackboard/blackboard.h"
 #include "../util/assert.h"
 #include "../thread/util.h"
 #include "../thread/threadmanager.h"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <sstream>
@@ -23,6 +26,21 @@ bool Kernel::isReady(ModuleId id) const {
     return meta.modules.at(id).ready();
 }
 
+bool Kernel::pacesItself(ModuleId id) const {
+    // Modules without required inputs pace themselves, e.g. by blocking on
+    // hardware or sleeping inside process().
+    return meta.modules[id].readyFuncs.empty();
+}
+
+bool Kernel::runsOnPool(ModuleId id) const {
+    // Modules that pace themselves would starve the pool, so they keep their own thread.
+    return pool != nullptr
+        && isModule(id)
+        && not tag_set(meta.modules[id].tags, ModuleTag::NoThread)
+        && cpus.at(id) < 0
+        && not pacesItself(id);
+}
+
 bool Kernel::isRunning() const {
     return state == State::RUNNING_SEQ || state == State::RUNNING_ASYNC;
 }
@@ -84,6 +102,17 @@ Kernel::CompileResult Kernel::compile() {
     return resolve();
 }
 
+void Kernel::setScheduling(Scheduling mode, uint32_t numWorkers) {
+    jsassert(state == State::SETUP || state == State::READY);
+    this->scheduling = mode;
+    this->numWorkers = numWorkers;
+}
+
+void Kernel::pin(std::string_view moduleName, int cpu) {
+    jsassert(state == State::SETUP || state == State::READY);
+    pinned.emplace_back(moduleName, cpu);
+}
+
 void Kernel::link() {
     ModuleTag extra = ModuleTag::None;
 
@@ -101,6 +130,15 @@ void Kernel::link() {
         module.connect(l);
         jsassert(m == l.finish());
     }
+
+    zones.clear();
+    for (ModuleId m = 0; m < modules.size(); m++) {
+        if (pacesItself(m)) {
+            zones.emplace_back(std::nullopt);
+        } else {
+            zones.emplace_back(std::in_place, "module." + meta.modules[m].name);
+        }
+    }
 }
 
 Kernel::CompileResult Kernel::resolve() {
@@ -180,6 +218,10 @@ Kernel::CompileResult Kernel::resolve() {
 
 void Kernel::run(ModuleId id) {
     jsassert(not tag_set(meta.modules[id].tags, ModuleTag::NoThread));
+    std::optional<profiler::Scope> scope;
+    if (zones[id]) {
+        scope.emplace(*zones[id]);
+    }
     try {
         modules[id]->process();
     } catch (std::exception &e) {
@@ -190,6 +232,56 @@ void Kernel::run(ModuleId id) {
     }
 }
 
+void Kernel::runTraced(ModuleId id, int64_t fetchStart) {
+    if (not Tracer::isEnabled()) {
+        run(id);
+        dump(id);
+        return;
+    }
+
+    int64_t origin = 0;
+    for (ModuleId p : producers[id]) {
+        origin = std::max(origin, frameOrigins[p].load(std::memory_order_relaxed));
+    }
+    Tracer::setFrameOrigin(origin);
+
+    int64_t runStart = Tracer::now();
+    run(id);
+    int64_t runEnd = Tracer::now();
+
+    origin = Tracer::getFrameOrigin();
+    frameOrigins[id].store(origin, std::memory_order_relaxed);
+
+    dump(id);
+    int64_t dumpEnd = Tracer::now();
+
+    const char *name = meta.modules[id].name.c_str();
+    Tracer::record(TraceEvent::Kind::WAIT, name, fetchStart, runStart);
+    Tracer::record(TraceEvent::Kind::RUN, name, runStart, runEnd);
+    Tracer::record(TraceEvent::Kind::DUMP, name, runEnd, dumpEnd);
+    if (origin > 0) {
+        Tracer::record(TraceEvent::Kind::LATENCY, name, origin, runEnd);
+    }
+}
+
+void Kernel::findProducers() {
+    producers.assign(modules.size(), {});
+    for (ModuleId m = 0; m < modules.size(); m++) {
+        for (EndpointId in : meta.modules[m].endpoints) {
+            const EndpointMeta &input = meta.endpoints.at(in);
+            if (input.kind != EndpointMeta::Direction::IN || not input.required) {
+                continue;
+            }
+            for (EndpointId out : meta.channels.at(input.channel).endpoints) {
+                const EndpointMeta &output = meta.endpoints.at(out);
+                if (output.kind == EndpointMeta::Direction::OUT) {
+                    producers[m].push_back(output.module);
+                }
+            }
+        }
+    }
+}
+
 void Kernel::step(ModuleId id) {
     jsassert(state == State::READY || state == State::RUNNING_SEQ);
 
@@ -223,18 +315,48 @@ void Kernel::start() {
 
     mutexes.resize(modules.size());
     onReady.resize(modules.size());
+    scheduled.resize(modules.size());
+    frameOrigins.resize(modules.size());
+    findProducers();
+
+    cpus.assign(modules.size(), -1);
+    for (auto &[name, cpu] : pinned) {
+        bool found = false;
+        for (ModuleId m = 0; m < modules.size(); m++) {
+            if (meta.modules[m].name == name) {
+                cpus[m] = cpu;
+                found = true;
+            }
+        }
+        if (not found) {
+            LOG_WARN << "can't pin unknown module '" << name << "'";
+        }
+    }
 
     if(!isSetup) {
         setup();
     }
 
+    if (scheduling == Scheduling::POOL) {
+        uint32_t workers = numWorkers;
+        if (workers == 0) {
+            uint32_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+            workers = std::max<uint32_t>(cores - std::min<uint32_t>(pinned.size(), cores), 1);
+        }
+        pool = CreateModulePool();
+        pool->start(workers);
+        LOG_INFO << "running modules on pool with " << workers << " workers";
+    }
+
     state = State::RUNNING_ASYNC;
 
     for (ModuleId m = 0; m < modules.size(); m++) {
         if(not isModule(m)) {
             continue;
         }
-        if (not tag_set(meta.modules[m].tags, ModuleTag::NoThread)) {
+        if (runsOnPool(m)) {
+            schedule(m);
+        } else if (not tag_set(meta.modules[m].tags, ModuleTag::NoThread)) {
             CreateModuleThread(this, m, -1);
         }
     }
@@ -254,11 +376,15 @@ void Kernel::stop() {
         return numRunning.load() == 0;
     });
     
+    if (pool != nullptr) {
+        pool->stop();
+    }
+
     for (ModuleId m = 0; m < modules.size(); m++) {
         if(not isModule(m)) {
             continue;
         }
-        if (tag_set(meta.modules[m].tags, ModuleTag::NoThread)) {
+        if (tag_set(meta.modules[m].tags, ModuleTag::NoThread) || runsOnPool(m)) {
             modules[m]->stop();
         }
     }
@@ -275,14 +401,17 @@ void Kernel::moduleLoop(ThreadContext* context, ModuleId moduleId, int runs = -1
     numRunning.fetch_add(1);
 
     set_current_thread_name(meta.modules[moduleId].name.c_str());
+    if (cpus.at(moduleId) >= 0) {
+        set_current_thread_affinity(cpus.at(moduleId));
+    }
 
     for (int it = 0; it < runs || runs < 0; it++) {
+        int64_t fetchStart = Tracer::now();
         fetch(moduleId);
         if (state == State::SHUTDOWN) {
             break;
         }
-        run(moduleId);
-        dump(moduleId);
+        runTraced(moduleId, fetchStart);
     }
 
     modules[moduleId]->stop();
@@ -312,12 +441,42 @@ void Kernel::dump(ModuleId id) {
         return;
     }
     for (ModuleId &other : meta.modules[id].requiredBy) {
-        if (meta.modules[other].ready()) {
+        if (runsOnPool(other)) {
+            schedule(other);
+        } else if (meta.modules[other].ready()) {
             onReady[other].notify_one();
         }
     }
 }
 
+void Kernel::schedule(ModuleId id) {
+    if (state != State::RUNNING_ASYNC || not meta.modules[id].ready()) {
+        return;
+    }
+    bool expected = false;
+    if (not scheduled[id].compare_exchange_strong(expected, true)) {
+        return;
+    }
+    numRunning.fetch_add(1);
+    pool->submit([this, id]() { runTask(id); });
+}
+
+void Kernel::runTask(ModuleId id) {
+    if (state == State::RUNNING_ASYNC) {
+        int64_t fetchStart = Tracer::now();
+        fetch(id);
+        runTraced(id, fetchStart);
+    }
+
+    // Clear flag before checking readiness again, so data arriving
+    // while this task was running isn't missed.
+    scheduled[id].store(false);
+    schedule(id);
+
+    numRunning.fetch_sub(1);
+    moduleStopped.notify_one();
+}
+
 std::string Kernel::printModules() const {
     std::stringstream ss{};
 
@@ -6,9 +6,12 @@
 #include "util/static_vector.h"
 #include "util/util.h"
 
+#include "../benchmark/profiler.h"
+
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -17,12 +20,14 @@
 #include <functional>
 
 class ThreadContext;
+class ThreadPool;
 class BlackboardBase;
 
 namespace rt {
 
 class Kernel;
 extern void CreateModuleThread(Kernel* kernel, ModuleId m, int runs);
+extern std::shared_ptr<ThreadPool> CreateModulePool();
 
 class Kernel {
 public:
@@ -30,6 +35,11 @@ public:
     using SetupFn = std::function<void()>;
     using CompileResult = std::pair<bool, std::string>;
 
+    enum class Scheduling {
+        THREAD_PER_MODULE,  // every module runs in its own thread
+        POOL,               // modules with required inputs run as tasks on a shared thread pool
+    };
+
     Kernel() = default;
 
     RT_DISABLE_COPY(Kernel)
@@ -40,6 +50,13 @@ public:
     ModuleId hook(std::string_view name, ConnectFn connect, SetupFn setup = {});
 
     CompileResult compile();
+
+    // Must be called before start().
+    // numWorkers = 0 uses one worker per core that has no pinned module.
+    void setScheduling(Scheduling mode, uint32_t numWorkers = 0);
+    // Run module in a dedicated thread pinned to the given cpu.
+    void pin(std::string_view moduleName, int cpu);
+
     void setup();
     void start();
     void stop();
@@ -88,8 +105,27 @@ private:
 
     State state = State::SETUP;
 
+    Scheduling scheduling = Scheduling::THREAD_PER_MODULE;
+    uint32_t numWorkers = 0;
+    std::shared_ptr<ThreadPool> pool;
+    std::vector<std::pair<std::string, int>> pinned;
+    std::vector<int> cpus;
+    StaticVector<std::atomic<bool>> scheduled;
+
+    // producers of the required inputs of each module and timestamp of the
+    // camera frame each module processed last, used for latency tracing
+    std::vector<std::vector<ModuleId>> producers;
+    StaticVector<std::atomic<int64_t>> frameOrigins;
+
+    // process() of modules triggered by their inputs is profiled as
+    // "module.<name>". Modules that pace themselves have no zone, it would
+    // count their waiting (sleep, epoll, ...) as cost.
+    std::vector<std::optional<profiler::Zone>> zones;
+
     bool isModule(ModuleId) const;
     bool isReady(ModuleId) const;
+    bool pacesItself(ModuleId) const;
+    bool runsOnPool(ModuleId) const;
 
     ModuleId load(ModuleBase *, ModuleMeta &moduleMeta);
     ModuleId addModule(ModuleBase *, LinkContext &&context);
@@ -106,7 +142,14 @@ private:
     void dump(ModuleId);
     void tryRun(ModuleId);
     void run(ModuleId);
-    
+    // run() + dump() with tracing, fetchStart is the time fetch() was called
+    void runTraced(ModuleId, int64_t fetchStart);
+    void findProducers();
+
+    // Submit module to the pool if it is ready and not already queued or running.
+    void schedule(ModuleId);
+    void runTask(ModuleId);
+
     void step(ModuleId);
 };
 
@@ -27,12 +27,20 @@ public:
 
         if constexpr (flag_set(Flags, Listen)) {
             endpoint.id = link.addListener();
-            module.preProcess.emplace_back([&]() { link.maybeFetch(endpoint.id, endpoint.data); });
+            if constexpr (MessageChannel<T>::LockFree) {
+                module.preProcess.emplace_back([&]() { link.maybeFetchView(endpoint.id, endpoint.view); });
+            } else {
+                module.preProcess.emplace_back([&]() { link.maybeFetch(endpoint.id, endpoint.data); });
+            }
         } else if constexpr (flag_set(Flags, Require)) {
             required = true;
             endpoint.id = link.addListener();
             module.readyFuncs.emplace_back([&]() { return link.hasNewData(endpoint.id); });
-            module.preProcess.emplace_back([&]() { link.fetch(endpoint.id, endpoint.data); });
+            if constexpr (MessageChannel<T>::LockFree) {
+                module.preProcess.emplace_back([&]() { link.fetchView(endpoint.id, endpoint.view); });
+            } else {
+                module.preProcess.emplace_back([&]() { link.fetch(endpoint.id, endpoint.data); });
+            }
         } else if constexpr (flag_set(Flags, Event)) {
             endpoint.id = link.addSnoopingListener();
             endpoint.link = &link;
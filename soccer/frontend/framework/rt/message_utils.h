@@ -17,6 +17,44 @@ inline constexpr bool is_command_v = is_command<Command, Group>::value;
     template<> \
     struct rt::is_command<type, group> : std::true_type {}
 
+// Messages of lock-free channels are written once into a versioned buffer and
+// read in place by listeners, instead of being copied into a mutex-protected
+// queue per listener. Newer messages simply replace older ones, so only
+// register types that don't specialize rt::Squash.
+template<typename T>
+struct is_lockfree_channel : std::false_type {};
+
+template<typename T>
+inline constexpr bool is_lockfree_channel_v = is_lockfree_channel<T>::value;
+
+#define RT_LOCKFREE_CHANNEL(type) \
+    template<> \
+    struct rt::is_lockfree_channel<type> : std::true_type {}
+
+// What happens to a message written to a full snooping queue.
+enum class SnoopOverflow {
+    Spill,      // keep it in a list on the heap until the listener caught up, nothing is lost
+    DropOldest, // discard the oldest queued message to make room
+    DropNewest, // discard the message being written
+    Block,      // writer waits until the listener fetched, never use for realtime writers
+};
+
+// Snooping listeners get every message through a bounded lock-free queue, configure
+// size and behavior on overflow per message type, if the default doesn't fit.
+// Only types that opt in may lose messages.
+template<typename T>
+struct snoop_policy {
+    static constexpr size_t capacity = 32;
+    static constexpr SnoopOverflow overflow = SnoopOverflow::Spill;
+};
+
+#define RT_SNOOP_POLICY(type, size, policy) \
+    template<> \
+    struct rt::snoop_policy<type> { \
+        static constexpr size_t capacity = size; \
+        static constexpr rt::SnoopOverflow overflow = rt::SnoopOverflow::policy; \
+    }
+
 struct Dim {
     size_t x, y, z;
 
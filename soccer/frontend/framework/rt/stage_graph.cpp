@@ -0,0 +1,99 @@
+#include "stage_graph.h"
+#include "trace.h"
+
+#include "../thread/threadmanager.h"
+#include "../util/assert.h"
+
+using namespace rt;
+
+StageGraph::StageId StageGraph::add(const char *name, stage_t fn, const std::vector<StageId> &deps) {
+    const StageId id = stages.size();
+
+    auto stage = std::make_unique<Stage>(name);
+    stage->fn = std::move(fn);
+    for (StageId dep : deps) {
+        jsassert(dep < id) << "stage " << name << " depends on unknown stage " << dep;
+        stages[dep]->dependents.push_back(id);
+        stage->numDeps++;
+    }
+    stages.push_back(std::move(stage));
+    stageTimings.push_back({name, 0, 0});
+    return id;
+}
+
+void StageGraph::run(ThreadPool *threadPool) {
+    if (stages.empty()) {
+        return;
+    }
+
+    pool = threadPool;
+    std::vector<StageId> roots;
+    for (StageId id = 0; id < stages.size(); id++) {
+        stages[id]->remaining.store(stages[id]->numDeps, std::memory_order_relaxed);
+        if (stages[id]->numDeps == 0) {
+            roots.push_back(id);
+        }
+    }
+    {
+        std::scoped_lock lock(mtx);
+        unfinished = static_cast<int>(stages.size());
+    }
+
+    for (size_t i = 1; i < roots.size(); i++) {
+        if (pool != nullptr) {
+            pool->submit([this, id = roots[i]]() { execute(id); });
+        } else {
+            execute(roots[i]);
+        }
+    }
+    execute(roots[0]);
+
+    std::unique_lock lock(mtx);
+    onFinished.wait(lock, [this]() { return unfinished == 0; });
+}
+
+void StageGraph::execute(StageId id) {
+    std::vector<StageId> ready;
+    while (true) {
+        Stage &stage = *stages[id];
+
+        const int64_t start = Tracer::now();
+        {
+            profiler::Scope scope(stage.zone);
+            stage.fn();
+        }
+        const int64_t end = Tracer::now();
+        stageTimings[id] = {stage.name, start, end - start};
+        Tracer::record(TraceEvent::Kind::STAGE, stage.name, start, end);
+
+        ready.clear();
+        for (StageId next : stage.dependents) {
+            if (stages[next]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                ready.push_back(next);
+            }
+        }
+
+        // without a pool, the remaining stages are picked up by the calling thread
+        for (size_t i = 1; i < ready.size(); i++) {
+            if (pool != nullptr) {
+                pool->submit([this, next = ready[i]]() { execute(next); });
+            } else {
+                execute(ready[i]);
+            }
+        }
+
+        {
+            // the last stage must not touch the graph after this, run() may already have returned
+            std::scoped_lock lock(mtx);
+            if (--unfinished == 0) {
+                onFinished.notify_all();
+                return;
+            }
+        }
+
+        if (ready.empty()) {
+            return;
+        }
+        id = ready[0];
+    }
+}
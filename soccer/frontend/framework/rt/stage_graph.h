@@ -0,0 +1,83 @@
+#pragma once
+
+#include "util/util.h"
+
+#include "../benchmark/profiler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ThreadPool;
+
+namespace rt {
+
+/**
+ * Small dependency graph of stages, that is run once per frame.
+ *
+ * Stages, whose dependencies are finished, run in parallel on a thread pool.
+ * The calling thread takes part: it runs the first ready stage itself and
+ * every finished stage continues with one of the stages it unblocked,
+ * so a chain of stages stays on the same core.
+ *
+ * Stage timings of the last run are available with timings(),
+ * every stage is profiled as "stage.<name>" and recorded as trace event,
+ * if tracing is enabled.
+ */
+class StageGraph {
+public:
+    using StageId = size_t;
+    using stage_t = std::function<void()>;
+
+    struct Timing {
+        const char *name;
+        int64_t start;      // microseconds, same clock as Tracer::now()
+        int64_t duration;   // microseconds
+    };
+
+    StageGraph() = default;
+
+    RT_DISABLE_COPY(StageGraph)
+
+    // Dependencies have to be added first, so the graph can't contain cycles.
+    // name must outlive the graph (string literal).
+    StageId add(const char *name, stage_t fn, const std::vector<StageId> &deps = {});
+
+    // Run every stage once, returns when all stages are finished.
+    // Without a pool, stages run one after another on the calling thread.
+    void run(ThreadPool *pool);
+
+    // indexed by StageId
+    const std::vector<Timing> &timings() const { return stageTimings; }
+
+    size_t size() const { return stages.size(); }
+
+private:
+    struct Stage {
+        const char *name;
+        profiler::Zone zone;
+        stage_t fn;
+        std::vector<StageId> dependents;
+        int numDeps = 0;
+        std::atomic<int> remaining{0};
+
+        explicit Stage(const char *name) : name(name), zone(std::string("stage.") + name) {}
+    };
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::vector<Timing> stageTimings;
+    ThreadPool *pool = nullptr;
+
+    std::mutex mtx;
+    std::condition_variable onFinished;
+    int unfinished = 0;
+
+    // run id and every stage it unblocks, that is not handed to the pool
+    void execute(StageId id);
+};
+
+} // namespace rt
@@ -0,0 +1,73 @@
+#include "trace.h"
+
+#include "../ipc/time.h"
+
+#include <sstream>
+
+using namespace rt;
+
+std::atomic<bool> Tracer::enabled{false};
+std::atomic<size_t> Tracer::numDropped{0};
+std::mutex Tracer::mtx;
+std::vector<std::shared_ptr<Tracer::ThreadBuffer>> Tracer::buffers;
+thread_local int64_t Tracer::frameOrigin = 0;
+
+int64_t Tracer::now() {
+    return getSystemTimestamp();
+}
+
+Tracer::ThreadBuffer &Tracer::threadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (buffer == nullptr) {
+        std::lock_guard lock{mtx};
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->tid = buffers.size();
+        buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Tracer::record(TraceEvent::Kind kind, const char *module, int64_t start, int64_t end) {
+    if (not isEnabled()) {
+        return;
+    }
+    if (not threadBuffer().queue.push(TraceEvent{kind, module, start, end - start})) {
+        numDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Tracer::consume(TraceChunk &out) {
+    static const char *names[] = {"wait", "run", "dump", "latency", "stage"};
+
+    std::vector<std::shared_ptr<ThreadBuffer>> current;
+    {
+        std::lock_guard lock{mtx};
+        current = buffers;
+    }
+
+    std::stringstream ss;
+    bool first = true;
+    ss << "{\"traceEvents\":[";
+    for (auto &buffer : current) {
+        buffer->queue.consume_all([&](const TraceEvent &e) {
+            ss << (first ? "" : ",") << "\n";
+            first = false;
+            if (e.kind == TraceEvent::Kind::LATENCY) {
+                ss << "{\"name\":\"latency\",\"ph\":\"C\",\"pid\":0"
+                   << ",\"ts\":" << e.start + e.duration
+                   << ",\"args\":{\"" << e.module << "\":" << e.duration / 1000.f << "}}";
+            } else {
+                ss << "{\"name\":\"" << e.module << "\",\"cat\":\"" << names[static_cast<int>(e.kind)] << "\""
+                   << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->tid
+                   << ",\"ts\":" << e.start << ",\"dur\":" << e.duration << "}";
+            }
+        });
+    }
+    ss << "\n],\"otherData\":{\"dropped\":" << dropped() << "}}\n";
+
+    if (first) {
+        return false;
+    }
+    out.json = ss.str();
+    return true;
+}
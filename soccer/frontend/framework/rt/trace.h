@@ -0,0 +1,89 @@
+#pragma once
+
+#include "meta.h"
+#include "logdata/serializer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <boost/lockfree/spsc_queue.hpp>
+
+namespace rt {
+
+struct TraceEvent {
+    enum class Kind : uint8_t {
+        WAIT,       // fetch(): waiting for inputs + preprocessing
+        RUN,        // process()
+        DUMP,       // dump(): postprocessing + waking up dependent modules
+        LATENCY,    // time since the camera frame this module's inputs originate from
+        STAGE,      // stage of a StageGraph, e.g. a vision detector
+    };
+
+    Kind kind;
+    const char *module;
+    int64_t start;      // steady clock, microseconds (same clock as camera timestamps)
+    int64_t duration;   // microseconds
+};
+
+// Chunk of chrome trace / perfetto JSON, written to the log by LogFile.
+struct TraceChunk {
+    std::string json;
+};
+
+template<>
+struct LogDataSerializer<TraceChunk> {
+    static constexpr bool is_serializable = true;
+
+    LogDataSerializedType serialize(const TraceChunk &chunk) {
+        return std::make_tuple(chunk.json.size(), (uint8_t *)chunk.json.data());
+    }
+};
+
+/**
+ * Records per module timing of the kernel into per-thread lock-free ring buffers.
+ * Buffers are drained by a single consumer (the logger), events are dropped
+ * when a buffer is full.
+ */
+class Tracer {
+public:
+    static constexpr size_t BUFFER_SIZE = 1024;
+
+    static void enable(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    static int64_t now();
+
+    static void record(TraceEvent::Kind kind, const char *module, int64_t start, int64_t end);
+
+    // Set timestamp of the camera frame the current module is working on.
+    // Modules without own frames inherit the newest origin of their producers.
+    static void setFrameOrigin(int64_t timestamp) { frameOrigin = timestamp; }
+    static int64_t getFrameOrigin() { return frameOrigin; }
+
+    // Drain all buffers and format events as chrome trace JSON.
+    // Returns false if no events were recorded.
+    static bool consume(TraceChunk &out);
+
+    static size_t dropped() { return numDropped.load(std::memory_order_relaxed); }
+
+private:
+    using queue_type = boost::lockfree::spsc_queue<TraceEvent, boost::lockfree::capacity<BUFFER_SIZE>>;
+
+    struct ThreadBuffer {
+        size_t tid;
+        queue_type queue;
+    };
+
+    static std::atomic<bool> enabled;
+    static std::atomic<size_t> numDropped;
+    static std::mutex mtx;
+    static std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    static thread_local int64_t frameOrigin;
+
+    static ThreadBuffer &threadBuffer();
+};
+
+} // namespace rt
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace rt::futex {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free);
+
+// Private futexes are faster, but only work between threads of one process.
+// Use Shared for words in shared memory.
+enum class Scope : int {
+    Private = FUTEX_PRIVATE_FLAG,
+    Shared = 0,
+};
+
+// Sleep while word == expected, at most for timeout.
+// May return spuriously, callers have to check their condition again.
+inline void wait(std::atomic<uint32_t> &word, uint32_t expected, std::chrono::nanoseconds timeout,
+                 Scope scope = Scope::Private) {
+    using namespace std::chrono;
+    const auto s = duration_cast<seconds>(timeout);
+    timespec ts{static_cast<time_t>(s.count()), static_cast<long>((timeout - s).count())};
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT | static_cast<int>(scope), expected, &ts,
+            nullptr, 0);
+}
+
+inline void wait(std::atomic<uint32_t> &word, uint32_t expected, Scope scope = Scope::Private) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT | static_cast<int>(scope), expected, nullptr,
+            nullptr, 0);
+}
+
+inline void wake(std::atomic<uint32_t> &word, int count = INT_MAX, Scope scope = Scope::Private) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE | static_cast<int>(scope), count, nullptr,
+            nullptr, 0);
+}
+
+} // namespace rt::futex
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "futex.h"
+#include "../message_utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace rt {
+
+/**
+ * Bounded multi-producer queue of a snooping listener (see Vyukov's bounded MPMC queue).
+ *
+ * Every cell carries a sequence number, that tells producers and consumers if the cell
+ * is free or filled for their current lap, so neither side has to take a lock.
+ * The listener sleeps on a futex, that is only woken if someone actually waits.
+ *
+ * With SnoopOverflow::Spill, messages that don't fit go to a mutex protected list
+ * instead, until the listener fetched them. Meanwhile all messages take that
+ * slow path, so the order is kept.
+ */
+template<typename T>
+class SnoopQueue {
+
+public:
+    SnoopQueue(size_t capacity, SnoopOverflow overflow) : overflow(overflow) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // @return false, if data or an older message was dropped
+    bool push(const T &data) {
+        bool ok = true;
+        if (overflow == SnoopOverflow::Spill) {
+            if (spilling.load() or not tryPush(data)) {
+                pushOrSpill(data);
+            }
+        } else {
+            while (not tryPush(data)) {
+                if (overflow == SnoopOverflow::DropNewest) {
+                    dropCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else if (overflow == SnoopOverflow::DropOldest) {
+                    std::optional<T> oldest;
+                    if (tryPop(oldest)) {
+                        dropCount.fetch_add(1, std::memory_order_relaxed);
+                        ok = false;
+                    }
+                } else {
+                    waitForSpace();
+                }
+            }
+        }
+
+        pushed.fetch_add(1);
+        if (consumerWaiting.load() > 0) {
+            futex::wake(pushed);
+        }
+        return ok;
+    }
+
+    // move all queued messages to out
+    void popAll(std::vector<T> &out) {
+        std::optional<T> data;
+        while (tryPop(data)) {
+            out.emplace_back(std::move(*data));
+        }
+        // spilled messages are newer than all queued ones
+        if (spilling.load()) {
+            std::lock_guard lock{spillMtx};
+            std::move(spill.begin(), spill.end(), std::back_inserter(out));
+            spill.clear();
+            spilling = false;
+        }
+
+        popped.fetch_add(1);
+        if (producersWaiting.load() > 0) {
+            futex::wake(popped);
+        }
+    }
+
+    // sleep until a message was pushed, at most for timeout
+    void waitWhileEmpty(std::chrono::nanoseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            const uint32_t seen = pushed.load();
+            if (not empty()) {
+                return;
+            }
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) {
+                return;
+            }
+            consumerWaiting.fetch_add(1);
+            futex::wait(pushed, seen, remaining);
+            consumerWaiting.fetch_sub(1);
+        }
+    }
+
+    bool empty() const {
+        const size_t pos = head.load(std::memory_order_acquire);
+        return cells[pos & mask].seq.load(std::memory_order_acquire) != pos + 1 && not spilling.load();
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // number of messages dropped since creation
+    uint64_t dropped() const { return dropCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        std::optional<T> data;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    SnoopOverflow overflow;
+
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> head{0};
+
+    // change counters for futex wakeups
+    alignas(64) std::atomic<uint32_t> pushed{0};
+    std::atomic<uint32_t> consumerWaiting{0};
+    alignas(64) std::atomic<uint32_t> popped{0};
+    std::atomic<uint32_t> producersWaiting{0};
+
+    std::atomic<uint64_t> dropCount{0};
+
+    // SnoopOverflow::Spill only
+    std::mutex spillMtx;
+    std::vector<T> spill;
+    std::atomic<bool> spilling{false};
+
+    // slow path of SnoopOverflow::Spill, popAll() only changes spilling under the lock
+    void pushOrSpill(const T &data) {
+        std::lock_guard lock{spillMtx};
+        if (not spilling.load() and tryPush(data)) {
+            return;
+        }
+        spill.push_back(data);
+        spilling = true;
+        LOG_WARN_EVERY_N(1000) << "snooping listener can't keep up, " << spill.size()
+                               << " messages queued on the heap";
+    }
+
+    bool tryPush(const T &data) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = data;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(std::optional<T> &out) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // empty
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->data);
+        cell->data.reset();
+        cell->seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool full() const {
+        const size_t pos = tail.load(std::memory_order_acquire);
+        return cells[pos & mask].seq.load(std::memory_order_acquire) != pos;
+    }
+
+    void waitForSpace() {
+        const uint32_t seen = popped.load();
+        if (not full()) {
+            return;
+        }
+        producersWaiting.fetch_add(1);
+        // The timeout only rechecks after a missed wakeup. push() calls this until
+        // there is space, so a Block writer waits as long as the listener doesn't fetch.
+        futex::wait(popped, seen, std::chrono::milliseconds(10));
+        producersWaiting.fetch_sub(1);
+    }
+};
+
+} // namespace rt
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "../../util/assert.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace rt {
+
+/**
+ * Lock-free single-producer / multi-consumer buffer.
+ *
+ * Every reader may hold a reference to at most one cell at a time, so with
+ * n readers n + 2 cells are enough to guarantee the writer always finds a free
+ * cell (one for the newest data, one being written). Readers detect new data
+ * by comparing sequence numbers instead of checking a queue.
+ *
+ * Readers and cells must be added before the first call to write().
+ */
+template<typename T>
+class VersionedBuffer {
+
+public:
+    VersionedBuffer() {
+        addCell();
+        addCell();
+    }
+
+    int addReader() {
+        readers.emplace_back(new ReaderCtx{});
+        addCell();
+        return readers.size() - 1;
+    }
+
+    void write(const T &data) {
+        Cell &cell = lockForWriting();
+        cell.data = data;
+        cell.refCount.store(0, std::memory_order_release);
+        seq++;
+        published.store(pack(seq, writeCell), std::memory_order_release);
+    }
+
+    bool hasNewData(int id) const {
+        uint64_t p = published.load(std::memory_order_acquire);
+        return p != NONE && sequence(p) > assureReader(id).seq.load(std::memory_order_acquire);
+    }
+
+    // Reference the newest data, releasing the cell referenced before.
+    // The returned reference stays valid until the next call to acquire().
+    const T &acquire(int id) {
+        ReaderCtx &ctx = assureReader(id);
+        jsassert(published.load() != NONE);
+
+        uint64_t p;
+        size_t c;
+        for (;;) {
+            p = published.load(std::memory_order_acquire);
+            c = cellIndex(p);
+            if (tryLockForReading(c)) {
+                if (published.load(std::memory_order_acquire) == p) {
+                    break;
+                }
+                unlockForReading(c);
+            }
+        }
+
+        if (ctx.cell != NO_REF) {
+            unlockForReading(ctx.cell);
+        }
+        ctx.cell = c;
+        ctx.seq.store(sequence(p), std::memory_order_release);
+        return cells[c]->data;
+    }
+
+private:
+    static constexpr size_t NO_REF = std::numeric_limits<size_t>::max();
+    static constexpr uint64_t NONE = std::numeric_limits<uint64_t>::max();
+    static constexpr int CELL_BITS = 16;
+
+    struct alignas(64) Cell {
+        std::atomic<int> refCount{0};
+        T data{};
+    };
+
+    struct alignas(64) ReaderCtx {
+        std::atomic<uint64_t> seq{0};
+        size_t cell = NO_REF;
+    };
+
+    std::vector<std::unique_ptr<Cell>> cells;
+    std::vector<std::unique_ptr<ReaderCtx>> readers;
+
+    alignas(64) std::atomic<uint64_t> published{NONE};
+    uint64_t seq = 0;
+    size_t writeCell = NO_REF;
+
+    static constexpr uint64_t pack(uint64_t s, size_t cell) { return (s << CELL_BITS) | cell; }
+    static constexpr uint64_t sequence(uint64_t p) { return p >> CELL_BITS; }
+    static constexpr size_t cellIndex(uint64_t p) { return p & ((1 << CELL_BITS) - 1); }
+
+    void addCell() {
+        jsassert(published.load() == NONE) << "can't add readers after writing started";
+        jsassert(cells.size() < (1 << CELL_BITS));
+        cells.emplace_back(new Cell{});
+    }
+
+    Cell &lockForWriting() {
+        uint64_t p = published.load(std::memory_order_relaxed);
+        size_t newest = (p == NONE) ? NO_REF : cellIndex(p);
+        for (;;) {
+            for (size_t i = 0; i < cells.size(); i++) {
+                int expected = 0;
+                if (i != newest && cells[i]->refCount.compare_exchange_strong(expected, -1, std::memory_order_acquire)) {
+                    writeCell = i;
+                    return *cells[i];
+                }
+            }
+            // Can only happen if a reader is in the middle of acquire()
+            // and holds two cells for a short moment.
+        }
+    }
+
+    bool tryLockForReading(size_t id) {
+        auto &refCount = cells[id]->refCount;
+        int r = refCount.load(std::memory_order_relaxed);
+        while (r >= 0) {
+            if (refCount.compare_exchange_weak(r, r + 1, std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void unlockForReading(size_t id) {
+        int r = cells[id]->refCount.fetch_sub(1, std::memory_order_release);
+        jsassert(r > 0);
+    }
+
+    ReaderCtx &assureReader(int id) {
+        jsassert(id > -1 && size_t(id) < readers.size());
+        return *readers[id];
+    }
+
+    const ReaderCtx &assureReader(int id) const {
+        jsassert(id > -1 && size_t(id) < readers.size());
+        return *readers[id];
+    }
+};
+
+} // namespace rt
@@ -1,4 +1,6 @@
 #include <sys/prctl.h>
+#include <pthread.h>
+#include <sched.h>
 
 #include "util.h"
 #include "../logger/logger.h"
@@ -8,3 +10,14 @@ void set_current_thread_name(const std::string_view name) {
     if (0 != prctl(PR_SET_NAME, name.data()))
         LOG_ERROR << "Failed to set thread name: " << name;
 }
+
+bool set_current_thread_affinity(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (0 != pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+        LOG_ERROR << "Failed to pin thread to cpu " << cpu;
+        return false;
+    }
+    return true;
+}
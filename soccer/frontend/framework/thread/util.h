@@ -6,3 +6,4 @@ using namespace std::chrono_literals;
 using std::this_thread::sleep_for;
 
 void set_current_thread_name(const std::string_view name);
+bool set_current_thread_affinity(int cpu);
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "threadmanager.h"
+#include "../logger/logger.h"
+#include "../util/assert.h"
+
+/**
+ * Thread pool with one job queue per worker.
+ * Jobs submitted from a worker go to the back of its own queue and are
+ * popped from there (LIFO, cache friendly). Idle workers steal from the
+ * front of other queues before going to sleep.
+ */
+template<typename PriorityT>
+class WorkStealingThreadPool : public ThreadPool {
+public:
+    WorkStealingThreadPool(ThreadManager* manager, PriorityT priority)
+        : manager(manager), priority(priority) {
+
+    }
+
+    void start(uint32_t num_threads = std::thread::hardware_concurrency()) override {
+        num_threads = std::max(num_threads, 1u);
+        for (uint32_t i = 0; i < num_threads; i++) {
+            queues.emplace_back(new WorkerQueue{});
+        }
+        for (uint32_t i = 0; i < num_threads; i++) {
+            manager->create(priority, std::bind(&WorkStealingThreadPool::worker, this, std::placeholders::_1, i));
+        }
+    }
+
+    void stop() override {
+        {
+            std::unique_lock lock(mtx);
+            running = false;
+        }
+        onNewJob.notify_all();
+    }
+
+    void submit(job_t fn) override {
+        jsassert(not queues.empty()) << "pool not started";
+        size_t id = (current_pool == this) ? current_worker : next.fetch_add(1) % queues.size();
+        {
+            std::scoped_lock lock(queues[id]->mtx);
+            queues[id]->jobs.push_back(std::move(fn));
+        }
+        {
+            std::scoped_lock lock(mtx);
+            pending++;
+        }
+        onNewJob.notify_one();
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mtx;
+        std::deque<job_t> jobs;
+    };
+
+    static thread_local WorkStealingThreadPool *current_pool;
+    static thread_local size_t current_worker;
+
+    ThreadManager *manager = nullptr;
+    PriorityT priority;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::atomic<size_t> next{0};
+
+    std::mutex mtx;
+    std::condition_variable onNewJob;
+    size_t pending = 0;
+    bool running = true;
+
+    bool isRunning() const {
+        return running && manager->isRunning();
+    }
+
+    bool popOwn(size_t id, job_t &job) {
+        auto &q = *queues[id];
+        std::scoped_lock lock(q.mtx);
+        if (q.jobs.empty()) {
+            return false;
+        }
+        job = std::move(q.jobs.back());
+        q.jobs.pop_back();
+        return true;
+    }
+
+    bool steal(size_t id, job_t &job) {
+        for (size_t i = 1; i < queues.size(); i++) {
+            auto &q = *queues[(id + i) % queues.size()];
+            std::scoped_lock lock(q.mtx);
+            if (not q.jobs.empty()) {
+                job = std::move(q.jobs.front());
+                q.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker(ThreadContext *context, size_t id) {
+        current_pool = this;
+        current_worker = id;
+        context->notifyReady();
+
+        while (true) {
+            {
+                std::unique_lock lock(mtx);
+                onNewJob.wait(lock, [this](){ return pending > 0 || !isRunning(); });
+                if (!isRunning()) {
+                    break;
+                }
+                pending--;
+            }
+
+            // pending was decremented, so there is at least one job for us somewhere
+            job_t job;
+            while (!popOwn(id, job) && !steal(id, job)) {
+                std::this_thread::yield();
+            }
+            job();
+        }
+    }
+};
+
+template<typename PriorityT>
+thread_local WorkStealingThreadPool<PriorityT> *WorkStealingThreadPool<PriorityT>::current_pool = nullptr;
+
+template<typename PriorityT>
+thread_local size_t WorkStealingThreadPool<PriorityT>::current_worker = 0;
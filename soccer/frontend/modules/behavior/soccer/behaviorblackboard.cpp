@@ -2,7 +2,6 @@
 #include "standalone/config.h"
 #include "behaviorblackboard.h"
 #include <framework/logger/logger.h>
-#include <framework/benchmark/benchmarking.h>
 
 #include <cmath>
 
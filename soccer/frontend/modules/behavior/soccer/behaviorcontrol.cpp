@@ -2,7 +2,7 @@
 
 #include <framework/util/assert.h>
 #include <representations/blackboards/settings.h>
-#include <framework/benchmark/benchmarking.h>
+#include <framework/benchmark/profiler.h>
 #include "gc_enums_generated.h"
 #include "representations/bembelbots/constants.h"
 #include <modules/whistle/commands.h>
@@ -49,9 +49,10 @@ void BehaviorControl::run(microTime time_ms) {
     _myBehavior->bm_type = Motion::STAND;
 
     // update BehaviorBlackboard from based on other BBs
-    START_TIMER("behavior.update");
-    updateBehavior();
-    STOP_TIMER;
+    {
+        PROFILE_ZONE("behavior.update");
+        updateBehavior();
+    }
 
     // short-hand to get option-by-name
     auto getOpt = &Behavior::OptionInfos::getOption;
@@ -60,22 +61,26 @@ void BehaviorControl::run(microTime time_ms) {
     roots.push_back(getOpt(_myBehavior->behavior_root.c_str()));
 
     // execute behavior root option
-    START_TIMER("behavior.execute");
-    _myBehavior->execute(roots);
-    STOP_TIMER;
+    {
+        PROFILE_ZONE("behavior.execute");
+        _myBehavior->execute(roots);
+    }
 
     // apply leds
-    START_TIMER("behavior.apply.leds");
-    applyLEDs();
-    STOP_TIMER;
+    {
+        PROFILE_ZONE("behavior.apply.leds");
+        applyLEDs();
+    }
     // apply motion
-    START_TIMER("behavior.apply.motion");
-    applyMotion();
-    STOP_TIMER;
+    {
+        PROFILE_ZONE("behavior.apply.motion");
+        applyMotion();
+    }
     // apply misc
-    START_TIMER("behavior.apply.misc");
-    applyMisc();
-    STOP_TIMER;
+    {
+        PROFILE_ZONE("behavior.apply.misc");
+        applyMisc();
+    }
 }
 
 void BehaviorControl::updateBehavior() {
@@ -262,11 +267,12 @@ void BehaviorControl::applyMotion() {
 void BehaviorControl::applyMisc() {
     Behavior *bh = _myBehavior.get();
 
-    START_TIMER("behavior.apply.misc.intention");
-    _myBehavior->intention = _myBehavior->determineIntention();
-    STOP_TIMER;
+    {
+        PROFILE_ZONE("behavior.apply.misc.intention");
+        _myBehavior->intention = _myBehavior->determineIntention();
+    }
 
-    START_TIMER("behavior.apply.misc.whistlecmd");
+    PROFILE_ZONE("behavior.apply.misc.whistlecmd");
     if (bh->whistle_listen)
         whistleCmds.enqueue<bbapi::WhistleStartT>();
     else
@@ -275,8 +281,6 @@ void BehaviorControl::applyMisc() {
     TeamcommDebugInfo tc;
     tc.role = _myBehavior->role_current;
     teamcommCmds.enqueue<TeamcommDebugInfo>(tc);
-
-    STOP_TIMER;
 }
 
 // vim: set ts=4 sw=4 sts=4 expandtab:
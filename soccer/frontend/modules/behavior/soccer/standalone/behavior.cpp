@@ -37,12 +37,10 @@ Behavior &Behavior::operator=(Behavior &&other) {
 
 bool Behavior::doDebugRequest(const BBSetRequest &request) {
     try {
-        auto it = behavior->_set_funcs.find(request.name);
-        it->second(request.value);
+        return behavior->setValue(request.name, request.value);
     } catch (...) {
         return false;
     }
-    return true;
 }
 
 Output &Behavior::execute(const Input &input) {
@@ -186,11 +184,15 @@ std::vector<BlackboardEntry> Behavior::dumpBlackboard() const {
     std::vector<BlackboardEntry> data;
 
     /* static_assert(std::is_base_of<BehaviorBlackboard, BEHAVE_PRIVATE::Behavior>::value); */
-    for (auto &entry : behavior->_get_funcs) {
+    for (Introspection::SymbolId id = 0; id < behavior->symbols().size(); id++) {
+        if (not behavior->hasValue(id)) {
+            continue;
+        }
+        const auto &symbol = behavior->symbols()[id];
         data.push_back(BlackboardEntry{
-                .name = entry.first,
-                .value = entry.second().getValue(),
-                .editable = behavior->isEditable(entry.first),
+                .name = symbol.name,
+                .value = behavior->getValue(id).getValue(),
+                .editable = symbol.parse != nullptr,
         });
     }
 
@@ -5,7 +5,16 @@ PRIVATE
     ${MODLOCALIZIATION_DIR}/poseblackboard.cpp
     ${MODLOCALIZIATION_DIR}/pose.cpp
     ${MODLOCALIZIATION_DIR}/particlefilter.cpp
+    ${MODLOCALIZIATION_DIR}/measurement.cpp
     ${MODLOCALIZIATION_DIR}/hypothesesgenerator.cpp
 )
 
 add_library(modlocalization INTERFACE)
+
+add_executable(test_measurement EXCLUDE_FROM_ALL
+    ${MODLOCALIZIATION_DIR}/test/test_measurement.cpp
+)
+target_link_libraries(test_measurement
+    libfrontend
+    ${Boost_PROGRAM_OPTIONS_LIBRARY}
+)
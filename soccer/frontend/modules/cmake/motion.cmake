@@ -45,3 +45,11 @@ INTERFACE
     ${MODMOTION_DIR}
 )
 target_link_libraries(modmotion INTERFACE Eigen3::Eigen)
+
+add_executable(bodycontrol_benchmark EXCLUDE_FROM_ALL
+    ${MODMOTION_DIR}/benchmark/bodycontrol_benchmark.cpp
+)
+target_link_libraries(bodycontrol_benchmark
+    libfrontend
+    ${Boost_PROGRAM_OPTIONS_LIBRARY}
+)
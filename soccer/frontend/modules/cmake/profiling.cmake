@@ -0,0 +1,8 @@
+set(MODPROFILING_DIR ${CMAKE_CURRENT_SOURCE_DIR}/profiling)
+
+target_sources(libfrontend
+PRIVATE
+    ${MODPROFILING_DIR}/profiling.cpp
+)
+
+add_library(modprofiling INTERFACE)
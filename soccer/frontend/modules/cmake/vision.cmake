@@ -3,6 +3,7 @@ set(MODVISION_DIR ${CMAKE_CURRENT_SOURCE_DIR}/vision)
 target_sources(libfrontend
 PRIVATE
     ${MODVISION_DIR}/vision.cpp
+    ${MODVISION_DIR}/visionpipeline.cpp
     ${MODVISION_DIR}/toolbox/visiontoolbox.cpp
     ${MODVISION_DIR}/toolbox/colorclasses.cpp
     ${MODVISION_DIR}/detector/ball_detector.cpp
@@ -12,3 +13,11 @@ PRIVATE
 
 add_library(modvision INTERFACE)
 target_link_libraries(modvision INTERFACE dl HTWKVision ${OpenCV_LIBS})
+
+add_executable(vision_replay EXCLUDE_FROM_ALL
+    ${MODVISION_DIR}/benchmark/vision_replay.cpp
+)
+target_link_libraries(vision_replay
+    libfrontend
+    ${Boost_PROGRAM_OPTIONS_LIBRARY}
+)
@@ -9,9 +9,17 @@ PRIVATE
     ${MODWHISTLE_DIR}/detect/whistle_classifier.cpp
     ${MODWHISTLE_DIR}/detect/whistle_detector.cpp
     ${MODWHISTLE_DIR}/detect/sine_generator.cpp
+    ${MODWHISTLE_DIR}/detect/wavreader.cpp
     ${MODWHISTLE_DIR}/whistle.cpp
 )
 
 add_library(modwhistle INTERFACE)
 target_link_libraries(modwhistle INTERFACE fftw3f asound)
 
+add_executable(whistle_replay EXCLUDE_FROM_ALL
+    ${MODWHISTLE_DIR}/benchmark/whistle_replay.cpp
+)
+target_link_libraries(whistle_replay
+    libfrontend
+    ${Boost_PROGRAM_OPTIONS_LIBRARY}
+)
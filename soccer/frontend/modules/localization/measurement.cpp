@@ -0,0 +1,278 @@
+/**
+ * @author Module owner: Bembelbots Frankfurt, sinaditzel
+ *
+ * vectorized measurement model of the particle filter
+ */
+
+#include "measurement.h"
+#include "particlefilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <framework/math/angle.h>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace {
+
+// 4 floats, one lane per particle
+#if defined(__SSE4_1__)
+struct Vec4 {
+    __m128 v;
+
+    static Vec4 load(const float *p) { return {_mm_loadu_ps(p)}; }
+    static Vec4 all(float f) { return {_mm_set1_ps(f)}; }
+    void store(float *p) const { _mm_storeu_ps(p, v); }
+
+    friend Vec4 operator+(Vec4 a, Vec4 b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Vec4 operator-(Vec4 a, Vec4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend Vec4 operator*(Vec4 a, Vec4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend Vec4 operator/(Vec4 a, Vec4 b) { return {_mm_div_ps(a.v, b.v)}; }
+    friend Vec4 operator>(Vec4 a, Vec4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+    friend Vec4 operator<(Vec4 a, Vec4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+    friend Vec4 min(Vec4 a, Vec4 b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend Vec4 max(Vec4 a, Vec4 b) { return {_mm_max_ps(a.v, b.v)}; }
+    friend Vec4 sqrt(Vec4 a) { return {_mm_sqrt_ps(a.v)}; }
+    friend Vec4 abs(Vec4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.f), a.v)}; }
+    friend Vec4 round(Vec4 a) { return {_mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    // copy sign of b to a
+    friend Vec4 copysign(Vec4 a, Vec4 b) {
+        __m128 sign = _mm_set1_ps(-0.f);
+        return {_mm_or_ps(_mm_andnot_ps(sign, a.v), _mm_and_ps(sign, b.v))};
+    }
+    // mask ? a : b
+    friend Vec4 select(Vec4 mask, Vec4 a, Vec4 b) { return {_mm_blendv_ps(b.v, a.v, mask.v)}; }
+};
+#else
+// plain fallback, the compiler might still vectorize this
+struct Vec4 {
+    float v[4];
+
+    template<typename F>
+    static Vec4 map(F f) {
+        Vec4 r;
+        for (int i = 0; i < 4; i++) {
+            r.v[i] = f(i);
+        }
+        return r;
+    }
+
+    static Vec4 load(const float *p) { return map([=](int i) { return p[i]; }); }
+    static Vec4 all(float f) { return map([=](int) { return f; }); }
+    void store(float *p) const {
+        for (int i = 0; i < 4; i++) {
+            p[i] = v[i];
+        }
+    }
+
+    // comparison results are 1 / 0 instead of bit masks
+    friend Vec4 operator+(Vec4 a, Vec4 b) { return map([&](int i) { return a.v[i] + b.v[i]; }); }
+    friend Vec4 operator-(Vec4 a, Vec4 b) { return map([&](int i) { return a.v[i] - b.v[i]; }); }
+    friend Vec4 operator*(Vec4 a, Vec4 b) { return map([&](int i) { return a.v[i] * b.v[i]; }); }
+    friend Vec4 operator/(Vec4 a, Vec4 b) { return map([&](int i) { return a.v[i] / b.v[i]; }); }
+    friend Vec4 operator>(Vec4 a, Vec4 b) { return map([&](int i) { return float(a.v[i] > b.v[i]); }); }
+    friend Vec4 operator<(Vec4 a, Vec4 b) { return map([&](int i) { return float(a.v[i] < b.v[i]); }); }
+    friend Vec4 min(Vec4 a, Vec4 b) { return map([&](int i) { return std::min(a.v[i], b.v[i]); }); }
+    friend Vec4 max(Vec4 a, Vec4 b) { return map([&](int i) { return std::max(a.v[i], b.v[i]); }); }
+    friend Vec4 sqrt(Vec4 a) { return map([&](int i) { return std::sqrt(a.v[i]); }); }
+    friend Vec4 abs(Vec4 a) { return map([&](int i) { return std::fabs(a.v[i]); }); }
+    friend Vec4 round(Vec4 a) { return map([&](int i) { return std::nearbyint(a.v[i]); }); }
+    friend Vec4 copysign(Vec4 a, Vec4 b) { return map([&](int i) { return std::copysign(a.v[i], b.v[i]); }); }
+    friend Vec4 select(Vec4 mask, Vec4 a, Vec4 b) { return map([&](int i) { return mask.v[i] ? a.v[i] : b.v[i]; }); }
+};
+#endif
+
+static_assert(ParticleSoA::WIDTH == 4);
+
+constexpr float TWO_PI = 2.f * M_PI_F;
+
+// same deviation as ParticleFilter::prob()
+constexpr float DEVIATION = 0.8f;
+const float NORM = 1.0f / (DEVIATION * std::sqrt(TWO_PI));
+const float NORM3 = NORM * NORM * NORM;
+constexpr float EXPONENT = -0.5f / (DEVIATION * DEVIATION);
+
+// distance from robot, below this the angle to a landmark is not used
+constexpr float MIN_ANGLE_DIST = 0.1f;
+
+// normalize to [-pi, pi], like Angle::normalize()
+inline Vec4 wrap(Vec4 a) {
+    return a - Vec4::all(TWO_PI) * round(a * Vec4::all(1.f / TWO_PI));
+}
+
+// polynomial from cephes atanf(), range reduced to [0, tan(pi/8)]
+inline Vec4 atan2(Vec4 y, Vec4 x) {
+    Vec4 ax = abs(x);
+    Vec4 ay = abs(y);
+    Vec4 hi = max(ax, ay);
+    Vec4 lo = min(ax, ay);
+    Vec4 t = select(hi > Vec4::all(0.f), lo / hi, Vec4::all(0.f));
+    Vec4 big = t > Vec4::all(0.414213562f);
+    t = select(big, (t - Vec4::all(1.f)) / (t + Vec4::all(1.f)), t);
+    Vec4 s = t * t;
+    Vec4 r = (((Vec4::all(8.05374449538e-2f) * s - Vec4::all(1.38776856032e-1f)) * s
+            + Vec4::all(1.99777106478e-1f)) * s - Vec4::all(3.33329491539e-1f)) * s * t + t;
+    r = select(big, r + Vec4::all(0.25f * M_PI_F), r);
+    r = select(ay > ax, Vec4::all(0.5f * M_PI_F) - r, r);
+    r = select(x < Vec4::all(0.f), Vec4::all(M_PI_F) - r, r);
+    return copysign(r, y);
+}
+
+// angle between observation and landmark, as in ParticleFilter::calculateProbabilityOfMatchingLandmark()
+inline Vec4 angleDiff(float obsDist, float obsAngle, Vec4 dist, Vec4 angle) {
+    if (obsDist <= MIN_ANGLE_DIST) {
+        return Vec4::all(0.f);
+    }
+    Vec4 a = abs(Vec4::all(obsAngle) - angle);
+    a = min(a, Vec4::all(TWO_PI) - a);
+    return select(dist > Vec4::all(MIN_ANGLE_DIST), a, Vec4::all(0.f));
+}
+
+// closest landmark is the one with highest prob(dist) * prob(angle) * prob(orientation),
+// so only the smallest sum of squares has to go through exp()
+inline void applyBest(Vec4 best, float *prob) {
+    float e[4];
+    best.store(e);
+    for (int i = 0; i < 4; i++) {
+        prob[i] *= NORM3 * std::exp(EXPONENT * e[i]);
+    }
+}
+
+} // namespace
+
+
+LandmarkTable::LandmarkTable(const PlayingField *pf) {
+    for (auto &line : pf->getLines()) {
+        // same selection as in ParticleFilter::createLineFeature()
+        if ((line.name == Line::OWN_PENALTY_SHOOTMARK)
+                or (line.name == Line::OPP_PENALTY_SHOOTMARK)
+                or (line.name == Line::OWN_GOALBACK_BACK)
+                or (line.name == Line::OPP_GOALBACK_BACK)
+                or (line.name == Line::OPP_GOALBACK_LEFT)
+                or (line.name == Line::OPP_GOALBACK_RIGHT)
+                or (line.name == Line::OWN_GOALBACK_LEFT)
+                or (line.name == Line::OWN_GOALBACK_RIGHT)
+                ) {
+            continue;
+        }
+        float dx = line.end_x - line.start_x;
+        float dy = line.end_y - line.start_y;
+        lines.startX.push_back(line.start_x);
+        lines.startY.push_back(line.start_y);
+        lines.dirX.push_back(dx);
+        lines.dirY.push_back(dy);
+        // Coord::closestPointOnLine() returns start in this case
+        lines.invLengthSq.push_back((dx + dy == 0) ? 0.f : 1.f / (dx * dx + dy * dy));
+        lines.direction.push_back(std::atan2(dy, dx));
+    }
+
+    auto addCrosses = [](Points &points, const std::vector<LandmarkCross> &crosses) {
+        for (auto &cross : crosses) {
+            points.x.push_back(cross.wcs_x);
+            points.y.push_back(cross.wcs_y);
+            points.alpha.push_back(Angle::normalize(cross.wcs_alpha));
+        }
+    };
+    addCrosses(lCrosses, pf->getLCrosses());
+    addCrosses(tCrosses, pf->getTCrosses());
+    addCrosses(xCrosses, pf->getXCrosses());
+
+    circles.x.push_back(0.f);
+    circles.y.push_back(0.f);
+    circles.alpha.push_back(0.f);
+    circles.hasOrientation = false;
+}
+
+
+void ParticleSoA::gather(const std::vector<Particle> &particles) {
+    count = particles.size();
+    size_t padded = (count + WIDTH - 1) / WIDTH * WIDTH;
+    for (auto *v : {&x, &y, &angle, &cosA, &sinA, &prob}) {
+        v->resize(padded);
+    }
+
+    for (size_t i = 0; i < padded; i++) {
+        // repeat last particle as padding
+        const Particle &p = particles[std::min(i, count - 1)];
+        x[i] = p.pose.coord.x;
+        y[i] = p.pose.coord.y;
+        angle[i] = p.pose.angle.rad();
+        cosA[i] = std::cos(angle[i]);
+        sinA[i] = std::sin(angle[i]);
+        prob[i] = 1.0f;
+    }
+}
+
+
+void matchLines(const LandmarkTable::Lines &lines, const std::vector<Feature> &observations, ParticleSoA &particles) {
+    for (size_t i = 0; i < particles.x.size(); i += ParticleSoA::WIDTH) {
+        Vec4 px = Vec4::load(&particles.x[i]);
+        Vec4 py = Vec4::load(&particles.y[i]);
+        Vec4 pa = Vec4::load(&particles.angle[i]);
+        Vec4 c = Vec4::load(&particles.cosA[i]);
+        Vec4 s = Vec4::load(&particles.sinA[i]);
+
+        for (auto &obs : observations) {
+            Vec4 best = Vec4::all(std::numeric_limits<float>::max());
+            for (size_t l = 0; l < lines.size(); l++) {
+                // closest point on the (infinite) line
+                Vec4 sx = Vec4::all(lines.startX[l]);
+                Vec4 sy = Vec4::all(lines.startY[l]);
+                Vec4 dx = Vec4::all(lines.dirX[l]);
+                Vec4 dy = Vec4::all(lines.dirY[l]);
+                Vec4 t = ((px - sx) * dx + (py - sy) * dy) * Vec4::all(lines.invLengthSq[l]);
+                Vec4 ex = sx + t * dx - px;
+                Vec4 ey = sy + t * dy - py;
+
+                // in rcs of the particle
+                Vec4 dist = sqrt(ex * ex + ey * ey);
+                Vec4 angle = atan2(ey * c - ex * s, ex * c + ey * s);
+
+                Vec4 d = Vec4::all(obs.dist) - dist;
+                Vec4 a = angleDiff(obs.dist, obs.angle, dist, angle);
+                // the direction of lines is not clear
+                Vec4 o = wrap(Vec4::all(obs.orientation - lines.direction[l]) + pa);
+                o = min(abs(o), abs(wrap(o - Vec4::all(M_PI_F))));
+
+                best = min(best, d * d + a * a + o * o);
+            }
+            applyBest(best, &particles.prob[i]);
+        }
+    }
+}
+
+void matchPoints(const LandmarkTable::Points &points, const std::vector<Feature> &observations, ParticleSoA &particles) {
+    for (size_t i = 0; i < particles.x.size(); i += ParticleSoA::WIDTH) {
+        Vec4 px = Vec4::load(&particles.x[i]);
+        Vec4 py = Vec4::load(&particles.y[i]);
+        Vec4 pa = Vec4::load(&particles.angle[i]);
+        Vec4 c = Vec4::load(&particles.cosA[i]);
+        Vec4 s = Vec4::load(&particles.sinA[i]);
+
+        for (auto &obs : observations) {
+            Vec4 best = Vec4::all(std::numeric_limits<float>::max());
+            for (size_t l = 0; l < points.size(); l++) {
+                Vec4 ex = Vec4::all(points.x[l]) - px;
+                Vec4 ey = Vec4::all(points.y[l]) - py;
+
+                Vec4 dist = sqrt(ex * ex + ey * ey);
+                Vec4 angle = atan2(ey * c - ex * s, ex * c + ey * s);
+
+                Vec4 d = Vec4::all(obs.dist) - dist;
+                Vec4 a = angleDiff(obs.dist, obs.angle, dist, angle);
+                Vec4 o = Vec4::all(0.f);
+                if (points.hasOrientation) {
+                    o = abs(wrap(Vec4::all(obs.orientation - points.alpha[l]) + pa));
+                }
+
+                best = min(best, d * d + a * a + o * o);
+            }
+            applyBest(best, &particles.prob[i]);
+        }
+    }
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
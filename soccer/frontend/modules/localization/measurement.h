@@ -0,0 +1,75 @@
+/**
+ * @author Module owner: Bembelbots Frankfurt, sinaditzel
+ *
+ * vectorized measurement model of the particle filter
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <representations/playingfield/playingfield.h>
+
+class Particle;
+class Feature;
+
+/*
+ * landmarks of the playing field as structure of arrays,
+ * precomputed once, so the measurement model doesn't have to
+ * rebuild them for every particle
+ */
+class LandmarkTable {
+public:
+    explicit LandmarkTable(const PlayingField *pf);
+
+    struct Lines {
+        std::vector<float> startX, startY;
+        std::vector<float> dirX, dirY;      // end - start
+        std::vector<float> invLengthSq;     // 1 / |end - start|^2, 0 if start should be used as closest point
+        std::vector<float> direction;       // wcs angle of end - start
+
+        size_t size() const { return startX.size(); }
+    };
+
+    struct Points {
+        std::vector<float> x, y;
+        std::vector<float> alpha;           // normalized wcs orientation
+        bool hasOrientation = true;
+
+        size_t size() const { return x.size(); }
+    };
+
+    Lines lines;
+    Points lCrosses;
+    Points tCrosses;
+    Points xCrosses;
+    Points circles;
+};
+
+/*
+ * particle poses as structure of arrays, padded to a multiple of the SIMD width
+ */
+class ParticleSoA {
+public:
+    static constexpr size_t WIDTH = 4;
+
+    std::vector<float> x, y, angle;
+    std::vector<float> cosA, sinA;
+    std::vector<float> prob;
+
+    void gather(const std::vector<Particle> &particles);
+
+    // number of particles (without padding)
+    size_t size() const { return count; }
+
+private:
+    size_t count = 0;
+};
+
+/*
+ * multiplies prob of every particle with the probability of the best matching landmark for every observation.
+ * all observations must have the same type as the landmarks.
+ */
+void matchLines(const LandmarkTable::Lines &lines, const std::vector<Feature> &observations, ParticleSoA &particles);
+void matchPoints(const LandmarkTable::Points &points, const std::vector<Feature> &observations, ParticleSoA &particles);
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
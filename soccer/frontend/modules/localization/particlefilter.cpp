@@ -44,6 +44,7 @@ ParticleFilter::ParticleFilter(const Settings &config)
   : conf(config)
   , pos(DirectedCoord(0.0f, 0.0f, 0.0_rad))
   , confidence(0.0f)
+  , landmarks(config.pf)
   , lastMcsPosition(config.startMcsPosition)
   , isFallenRobot(false)
   , isReplaced(false)
@@ -241,11 +242,11 @@ void ParticleFilter::moveParticles(const DirectedCoord &currMcsPosition) {
 calculate a probability for one visionResult by comparing it with the landmarks from the same type
 */
 std::pair<float,Feature> ParticleFilter::calculateProbabilityOfMatchingLandmark(
-    Feature visionresult, vector<Feature> pfLandmarks) {
+    const Feature &visionresult, const vector<Feature> &pfLandmarks) {
     // calculate probability by comparing angle and distance
     float probability = 0.0f;
     Feature matchedLandmark;
-    for (auto pfLandmark: pfLandmarks) {
+    for (auto &pfLandmark: pfLandmarks) {
 
         assert(visionresult.type == pfLandmark.type);
 
@@ -333,60 +334,55 @@ bool ParticleFilter::measurementModel(const vector<VisionResult> &vrs) {
             }
         }
 
-        vector<Feature> pfLines;
-        vector<Feature> pfLCrosses;
-        vector<Feature> pfTCrosses;
-        vector<Feature> pfXCrosses;
-        vector<Feature> pfGoals;
-        vector<Feature> pfCircles;
-        for (auto &particle: particles) {
-            matchedLandmarks.clear();
-            float probability = 1.0f;
-            // for every particle compare Visionresulst with Landmarks from Playingfield
-            if (!vrsLines.empty()) {
-                pfLines = createLineFeature(particle);
-                for (auto &vrsLine: vrsLines) {
-                    auto res = calculateProbabilityOfMatchingLandmark(vrsLine, pfLines);
-                    probability *= res.first;
-                    matchedLandmarks.push_back(res.second);
+        // weight all particles at once, see measurement.cpp
+        particlesSoA.gather(particles);
+        if (!vrsLines.empty()) {
+            matchLines(landmarks.lines, vrsLines, particlesSoA);
+        }
+        if (!vrsLCrosses.empty()) {
+            matchPoints(landmarks.lCrosses, vrsLCrosses, particlesSoA);
+        }
+        if (!vrsTCrosses.empty()) {
+            matchPoints(landmarks.tCrosses, vrsTCrosses, particlesSoA);
+        }
+        if (!vrsXCrosses.empty()) {
+            matchPoints(landmarks.xCrosses, vrsXCrosses, particlesSoA);
+        }
+        if (!vrsCircles.empty()) {
+            matchPoints(landmarks.circles, vrsCircles, particlesSoA);
+        }
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            // if we see one visionresult probability is smaller then 1.0
+            if (particlesSoA.prob[i] != 1.0f) {
+                particles[i].weight = particlesSoA.prob[i];
+                isMeasurementUpdate = true;
+            }
+        }
+
+        // matched landmarks are only kept for debugging (of the last particle)
+        matchedLandmarks.clear();
+        if (!particles.empty()) {
+            const Particle &particle = particles.back();
+            auto addMatches = [&](const vector<Feature> &observations, const vector<Feature> &pfLandmarks) {
+                for (auto &observation : observations) {
+                    matchedLandmarks.push_back(calculateProbabilityOfMatchingLandmark(observation, pfLandmarks).second);
                 }
+            };
+            if (!vrsLines.empty()) {
+                addMatches(vrsLines, createLineFeature(particle));
             }
             if (!vrsLCrosses.empty()) {
-                pfLCrosses = createLCrossFeature(particle);
-                for (auto &vrsLCross: vrsLCrosses) {
-                    auto res = calculateProbabilityOfMatchingLandmark(vrsLCross, pfLCrosses);
-                    probability *= res.first;
-                    matchedLandmarks.push_back(res.second);
-                }
+                addMatches(vrsLCrosses, createLCrossFeature(particle));
             }
             if (!vrsTCrosses.empty()) {
-                pfTCrosses = createTCrossFeature(particle);
-                for (auto &vrsTCross: vrsTCrosses) {
-                    auto res = calculateProbabilityOfMatchingLandmark(vrsTCross, pfTCrosses);
-                    probability *= res.first;
-                    matchedLandmarks.push_back(res.second);
-                }
+                addMatches(vrsTCrosses, createTCrossFeature(particle));
             }
             if (!vrsXCrosses.empty()) {
-                pfXCrosses = createXCrossFeature(particle);
-                for (auto &vrsXCross: vrsXCrosses) {
-                    auto res = calculateProbabilityOfMatchingLandmark(vrsXCross, pfXCrosses);
-                    probability *= res.first;
-                    matchedLandmarks.push_back(res.second);
-                }
+                addMatches(vrsXCrosses, createXCrossFeature(particle));
             }
             if (!vrsCircles.empty()) {
-                pfCircles = createCircleFeature(particle);
-                for (auto &vrsCircle: vrsCircles) {
-                    auto res = calculateProbabilityOfMatchingLandmark(vrsCircle, pfCircles);
-                    probability *= res.first;
-                    matchedLandmarks.push_back(res.second);
-                }
-            }
-            // if we see one visionresult probability is smaller then 1.0
-            if (probability != 1.0f) {
-                particle.weight = probability;
-                isMeasurementUpdate = true;
+                addMatches(vrsCircles, createCircleFeature(particle));
             }
         }
     }
@@ -404,16 +400,17 @@ void ParticleFilter::lowVarianzeResample() {
     vector<Particle> tmp_particles;
     tmp_particles.reserve(conf.numParticles);
     float beam = 0.f;
+    // beams are increasing, so the search can continue where the last one stopped
+    size_t count_particle = 0;
+    float sum_weight = particles.at(0).weight;
     for (size_t i = 0; i<(conf.numParticles); i++) {
         // every particle is according to a number(/area of numbers):
         // 1. first calculating this number
         beam = random_number + (i*(1.0f/conf.numParticles));
         // 2. choose particle
-        size_t count_particle = 0;
-        for (float sum_weight = particles.at(0).weight; (sum_weight < beam)
-                and (count_particle < conf.numParticles-1);
-                sum_weight += particles.at(count_particle).weight) {
+        while ((sum_weight < beam) and (count_particle < conf.numParticles-1)) {
             count_particle++;
+            sum_weight += particles[count_particle].weight;
         }
         tmp_particles.emplace_back(Particle(DirectedCoord(particles.at(count_particle).pose.coord.x,
                                                     particles.at(count_particle).pose.coord.y,
@@ -664,7 +661,7 @@ const float ParticleFilter::prob(float x, float deviation) const {
 
 
 
-vector<Feature> ParticleFilter::createLineFeature(const Particle particle) {
+vector<Feature> ParticleFilter::createLineFeature(const Particle &particle) {
     vector<Feature> pfLines;
     for (auto &line: conf.pf->getLines()) {
         /// penaltymarks are still treaten as line in our playingfield...
@@ -697,7 +694,7 @@ vector<Feature> ParticleFilter::createLineFeature(const Particle particle) {
     return pfLines;
 }
 
-vector<Feature> ParticleFilter::createGoalFeature(const Particle particle) {
+vector<Feature> ParticleFilter::createGoalFeature(const Particle &particle) {
     std::vector<Feature> pfGoals;
     for (auto &pole: conf.pf->getPoles()) {
         //calculate distance and angle between particle and conf.pf landmark
@@ -709,7 +706,7 @@ vector<Feature> ParticleFilter::createGoalFeature(const Particle particle) {
     return pfGoals;
 }
 
-vector<Feature> ParticleFilter::createCircleFeature(const Particle particle) {
+vector<Feature> ParticleFilter::createCircleFeature(const Particle &particle) {
     vector<Feature> pfCircles;
     //calculate distance and angle between particle and conf.pf landmark
     DirectedCoord center(0.0f, 0.0f, 0.0_rad);
@@ -720,7 +717,7 @@ vector<Feature> ParticleFilter::createCircleFeature(const Particle particle) {
     return pfCircles;
 }
 
-vector<Feature> ParticleFilter::createLCrossFeature(const Particle particle) {
+vector<Feature> ParticleFilter::createLCrossFeature(const Particle &particle) {
     vector<Feature> pfLCrosses;
     for (auto &cross: conf.pf->getLCrosses()) {
         /*if ((cross.name == Cross::L_OWN_PENALTY_LEFT)
@@ -741,7 +738,7 @@ vector<Feature> ParticleFilter::createLCrossFeature(const Particle particle) {
     return pfLCrosses;
 }
 
-vector<Feature> ParticleFilter::createTCrossFeature(const Particle particle) {
+vector<Feature> ParticleFilter::createTCrossFeature(const Particle &particle) {
     vector<Feature> pfTCrosses;
     for (auto &cross: conf.pf->getTCrosses()) {
         /*if ((cross.name == Cross::T_OWN_PENALTY_LEFT)
@@ -762,7 +759,7 @@ vector<Feature> ParticleFilter::createTCrossFeature(const Particle particle) {
     return pfTCrosses;
 }
 
-vector<Feature> ParticleFilter::createXCrossFeature(const Particle particle) {
+vector<Feature> ParticleFilter::createXCrossFeature(const Particle &particle) {
     vector<Feature> pfXCrosses;
     for (auto &cross: conf.pf->getXCrosses()) {
         //calculate distance and angle between particle and conf.pf landmark
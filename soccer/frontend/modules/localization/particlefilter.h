@@ -11,6 +11,7 @@
 #include <representations/playingfield/playingfield.h>
 #include <representations/vision/visiondefinitions.h>
 #include <framework/math/directed_coord.h>
+#include "measurement.h"
 #include <functional>
 #include <cassert>
 
@@ -127,6 +128,12 @@ public:
     //particles
     std::vector<Particle> particles;
 
+    // landmarks of conf.pf, precomputed for the measurement model
+    LandmarkTable landmarks;
+
+    // particles as structure of arrays, only used in measurementModel()
+    ParticleSoA particlesSoA;
+
     // needed to caculate random numbers
     std::default_random_engine generator;
 
@@ -169,8 +176,8 @@ public:
     void globalLocalisation();
     void gotGroundHandler();
 
-    std::pair<float,Feature> calculateProbabilityOfMatchingLandmark(Feature visionresult,
-            std::vector<Feature> pf_landmarks);
+    std::pair<float,Feature> calculateProbabilityOfMatchingLandmark(const Feature &visionresult,
+            const std::vector<Feature> &pf_landmarks);
     bool measurementModel(const std::vector<VisionResult> &vrs);
     void moveParticles(const DirectedCoord &odo);
     void lowVarianzeResample();
@@ -182,12 +189,12 @@ public:
     void setParticlesToPosition(std::vector<DirectedCoord> positions, float deviationX = 0.05f,
                                 float deviationY = 0.05f, float deviationAlpha = 0.05f,
                                 float amount = 1);
-    std::vector<Feature> createLineFeature(const Particle particle);
-    std::vector<Feature> createGoalFeature(const Particle particle);
-    std::vector<Feature> createLCrossFeature(const Particle particle);
-    std::vector<Feature> createTCrossFeature(const Particle particle);
-    std::vector<Feature> createXCrossFeature(const Particle particle);
-    std::vector<Feature> createCircleFeature(const Particle particle);
+    std::vector<Feature> createLineFeature(const Particle &particle);
+    std::vector<Feature> createGoalFeature(const Particle &particle);
+    std::vector<Feature> createLCrossFeature(const Particle &particle);
+    std::vector<Feature> createTCrossFeature(const Particle &particle);
+    std::vector<Feature> createXCrossFeature(const Particle &particle);
+    std::vector<Feature> createCircleFeature(const Particle &particle);
     void sortParticle();
     void normalizeParticle();
     constexpr inline float fastExp(float x) const;
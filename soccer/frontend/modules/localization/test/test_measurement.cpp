@@ -0,0 +1,263 @@
+/**
+ * Compares the vectorized measurement model (measurement.cpp) with the
+ * scalar one it replaced: ParticleFilter::create*Feature() and
+ * ParticleFilter::calculateProbabilityOfMatchingLandmark().
+ *
+ * Both are evaluated on random particles and random observations of every
+ * landmark type. The vectorized atan2() is a polynomial, so the weights
+ * only have to match up to a small relative error.
+ *
+ * Build:
+ *   cd build/<target>
+ *   make test_measurement
+ *
+ * Usage:
+ *   bin/test_measurement [--particles 1000] [--rounds 50] [--seed 1]
+ *
+ * Returns 0 if all weights match, 1 otherwise.
+ */
+
+#include "../measurement.h"
+#include "../particlefilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <framework/math/angle.h>
+#include <framework/math/directed_coord.h>
+#include <representations/playingfield/playingfield.h>
+#include <representations/vision/visiondefinitions.h>
+
+using namespace std;
+
+namespace {
+
+// largest allowed relative difference between scalar and vectorized weight
+constexpr float MAX_REL_ERROR = 1e-3f;
+
+// weights below this are compared absolutely, the relative error of exp() is meaningless there
+constexpr float MIN_WEIGHT = 1e-20f;
+
+// ParticleFilter::prob()
+float prob(float x, float deviation = 0.8f) {
+    return 1.0f / (deviation * std::sqrt(2 * M_PI_F)) * std::exp(-0.5f * powf(x / deviation, 2));
+}
+
+// ParticleFilter::createLineFeature()
+vector<Feature> lineFeatures(const PlayingField &pf, const Particle &particle) {
+    vector<Feature> pfLines;
+    for (auto &line : pf.getLines()) {
+        if ((line.name == Line::OWN_PENALTY_SHOOTMARK)
+                or (line.name == Line::OPP_PENALTY_SHOOTMARK)
+                or (line.name == Line::OWN_GOALBACK_BACK)
+                or (line.name == Line::OPP_GOALBACK_BACK)
+                or (line.name == Line::OPP_GOALBACK_LEFT)
+                or (line.name == Line::OPP_GOALBACK_RIGHT)
+                or (line.name == Line::OWN_GOALBACK_LEFT)
+                or (line.name == Line::OWN_GOALBACK_RIGHT)
+                ) {
+            continue;
+        }
+        Coord start(line.start_x, line.start_y);
+        Coord end(line.end_x, line.end_y);
+        DirectedCoord pointOnLine;
+        pointOnLine.coord = particle.pose.coord.closestPointOnLine(start, end);
+        Coord rcsline = pointOnLine.toRCS(particle.pose).coord;
+        float dist = particle.pose.coord.dist(pointOnLine.coord);
+        float angle = rcsline.angle().rad();
+        float orientation = ((end - start).direction() - particle.pose.angle).rad();
+        pfLines.push_back(Feature(JSVISION_LINE, dist, angle, orientation, (int)line.name));
+    }
+    return pfLines;
+}
+
+// ParticleFilter::create{L,T,X}CrossFeature()
+vector<Feature> crossFeatures(const vector<LandmarkCross> &crosses, int type, const Particle &particle) {
+    vector<Feature> pfCrosses;
+    for (auto &cross : crosses) {
+        DirectedCoord crossCoord(cross.wcs_x, cross.wcs_y, Rad{cross.wcs_alpha});
+        Coord rcsCross = crossCoord.toRCS(particle.pose).coord;
+        float dist = rcsCross.dist();
+        float angle = rcsCross.angle().rad();
+        float orientation = Angle::normalize(cross.wcs_alpha) - particle.pose.angle.rad();
+        pfCrosses.push_back(Feature(type, dist, angle, orientation, 0));
+    }
+    return pfCrosses;
+}
+
+// ParticleFilter::createCircleFeature()
+vector<Feature> circleFeatures(const Particle &particle) {
+    DirectedCoord center(0.0f, 0.0f, 0.0_rad);
+    Coord rcsCenter = center.toRCS(particle.pose).coord;
+    return {Feature(JSVISION_CIRCLE, rcsCenter.dist(), rcsCenter.angle().rad(), 0.0f, 0)};
+}
+
+// ParticleFilter::calculateProbabilityOfMatchingLandmark()
+float bestMatch(const Feature &visionresult, const vector<Feature> &pfLandmarks) {
+    float probability = 0.0f;
+    for (auto &pfLandmark : pfLandmarks) {
+        float distance = visionresult.dist - pfLandmark.dist;
+
+        float angle;
+        if ((pfLandmark.dist > 0.1f) and (visionresult.dist > 0.1f)) {
+            angle = fabsf(visionresult.angle - pfLandmark.angle);
+            angle = min(angle, 2.0f * M_PI_F - angle);
+        } else {
+            angle = 0.0f;
+        }
+
+        float orientationdist;
+        if (JSVISION_LINE == visionresult.type) {
+            orientationdist = Angle(Rad{visionresult.orientation}).dist(Rad{pfLandmark.orientation}).rad();
+            orientationdist = min(fabsf(orientationdist), fabsf(Angle(Rad{orientationdist - M_PI_F}).rad()));
+        } else {
+            orientationdist = fabsf(Angle(Rad{visionresult.orientation}).dist(Rad{pfLandmark.orientation}).rad());
+        }
+
+        probability = max(probability, prob(distance) * prob(angle) * prob(orientationdist));
+    }
+    return probability;
+}
+
+float scalarWeight(const vector<Feature> &observations, const vector<Feature> &pfLandmarks) {
+    float weight = 1.0f;
+    for (auto &observation : observations) {
+        weight *= bestMatch(observation, pfLandmarks);
+    }
+    return weight;
+}
+
+bool similar(float expected, float actual) {
+    if (expected < MIN_WEIGHT && actual < MIN_WEIGHT) {
+        return true;
+    }
+    return std::fabs(expected - actual) <= MAX_REL_ERROR * std::max(expected, actual);
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    int numParticles, rounds;
+    unsigned seed;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("particles", po::value<int>(&numParticles)->default_value(1000), "random particles per round")
+        ("rounds", po::value<int>(&rounds)->default_value(50), "rounds with new observations")
+        ("seed", po::value<unsigned>(&seed)->default_value(1), "seed of the random generator")
+        ("help,h", "produce help message.");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        cout << endl << desc << endl;
+        return 0;
+    }
+
+    const PlayingField pf(FieldSize::SPL);
+    const LandmarkTable landmarks(&pf);
+
+    mt19937 generator(seed);
+    uniform_real_distribution<float> randomX(-pf._lengthInsideBounds / 2 - 0.5f, pf._lengthInsideBounds / 2 + 0.5f);
+    uniform_real_distribution<float> randomY(-pf._widthInsideBounds / 2 - 0.5f, pf._widthInsideBounds / 2 + 0.5f);
+    uniform_real_distribution<float> randomAngle(-M_PI_F, M_PI_F);
+    // includes observations closer than 0.1m, where the angle is not used
+    uniform_real_distribution<float> randomDist(0.0f, 5.0f);
+    uniform_int_distribution<int> randomCount(1, 3);
+
+    auto randomObservations = [&](int type) {
+        vector<Feature> observations;
+        for (int i = randomCount(generator); i > 0; i--) {
+            // measurementModel() creates circles without orientation
+            float orientation = (type == JSVISION_CIRCLE) ? 0.0f : randomAngle(generator);
+            observations.push_back(Feature(type, randomDist(generator), randomAngle(generator), orientation, 0));
+        }
+        return observations;
+    };
+
+    struct Type {
+        const char *name;
+        int type;
+        const LandmarkTable::Points *points;  // nullptr for lines
+        int mismatches = 0;
+        float maxError = 0.0f;
+    };
+    vector<Type> types = {
+        {"line", JSVISION_LINE, nullptr},
+        {"lcross", JSVISION_LCROSS, &landmarks.lCrosses},
+        {"tcross", JSVISION_TCROSS, &landmarks.tCrosses},
+        {"xcross", JSVISION_XCROSS, &landmarks.xCrosses},
+        {"circle", JSVISION_CIRCLE, &landmarks.circles},
+    };
+
+    vector<Particle> particles;
+    ParticleSoA particlesSoA;
+    for (int round = 0; round < rounds; round++) {
+        // odd counts, so the padding of the last SIMD block is covered as well
+        particles.clear();
+        const size_t count = numParticles + round % ParticleSoA::WIDTH;
+        for (size_t i = 0; i < count; i++) {
+            particles.emplace_back(DirectedCoord(randomX(generator), randomY(generator),
+                                                 Rad{randomAngle(generator)}), 1.0f);
+        }
+
+        for (auto &t : types) {
+            vector<Feature> observations = randomObservations(t.type);
+
+            particlesSoA.gather(particles);
+            if (t.points) {
+                matchPoints(*t.points, observations, particlesSoA);
+            } else {
+                matchLines(landmarks.lines, observations, particlesSoA);
+            }
+
+            for (size_t i = 0; i < particles.size(); i++) {
+                vector<Feature> pfLandmarks;
+                switch (t.type) {
+                    case JSVISION_LINE:
+                        pfLandmarks = lineFeatures(pf, particles[i]);
+                        break;
+                    case JSVISION_LCROSS:
+                        pfLandmarks = crossFeatures(pf.getLCrosses(), t.type, particles[i]);
+                        break;
+                    case JSVISION_TCROSS:
+                        pfLandmarks = crossFeatures(pf.getTCrosses(), t.type, particles[i]);
+                        break;
+                    case JSVISION_XCROSS:
+                        pfLandmarks = crossFeatures(pf.getXCrosses(), t.type, particles[i]);
+                        break;
+                    default:
+                        pfLandmarks = circleFeatures(particles[i]);
+                        break;
+                }
+
+                const float expected = scalarWeight(observations, pfLandmarks);
+                const float actual = particlesSoA.prob[i];
+                if (!similar(expected, actual)) {
+                    if (t.mismatches++ < 5) {
+                        cerr << t.name << " mismatch: particle " << particles[i].pose
+                             << " expected " << expected << " got " << actual << endl;
+                    }
+                }
+                if (expected >= MIN_WEIGHT) {
+                    t.maxError = max(t.maxError, std::fabs(expected - actual) / expected);
+                }
+            }
+        }
+    }
+
+    bool ok = true;
+    for (auto &t : types) {
+        cout << t.name << ": max relative error " << t.maxError << ", " << t.mismatches << " mismatches" << endl;
+        ok = ok && (t.mismatches == 0);
+    }
+    return ok ? 0 : 1;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
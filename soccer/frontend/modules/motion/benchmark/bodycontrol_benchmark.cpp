@@ -0,0 +1,152 @@
+/**
+ * Runs BodyControl offline and reports the motion cycle time, i.e. how long
+ * BodyControl::step() takes for one LoLa cycle, as latency percentiles.
+ *
+ * Like bodycontrol/test/benchmark.cpp it requests one motion after the other
+ * and steps BodyControl while the motion runs. The first phase runs the
+ * MODULEs only. Sensor data is all zeros, so this measures the scheduling and
+ * computation cost, not the behavior of the motions.
+ *
+ * Build:
+ *   cd build/<target>
+ *   make bodycontrol_benchmark
+ *
+ * Usage:
+ *   bin/bodycontrol_benchmark [-m <motions dir>] [-n cycles] [--interval-us 0] [MODULE_ID ...]
+ *
+ * Example:
+ *   Running `bin/bodycontrol_benchmark -m ../motions/ INTERPOLATE_TO_STAND BC_WALK SIT`
+ *   measures 5000 cycles each of the modules, stand, walk and sit.
+ *   --interval-us 12000 sleeps like the LoLa cycle between steps, so caches
+ *   are as cold as on the robot.
+ */
+
+#include <bodycontrol/bodycontrol.h>
+#include <bodycontrol/utils/bbmf.h>
+#include <bodycontrol/utils/motionfile.h>
+#include "ipc_actuator_message_generated.h"
+#include "ipc_sensor_message_generated.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <framework/benchmark/latency.h>
+#include <framework/logger/logger.h>
+#include <framework/rt/context_pool.h>
+#include <framework/rt/linker.h>
+#include <framework/rt/meta.h>
+#include <framework/thread/simplethreadmanager.h>
+#include <representations/bembelbots/thread.h>
+#include <representations/blackboards/settings.h>
+
+ThreadManager* GetThreadManager() {
+    using T = SimpleThreadManager<NaoThread>;
+    static ThreadManager manager(new T());
+    return &manager;
+}
+
+void CreateXLoggerThread(XLogger *logger) {
+    using namespace std::placeholders;
+    GetThreadManager()->create(NaoThread::IO, std::bind(&XLogger::io_worker, logger, _1));
+}
+
+int main(int argc, const char *argv[]) {
+    std::string motionsPath;
+    std::vector<std::string> motions;
+    int cycles, intervalUs;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("motion-files,m", po::value<std::string>(&motionsPath)->default_value("../motions/"), "directory with the *.bbmf files")
+        ("cycles,n", po::value<int>(&cycles)->default_value(5000), "cycles to step per motion")
+        ("interval-us", po::value<int>(&intervalUs)->default_value(0), "sleep between two cycles")
+        ("motions", po::value<std::vector<std::string>>(&motions)->multitoken(), "MODULE_IDs of the motions to run")
+        ("help,h", "produce help message.");
+    po::positional_options_description pos;
+    pos.add("motions", -1);
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(desc).positional(pos).run(), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << std::endl << desc << std::endl;
+        return 0;
+    }
+    if (motions.empty()) {
+        motions = {"INTERPOLATE_TO_STAND", "BC_WALK", "SIT"};
+    }
+
+    std::vector<MODULE_ID> ids;
+    for (const auto &name : motions) {
+        const auto id = strToEnum<MODULE_ID>(name);
+        if (!id || *id == NONE || *id == NO_OF_BODY_MODULES) {
+            std::cerr << "Unknown MODULE_ID " << name << std::endl;
+            return 1;
+        }
+        ids.push_back(*id);
+    }
+
+    auto xl = XLogger::quick_init("bodycontrol_benchmark");
+
+    // wire BodyControl like MotionModule does, without a kernel
+    rt::ContextPool context;
+    rt::Metadata meta;
+    rt::Linker link(context, meta);
+    link.name = "Motion";
+    rt::Command<BodyCommand, rt::Handle> cmds;
+    link(cmds);
+
+    auto &settings = context.get<SettingsBlackboard>();
+    settings.motionsPath = motionsPath;
+    BBMF::bbmf_path = settings.motionsPath;
+    MotionFile::motion_path = BBMF::bbmf_path;
+
+    BodyControl bc;
+    bc.connect(link);
+    bc.setup({&settings, &cmds});
+
+    bbapi::BembelIpcSensorMessageT sensorData;
+    bbapi::BembelIpcActuatorMessageT actuatorData;
+    sensorData.connected = true;
+
+    using clock = std::chrono::steady_clock;
+    std::vector<int64_t> all;
+    all.reserve(cycles * (ids.size() + 1));
+
+    auto run = [&](const std::string &name) {
+        std::vector<int64_t> ns;
+        ns.reserve(cycles);
+        for (int i = 0; i < cycles; i++) {
+            if (intervalUs > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(intervalUs));
+            }
+            const auto start = clock::now();
+            bc.step(cmds, &actuatorData, &sensorData);
+            const auto end = clock::now();
+            sensorData.lolaTimestamp++;
+            ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+        all.insert(all.end(), ns.begin(), ns.end());
+        benchmark::printLatency(name, ns, 1000.0);
+    };
+
+    std::cout << "Cycles per motion: " << cycles << ", interval: " << intervalUs << " us" << std::endl;
+    std::cout << std::endl << "Cycle time [us]" << std::endl;
+    benchmark::printLatencyHeader("motion");
+
+    run("NONE");
+    for (size_t i = 0; i < ids.size(); i++) {
+        bc.activateModule(ids[i]);
+        run(motions[i]);
+    }
+    benchmark::printLatency("all", all, 1000.0);
+
+    return 0;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -9,11 +9,15 @@
 #include <framework/util/clock_simulator.h>
 #include <representations/blackboards/settings.h>
 
+#include <array>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <cstdarg>
 #include <algorithm>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <bitset>
 #include <stack>
 #include <ctime>
@@ -36,132 +40,166 @@ using namespace std;
 
 /* timed_mutex mutexed_queue_mutex; */
 
-BodyControl::BodyControl():
-    bodyblackboard(),
-    submodule(NO_OF_BODY_MODULES, NULL),
-    debugname(NO_OF_BODY_MODULES, NULL),
-    sequence(NO_OF_BODY_MODULES, NONE),
-    rank(NO_OF_BODY_MODULES, NONE),
-    active(),
-    motion_stable(false),
-    activeMotion(NONE),
-    nextMotion(NONE)
-{
-     LOG_DEBUG << "init Bodycontrol";
-
-    // check special stances are valid
-    jsassert(!STANDUP_STANCE.isInvalid());
-    jsassert(!SIT_STANCE.isInvalid());
+namespace {
 
+/*======================*/
+/* Registration process */
+/*======================*/
 
-    /*===========================*/
-    /* tmp vector initialization */
-    /*===========================*/
+struct Registration {
+    bool registered = false;
+    const char *name = nullptr;
+    Motion motion = Motion::NONE;
+    topological::Item item;
+};
 
-    vector<SubModule*> init_submodule(NO_OF_BODY_MODULES,NULL);
-    vector<const char*> init_debugname(NO_OF_BODY_MODULES,NULL);
-    vector< vector<MODULE_ID> > init_dependencies(NO_OF_BODY_MODULES, {NONE});
-    vector< tuple<MODULE_ID, int> > init_niceness(NO_OF_BODY_MODULES);
-    vector<MODULE_ID> init_sequence;
-    vector<unsigned int> init_rank;
-    vector<Motion> init_motion_id{NO_OF_BODY_MODULES, Motion::NONE};
+using Registry = std::array<Registration, NO_OF_BODY_MODULES>;
 
-    for (int i = 0; i < NO_OF_BODY_MODULES; i++){
-        init_niceness[i] = make_tuple((MODULE_ID)i, 0); 
+constexpr Registry registerSubmodules() {
+    Registry r{};
+    r[NONE].registered = true;
+    r[NONE].name = "NONE";
+    for (size_t id = 1; id < NO_OF_BODY_MODULES; id++) {
+        r[id].item.depend(NONE);
     }
 
-    init_submodule[0] = NULL;
-    init_debugname[0] = "NONE";
-    init_dependencies[0] = {};
-
-    bool halt_and_catch_fire = false; //!< set if some sanity check failed
-
-    /*======================*/
-    /* Registration process */
-    /*======================*/
-
     // clang-format off
-    #define MODULE(MODULE_ID,ModuleClass, ...) \
-        init_submodule[MODULE_ID] = dynamic_cast<SubModule*>( new ModuleClass(__VA_ARGS__) );\
-        init_debugname[MODULE_ID] =  "Module " #MODULE_ID " " #ModuleClass "(" #__VA_ARGS__")"; \
-        init_motion_id[MODULE_ID] = Motion::NONE;
-    #define MOTION(MODULE_ID, MOTION_ID, ModuleClass, ...) \
-        init_submodule[MODULE_ID] = dynamic_cast<SubModule*>( new ModuleClass(__VA_ARGS__) );\
-        init_debugname[MODULE_ID] =  "Motion " #MODULE_ID " " #ModuleClass "(" #__VA_ARGS__")";\
+    #define MODULE(ID, ModuleClass, ...) \
+        r[ID].registered = true; \
+        r[ID].name = "Module " #ID " " #ModuleClass "(" #__VA_ARGS__ ")";
+    #define MOTION(ID, MOTION_ID, ModuleClass, ...) \
+        r[ID].registered = true; \
+        r[ID].name = "Motion " #ID " " #ModuleClass "(" #__VA_ARGS__ ")"; \
         static_assert(MOTION_ID != Motion::NONE, "Motions can't be have the motion id NONE!"); \
-        init_motion_id[MODULE_ID] = MOTION_ID;
-    #define DEPENDENCY(MODULE_ID, ...)\
-        init_dependencies[MODULE_ID] = {NONE,__VA_ARGS__};
-    #define NICENESS(MODULE_ID, niceness)\
-        init_niceness[MODULE_ID] = make_tuple(MODULE_ID, niceness); 
+        r[ID].motion = MOTION_ID;
+    #define DEPENDENCY(ID, ...) \
+        for (MODULE_ID dependency : {__VA_ARGS__}) { \
+            r[ID].item.depend(dependency); \
+        }
+    #define NICENESS(ID, value) \
+        r[ID].item.niceness = value;
     #define REGISTER_SUBMODULES_NOW
     #include "modules.h"
     #undef REGISTER_SUBMODULES_NOW
     #undef MODULE
+    #undef MOTION
     #undef DEPENDENCY
     #undef NICENESS
     // clang-format on
 
-    // Debug and sanity check
-    for (int i = 1;i < NO_OF_BODY_MODULES; i++){
-        if (init_submodule[i] == NULL){
-            LOG_ERROR << "Submodule #" << i << " is not registered.";
-            halt_and_catch_fire = true;
+    return r;
+}
+
+constexpr Registry REGISTRY = registerSubmodules();
+
+constexpr bool allRegistered() {
+    for (const auto &r : REGISTRY) {
+        if (not r.registered or r.item.overflow) {
+            return false;
         }
     }
-    if (halt_and_catch_fire) hcf;
+    return true;
+}
+static_assert(allRegistered(), "Every MODULE_ID needs a MODULE or MOTION in modules.h, "
+                               "with at most topological::MAX_DEPENDENCIES dependencies.");
+
+constexpr auto sortSubmodules() {
+    std::array<topological::Item, NO_OF_BODY_MODULES> items{};
+    for (size_t id = 0; id < NO_OF_BODY_MODULES; id++) {
+        items[id] = REGISTRY[id].item;
+    }
+    return topological::sort(items);
+}
 
+/*===================================*/
+/* Topological sorting of submodules */
+/*===================================*/
 
-    /*===================================*/
-    /* Topoligical sorting of submodule */
-    /*===================================*/
+constexpr auto ORDER = sortSubmodules();
+static_assert(ORDER.valid(), "Cyclic dependencies between the submodules in modules.h!");
+static_assert(ORDER.sequence[0] == NONE, "Every submodule depends on NONE, so it has to be first.");
 
-    if ( not topological_sort(init_rank, init_sequence, init_niceness, init_dependencies, init_debugname)) {
-        LOG_ERROR << "Topological sort didn't work.";
-        hcf;
+// submodule at position rank of the sequence, without NONE
+constexpr MODULE_ID idAtRank(size_t rank) {
+    return static_cast<MODULE_ID>(ORDER.sequence[rank + 1]);
+}
+
+/*=====================================*/
+/* Instances of the concrete submodules */
+/*=====================================*/
+
+template<MODULE_ID>
+struct Instance;
+
+// clang-format off
+#define MODULE(ID, ModuleClass, ...) \
+    template<> \
+    struct Instance<ID> { \
+        ModuleClass module = ModuleClass(__VA_ARGS__); \
+    };
+#define MOTION(ID, MOTION_ID, ModuleClass, ...) \
+    MODULE(ID, ModuleClass, __VA_ARGS__)
+#define DEPENDENCY(ID, ...)
+#define NICENESS(ID, value)
+#define REGISTER_SUBMODULES_NOW
+#include "modules.h"
+#undef REGISTER_SUBMODULES_NOW
+#undef MODULE
+#undef MOTION
+#undef DEPENDENCY
+#undef NICENESS
+// clang-format on
+
+template<typename Ranks>
+class Pipeline;
+
+template<size_t... RANK>
+class Pipeline<std::index_sequence<RANK...>> {
+public:
+    /*!
+     * Calls f(id, module) for every submodule in execution order, with id
+     * as std::integral_constant and module as its concrete type. Stops as
+     * soon as f returns false.
+     * @return false, if f ended the sequence
+     */
+    template<typename F>
+    bool forEach(F &&f) {
+        return (f(std::integral_constant<MODULE_ID, idAtRank(RANK)>{}, std::get<RANK>(instances).module) && ...);
     }
 
-    /*===============================================================*/
-    /* Building and checking BodyControl members from init_* vectors */
-    /*===============================================================*/
+private:
+    std::tuple<Instance<idAtRank(RANK)>...> instances;
+};
 
+} // namespace
 
-    // Build BodyControl members
-    sequence = init_sequence;
-    submodule = init_submodule;
-    debugname = init_debugname;
-    motion_id = init_motion_id;
-    for(int i = 0; i < NO_OF_BODY_MODULES; i++){
-        rank[i] = (rank_T) (init_rank[i]-1);
-        //DBG << rank[i] << " " << debugname[i];
-    }
+class SubModulePipeline : public Pipeline<std::make_index_sequence<NO_OF_BODY_MODULES - 1>> {};
+
+BodyControl::BodyControl():
+    bodyblackboard(),
+    pipeline(std::make_unique<SubModulePipeline>()),
+    submodule(NO_OF_BODY_MODULES, nullptr),
+    active(),
+    motion_stable(false),
+    activeMotion(NONE),
+    nextMotion(NONE)
+{
+     LOG_DEBUG << "init Bodycontrol";
+
+    // check special stances are valid
+    jsassert(!STANDUP_STANCE.isInvalid());
+    jsassert(!SIT_STANCE.isInvalid());
+
+    pipeline->forEach([this](MODULE_ID id, SubModule &module) {
+        submodule[id] = &module;
+        return true;
+    });
 
     // Debug info
     LOG_INFO << "BodyControl submodule sequence:";
-    for(int i = 1 ; i < NO_OF_BODY_MODULES; i++) {
-        LOG_INFO << " -> " << debugname[sequence[i]];
-    }
-
-    // Sanity checks
-    for (int i = 1; i < NO_OF_BODY_MODULES; i++){
-        if (rank[i] <= 0){
-            LOG_ERROR << "Rank unknown for module #" << i;
-            halt_and_catch_fire = true;
-        }
-        if (submodule[i] == NULL){
-            LOG_ERROR << "No instance for module #" << i;
-            halt_and_catch_fire = true;
-        }
-        if (debugname[i] == NULL){
-            LOG_ERROR << "No name for module #" << i;
-            halt_and_catch_fire = true;
-        }
-        if (sequence[i] == NONE){
-            LOG_ERROR << "Sequence is empty at rank " << i;
-            halt_and_catch_fire = true;
-        }
+    for(size_t i = 1 ; i < NO_OF_BODY_MODULES; i++) {
+        LOG_INFO << " -> " << REGISTRY[ORDER.sequence[i]].name;
     }
-    if (halt_and_catch_fire) hcf;
 
     /* activate all (non-motion) MODULEs  */
     active[0] = false;
@@ -170,11 +208,7 @@ BodyControl::BodyControl():
     }
 }
 
-BodyControl::~BodyControl(){
-    for (auto & module : submodule){
-        delete module;
-    }
-}
+BodyControl::~BodyControl() = default;
 
 void BodyControl::connect(rt::Linker &meta) {
     for (auto module : submodule) {
@@ -228,56 +262,70 @@ BodyState BodyControl::step(rt::Command<BodyCommand, rt::Handle> &commands, bbap
 }
 
 void BodyControl::executeSubmodules(){
-    for (size_t id_counter=1; id_counter<NO_OF_BODY_MODULES; ++id_counter){
-        MODULE_ID id = sequence[id_counter];
-
-        if (active[id]){
-            /* Execution of submodule */
-            SubModuleReturnValue return_value = MOTION_UNSTABLE;
-            return_value = submodule[id]->step(&bodyblackboard);
-            
-             if(!checkAndCorrectActuators(
-                         bodyblackboard.actuators, 
-                         bodyblackboard.sensors)) { 
-                 LOG_ERROR_EVERY_N(100) << "Module (" << enumToStr(id) << "): Actuators out of range."; 
-             } 
-
-            /* react to return value commands */
-            switch (return_value) {                 
-                case MOTION_UNSTABLE:
-                    jsassert(isMotion(id)) << "Submodule " << id << " returned MOTION_UNSTABLE, but is not a motion.";
-                    motion_stable = false;
-                    break;
-
-                case MOTION_STABLE:
-                    jsassert(isMotion(id)) << "Submodule " << id << " returned MOTION_STABLE, but is not a motion.";
-                    motion_stable = true;
-                    break;
-
-                case RUNNING:
-                    jsassert(not isMotion(id)) << "Submodule " << id << " returned RUNNING, but is a motion.";
-                    //pass
-                    break;
-
-                case END_SEQUENCE:
-                    return;
-
-                case HALT_AND_CATCH_FIRE:
-                    hcf;
-                    break;
-
-                case DEACTIVATE_ME:
-                    active[id] = false;
-                    break;
+    const bool completed = pipeline->forEach([this](auto id, auto &module) {
+        if (not active[id]) {
+            return true;
+        }
+
+        /* Execution of submodule, the concrete type is known, so no virtual call */
+        using Module = std::decay_t<decltype(module)>;
+        const SubModuleReturnValue return_value = module.Module::step(&bodyblackboard);
+
+        // debug builds check after every submodule to name the culprit
+        if constexpr (BUILDING_DEBUG) {
+            if (!checkAndCorrectActuators(bodyblackboard.actuators, bodyblackboard.sensors)) {
+                LOG_ERROR_EVERY_N(100) << "Module (" << enumToStr<MODULE_ID>(id) << "): Actuators out of range.";
             }
         }
+
+        return handleReturnValue(id, return_value);
+    });
+
+    if constexpr (BUILDING_RELEASE) {
+        if (!checkAndCorrectActuators(bodyblackboard.actuators, bodyblackboard.sensors)) {
+            LOG_ERROR_EVERY_N(100) << "Actuators out of range.";
+        }
     }
 
+    if (not completed) return;
+
     if (motion_stable) replaceMotionWithNextMotion();
 
     bodyblackboard.activeMotion = idToMotion(activeMotion);
 }
 
+bool BodyControl::handleReturnValue(MODULE_ID id, SubModuleReturnValue return_value) {
+    /* react to return value commands */
+    switch (return_value) {
+        case MOTION_UNSTABLE:
+            jsassert(isMotion(id)) << "Submodule " << id << " returned MOTION_UNSTABLE, but is not a motion.";
+            motion_stable = false;
+            break;
+
+        case MOTION_STABLE:
+            jsassert(isMotion(id)) << "Submodule " << id << " returned MOTION_STABLE, but is not a motion.";
+            motion_stable = true;
+            break;
+
+        case RUNNING:
+            jsassert(not isMotion(id)) << "Submodule " << id << " returned RUNNING, but is a motion.";
+            //pass
+            break;
+
+        case END_SEQUENCE:
+            return false;
+
+        case HALT_AND_CATCH_FIRE:
+            hcf;
+            break;
+
+        case DEACTIVATE_ME:
+            active[id] = false;
+            break;
+    }
+    return true;
+}
+
 void BodyControl::doMotion(DoMotion m) {
     activateModule(motionToId(m.id));
 }
@@ -311,19 +359,23 @@ void BodyControl::replaceMotionWithNextMotion(){
 }
 
 Motion BodyControl::idToMotion(MODULE_ID id) {
-    return motion_id[id];
+    return REGISTRY[id].motion;
 }
 
 MODULE_ID BodyControl::motionToId(Motion m) {
     jsassert(m != Motion::NONE);
     for (size_t i = 0; i < NO_OF_BODY_MODULES; i++) {
-        if (motion_id[i] == m) {
+        if (REGISTRY[i].motion == m) {
             return static_cast<MODULE_ID>(i);
         }
     }
     JS_UNREACHABLE() << "No Motion associated with Motion ID '" << m << "'!";
 }
 
+bool BodyControl::isMotion(MODULE_ID id) {
+    return REGISTRY[id].motion != Motion::NONE;
+}
+
 BodyState BodyControl::bbToState() const {
     // TODO write directly to output
     const BodyBlackboard &bb = bodyblackboard;
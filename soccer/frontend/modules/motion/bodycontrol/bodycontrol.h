@@ -16,6 +16,7 @@
 
 class BodyCommand;
 class SettingsBlackboard;
+class SubModulePipeline;
 
 namespace bbapi {
     class BembelIpcSensorMessageT;
@@ -57,13 +58,9 @@ private:
     const SettingsBlackboard *settings = nullptr;
 
     /* submodule management variables */
-    typedef MODULE_ID rank_T; 
-    std::vector<SubModule*> submodule;
-    std::vector<const char*> debugname;
-    std::vector<MODULE_ID> sequence;
-    std::vector<rank_T> rank;
+    std::unique_ptr<SubModulePipeline> pipeline; //!< all submodules, in execution order
+    std::vector<SubModule*> submodule; //!< indexed by MODULE_ID, pointing into the pipeline
     std::bitset<NO_OF_BODY_MODULES> active;
-    std::vector<Motion> motion_id;
     bool motion_stable;
     MODULE_ID activeMotion;
     MODULE_ID nextMotion;
@@ -73,12 +70,12 @@ private:
     void pushActuatorData();
     void replaceMotionWithNextMotion();
     void executeSubmodules();
+    bool handleReturnValue(MODULE_ID, SubModuleReturnValue); //!< false ends the sequence
     void doMotion(DoMotion);
 
-    Motion idToMotion(MODULE_ID);
-    MODULE_ID motionToId(Motion);
-
-    inline bool isMotion(MODULE_ID id) { return motion_id[id] != Motion::NONE; }
+    static Motion idToMotion(MODULE_ID);
+    static MODULE_ID motionToId(Motion);
+    static bool isMotion(MODULE_ID);
 
     BodyState bbToState() const;
 };
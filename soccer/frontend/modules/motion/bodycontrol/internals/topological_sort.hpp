@@ -1,105 +1,99 @@
-#ifndef __TOPOLOGICAL_SORT
-#define __TOPOLOGICAL_SORT
-
-#include <framework/logger/logger.h>
-
-
-
-#include <cstdarg>
-#include <algorithm>
-#include <tuple>
-#include <bitset>
-#include <stack>
-#include <ctime>
-//#include <unistd.h>
-#include <cstring>
-#include <vector>
-    /*===================================*/
-    /* Topoligical sorting of subitem */
-    /*===================================*/
-
-using namespace std;
-template <typename ID_T>
-bool topological_sort(
-        vector<unsigned int> & rank,
-        vector<ID_T> & sequence,
-        vector<tuple<ID_T, int> > & niceness,
-        vector<vector<ID_T> > & dependencies,
-        vector<const char *> & debugname
-){
-    /* Parameter Sanity Checks */
-    size_t no_of_items = niceness.size();
-    if (no_of_items == 0) {
-        LOG_ERROR << "No items to sort in niceness.";
-        return false;
-    }
-    if (!rank.empty()){
-        LOG_ERROR << "Parameter rank is not empty.";
-        return false;
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace topological {
+
+// items depend on at most this many other items
+constexpr size_t MAX_DEPENDENCIES = 8;
+
+struct Item {
+    int niceness = 0;
+    size_t dependency[MAX_DEPENDENCIES]{};
+    size_t no_of_dependencies = 0;
+    bool overflow = false; //!< more dependencies than MAX_DEPENDENCIES
+
+    constexpr void depend(size_t other) {
+        if (no_of_dependencies == MAX_DEPENDENCIES) {
+            overflow = true;
+            return;
+        }
+        dependency[no_of_dependencies++] = other;
     }
-    if (!sequence.empty()){
-        LOG_ERROR << "Parameter sequence is not empty.";
-        return false;
+};
+
+template<size_t N>
+struct Order {
+    std::array<size_t, N> sequence{}; //!< sequence[rank] = item
+    std::array<size_t, N> rank{};     //!< rank[item] = position in sequence
+    size_t no_of_ranked = 0;
+    bool cyclic = false;
+    size_t cycle_at = 0; //!< an item on the cycle, if cyclic
+
+    constexpr bool valid() const { return not cyclic and no_of_ranked == N; }
+};
+
+namespace detail {
+
+enum Mark { UNDISCOVERED, DISCOVERED, RANKED };
+
+template<size_t N>
+constexpr bool visit(const std::array<Item, N> &items, std::array<Mark, N> &mark, Order<N> &order, size_t item) {
+    if (mark[item] == RANKED) {
+        return true;
     }
-    if (dependencies.size() != no_of_items){
-        LOG_ERROR << "Wrong number of dependencies.";
+    if (mark[item] == DISCOVERED) {
+        order.cyclic = true;
+        order.cycle_at = item;
         return false;
     }
-    if (debugname.size() != no_of_items){
-        LOG_ERROR << "Wrong number of debugnames.";
-        return false;
+    mark[item] = DISCOVERED;
+    // last dependency first, like the stack based DFS this replaces
+    for (size_t d = items[item].no_of_dependencies; d > 0; d--) {
+        if (not visit(items, mark, order, items[item].dependency[d - 1])) {
+            return false;
+        }
     }
+    mark[item] = RANKED;
+    order.rank[item] = order.no_of_ranked;
+    order.sequence[order.no_of_ranked++] = item;
+    return true;
+}
 
+} // namespace detail
 
-    rank = vector<unsigned int>(no_of_items,0);
-    vector<bool> discovered_items(no_of_items,false);
-    int current_rank = 0;
-
-    // Sort items by niceness
-    stable_sort(niceness.begin(), niceness.end(),
-            []( const tuple<ID_T, int>& a,
-                const tuple<ID_T, int>& b
-            ) -> bool
-            {  return get<1>(a) < get<1>(b); }
-        );
+/**
+ * Sort items so every item comes after its dependencies, apart from that
+ * by niceness (lower first). Items of equal niceness keep their order.
+ *
+ * Meant to run at compile time, check the result with a static_assert on
+ * Order::valid().
+ */
+template<size_t N>
+constexpr Order<N> sort(const std::array<Item, N> &items) {
+    Order<N> order;
 
-    // DFS to sort topologically
-    for (auto ncs : niceness){
-        vector<ID_T> topo_stack({get<0>(ncs)});
-        while (not topo_stack.empty() ){
-            ID_T item = topo_stack.back();
-            if ( not discovered_items[item] ){
-                discovered_items[item] = true;
-                for (auto item_dependency : dependencies[item]){
-                    topo_stack.push_back(item_dependency);
-                }
-            } else {
-                if ( not rank[item] ) {
-                    for (auto item_dependency : dependencies[item]){
-                        if (rank[item_dependency] == 0){
-                            LOG_ERROR << "Cyclic dependencies!";
-                            LOG_ERROR << debugname[item] << " depends on " << debugname[item_dependency] << " which has no rank yet!";
-                            LOG_ERROR << "Dumping Stack:";
-                            for (auto item : topo_stack){
-                                LOG_ERROR << "topo_stack>   " << debugname[item];
-                            }
-                            return false;
-                        }
-                    }
-                    sequence.push_back(item);
-                    rank[item] = ++current_rank;
-                }
-                topo_stack.pop_back();
-            }
+    // stable insertion sort by niceness
+    std::array<size_t, N> by_niceness{};
+    for (size_t i = 0; i < N; i++) {
+        size_t j = i;
+        for (; j > 0 and items[by_niceness[j - 1]].niceness > items[i].niceness; j--) {
+            by_niceness[j] = by_niceness[j - 1];
         }
+        by_niceness[j] = i;
     }
 
-    // Sanity check
-    if (size_t(current_rank) != no_of_items){
-        LOG_ERROR << "Not all items were ranked";
-        return false;
+    // DFS to sort topologically
+    std::array<detail::Mark, N> mark{};
+    for (size_t i = 0; i < N; i++) {
+        if (not detail::visit(items, mark, order, by_niceness[i])) {
+            break;
+        }
     }
-    return true;
+    return order;
 }
 
-#endif // __TOPOLOGICAL_SORT
+} // namespace topological
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -5,6 +5,8 @@
  * To register a new motion search for the TODO comments.
  *
  * If you need to know how this file works, look into bodycontrol.cpp
+ * The execution order is sorted at compile time, a submodule that is not
+ * registered or a cyclic DEPENDENCY fails the build.
  */
 
 // clang-format off
@@ -3,7 +3,7 @@
 #include <bodycontrol/internals/submodule.h>
 
 class ResetBodyQuestions : public SubModule {
-    
+public:
     SubModuleReturnValue step(BodyBlackboard *bb) override {
         bb->prevQns = bb->qns;
         bb->qns.reset();
@@ -21,6 +21,7 @@ void MotionModule::connect(rt::Linker &link) {
     link.name = "Motion";
     link(settings);
     link(body_state);
+    link(cam_poses);
     link(cmds);
     bc = std::make_shared<BodyControl>();
     bc->connect(link);
@@ -37,8 +38,7 @@ void MotionModule::tick(NaoState &state) {
     auto bc_state = bc->step(cmds, state.actuatorData, state.sensorData);
     interface.update(bc_state);
     body_state.emit(bc_state);
-    state.tCamPose = bc_state.tCamPose;
-    state.bCamPose = bc_state.bCamPose;
+    cam_poses->push(state.lola_timestamp, bc_state.tCamPose, bc_state.bCamPose);
 
     LOG_DEBUG_EVERY_N(84 * 10) << "Nao thread alive"; 
 }
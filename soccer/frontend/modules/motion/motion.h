@@ -3,6 +3,7 @@
 #include <representations/motion/body_commands.h>
 #include <representations/blackboards/settings.h>
 #include <representations/motion/body_state.h>
+#include <representations/camera/cam_pose_history.h>
 #include <representations/bembelbots/feature_flags.h>
 #include "../nao/naostate.h"
 #include "bodycontrol/blackboards/body_interface.h"
@@ -20,6 +21,7 @@ private:
 
     rt::Context<SettingsBlackboard> settings;
     rt::Output<BodyState, rt::Event> body_state;
+    rt::Context<CamPoseHistory, rt::Write> cam_poses;
     rt::Command<BodyCommand, rt::Handle> cmds;
 
     BodyInterface interface;
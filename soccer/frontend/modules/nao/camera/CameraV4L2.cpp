@@ -165,10 +165,25 @@ void CameraV4L2::init() {
     setParameter(V4L2_CID_FOCUS_AUTO, 1);  // enable auto focus
 }
 
-void CameraV4L2::start() {
+void CameraV4L2::useUserBuffers(std::vector<std::uint8_t *> buffers) {
+    if (running) {
+        throw std::runtime_error(device + ": can't change buffers of a running stream");
+    }
+    userBuffers = std::move(buffers);
+    ringBufferSize = userBuffers.size();
+}
+
+std::uint32_t CameraV4L2::memoryType() const {
+    return userBuffers.empty() ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+}
+
+void CameraV4L2::start(const std::function<void()> &queueBuffers) {
     if (running)
         return;
     initMmapStreaming();
+    if (!userBuffers.empty() && queueBuffers) {
+        queueBuffers();
+    }
     enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     ioctlf(fd, VIDIOC_STREAMON, &type);
     running = true;
@@ -190,8 +205,14 @@ bool CameraV4L2::isRunning() const {
 int64_t CameraV4L2::getImage(uint8_t* buffer) {
     //EASY_FUNCTION();
 
+    Frame frame = dequeue();
+    std::memcpy(buffer, frame.data, bufferSize());
+    requeue(frame.index);
+    return frame.timestamp;
+}
+
+CameraV4L2::Frame CameraV4L2::dequeue() {
     v4l2_buffer v4l2_buffer = lockKernelBuffer();
-    std::memcpy(buffer, v4l2Buffers[v4l2_buffer.index].first, bufferSize());
     int64_t timestamp = v4l2_buffer.timestamp.tv_sec * 1'000'000ll + v4l2_buffer.timestamp.tv_usec;
 #if 0
 	// we don't care about realtime timestamps
@@ -199,8 +220,22 @@ int64_t CameraV4L2::getImage(uint8_t* buffer) {
         std::cerr << "Cam not using real time! (Or bios battery empty)" << std::endl;
     }
 #endif
-    ioctlf(fd, VIDIOC_QBUF, &v4l2_buffer);
-    return timestamp;
+    auto *data = userBuffers.empty() ? static_cast<std::uint8_t *>(v4l2Buffers[v4l2_buffer.index].first)
+                                     : userBuffers[v4l2_buffer.index];
+    return {v4l2_buffer.index, data, timestamp};
+}
+
+void CameraV4L2::requeue(std::uint32_t index) {
+    struct v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = memoryType();
+    buf.index = index;
+    if (!userBuffers.empty()) {
+        buf.m.userptr = reinterpret_cast<unsigned long>(userBuffers.at(index));
+        buf.length = bufferSize();
+    }
+    ioctlf(fd, VIDIOC_QBUF, &buf);
 }
 
 void CameraV4L2::updateDeviceResolution() {
@@ -233,7 +268,7 @@ void CameraV4L2::initMmapStreaming() {
     std::memset(&req, 0, sizeof(req));
     req.count = ringBufferSize;
     req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory = V4L2_MEMORY_MMAP;
+    req.memory = memoryType();
     ioctlf(fd, VIDIOC_REQBUFS, &req);
     if (req.count != ringBufferSize) {
         throw std::runtime_error(device +
@@ -242,6 +277,11 @@ void CameraV4L2::initMmapStreaming() {
                                  "ring buffer.");
     }
 
+    // user buffers are queued by the owner, see start()
+    if (!userBuffers.empty()) {
+        return;
+    }
+
     // Get pointer and size of each one
     for (std::uint32_t i = 0; i < ringBufferSize; ++i) {
         struct v4l2_buffer buf;
@@ -281,7 +321,7 @@ void CameraV4L2::unInitMmapStreaming() {
     std::memset(&req, 0, sizeof(req));
     req.count = 0;
     req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory = V4L2_MEMORY_MMAP;
+    req.memory = memoryType();
     ioctlf(fd, VIDIOC_REQBUFS, &req);
     if (req.count != 0) {
         throw std::runtime_error(device + ": Can't remove all previously allocated buffer.");
@@ -293,7 +333,7 @@ v4l2_buffer CameraV4L2::lockKernelBuffer() {
     std::memset(&buffer, 0, sizeof(struct v4l2_buffer));
     buffer.index = 0;
     buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buffer.memory = V4L2_MEMORY_MMAP;
+    buffer.memory = memoryType();
     //! 1. First try to DQBUF a buffer if any.
     int result = ::ioctl(fd, VIDIOC_DQBUF, &buffer);
     if (-1 == result && EAGAIN == errno) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,11 @@ public:
     //! @return true if device file is open, false otherwise.
     bool isOpen() const;
 
+    //! @brief File descriptor of the device, readable (poll/epoll) when a filled buffer can be dequeued.
+    std::int32_t fileDescriptor() const noexcept {
+        return fd;
+    }
+
     //! @brief Gets the expected size of an Image.
     //! @return the size of an image in byte.
     inline std::uint32_t bufferSize() const noexcept {
@@ -73,8 +79,14 @@ public:
     //! @brief Initializes the Camera.
     void init();
 
+    //! @brief Capture into the given buffers instead of mmapped kernel buffers (V4L2_MEMORY_USERPTR).
+    //! @param[in] buffers bufferSize() bytes each, page aligned, must outlive the stream.
+    //! Must be called before start().
+    void useUserBuffers(std::vector<std::uint8_t *> buffers);
+
     //! @brief Starts the Camera stream.
-    void start();
+    //! @param[in] queueBuffers Only with user buffers: called before STREAMON to queue them with requeue().
+    void start(const std::function<void()> &queueBuffers = {});
 
     //! @brief Stops the Camera stream.
     void stop();
@@ -87,6 +99,19 @@ public:
     //! @return Timestamp of the image.
     int64_t getImage(uint8_t *buffer);
 
+    //! @brief A filled buffer, owned by the caller until it is requeued.
+    struct Frame {
+        std::uint32_t index;
+        std::uint8_t *data;
+        int64_t timestamp;
+    };
+
+    //! @brief Waits for the next filled buffer.
+    Frame dequeue();
+
+    //! @brief Hands buffer index back to the driver.
+    void requeue(std::uint32_t index);
+
     //! @brief Name of the device file.
     const std::string device;
 
@@ -114,6 +139,12 @@ protected:
     //! @brief Stores the list of mmap V4L2 kernel buffer.
     std::vector<std::pair<void *, std::uint32_t>> v4l2Buffers;
 
+    //! @brief Buffers set by useUserBuffers(), empty for mmap streaming.
+    std::vector<std::uint8_t *> userBuffers;
+
+    //! @brief V4L2_MEMORY_MMAP or V4L2_MEMORY_USERPTR.
+    std::uint32_t memoryType() const;
+
     //! @brief Stores if stream is running.
     bool running = false;
 
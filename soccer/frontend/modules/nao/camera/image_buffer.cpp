@@ -20,10 +20,11 @@ void ImageBuffer::initialize(const size_t &size, const int &cam, bool sim) {
     camName = (cam == TOP_CAMERA) ? "top" : "bottom";
     simulator = sim;
     data.resize(size);
+    queued.assign(size, false);
     for (size_t i{0}; i < size; ++i) {
-        // create new CamImage with aligned memory
+        // create new CamImage with page aligned memory, so the driver can use it as user buffer
         uint8_t *p;
-        int ret = posix_memalign(reinterpret_cast<void **>(&p), 16, imgSize);
+        int ret = posix_memalign(reinterpret_cast<void **>(&p), 4096, imgSize);
         assert(ret == 0); // if posix_memalign fails, all hell will break loose, so just give up
         data[i] = std::move(CamImage(camera::w, camera::h, cam));
         data[i].setData(p);
@@ -40,13 +41,14 @@ void ImageBuffer::deinit() {
         i.data = nullptr;
     }
     data.clear();
+    queued.clear();
 }
 
 ImageBuffer::~ImageBuffer() {
     deinit();
 }
 
-CamImage &ImageBuffer::getImage() {
+CamImage &ImageBuffer::getImage(ImgLock lt) {
     uint32_t c{0}, limit{100};
     
     // basically sleep forever in simulator mode
@@ -56,8 +58,22 @@ CamImage &ImageBuffer::getImage() {
     while (lastImg == curImg && (++c < limit))
         sleep_for(1ms);
     LOG_ERROR_IF(c == limit) << __PRETTY_FUNCTION__ << ": failed to grab new " << camName << " image";
-    lastImg = curImg.load();
-    return data[curImg];
+
+    // recycle() skips locked images, but only still published ones are safe to
+    // lock: if a newer image replaced it meanwhile, try again with that one
+    uint32_t img;
+    for (;;) {
+        img = curImg.load();
+        const bool locked = data[img].lock(lt);
+        if (img == curImg.load()) {
+            break;
+        }
+        if (locked) {
+            data[img].unlock(lt);
+        }
+    }
+    lastImg = img;
+    return data[img];
 }
 
 CamImage &ImageBuffer::getCaptureBuffer() {
@@ -81,13 +97,50 @@ CamImage &ImageBuffer::getCaptureBuffer() {
     return data[i];
 }
 
+CamImage &ImageBuffer::getCaptureBuffer(uint32_t index) {
+    if (index >= data.size()) {
+        throw std::runtime_error("Driver filled an unknown image!");
+    }
+    if (data[index].isLocked()) {
+        // the driver gave it back, so it is ours again, recycle() requeues it once unlocked
+        queued[index] = false;
+        debug();
+        throw std::runtime_error("Driver filled an image, that is in use!");
+    }
+
+    queued[index] = false;
+    capture = index;
+    data[index].lock(ImgLock::CAPTURE);
+    return data[index];
+}
+
 void ImageBuffer::releaseCaptureBuffer() {
     auto &img = data[capture];
     assert(img.hasLock(ImgLock::CAPTURE)); // getCaptureBuffer() has not been called first
+    prevImg = curImg.load();
     curImg = capture.load();
     img.unlock(ImgLock::CAPTURE);
 }
 
+void ImageBuffer::cancelCapture() {
+    if (!data.empty() && data[capture].hasLock(ImgLock::CAPTURE)) {
+        data[capture].unlock(ImgLock::CAPTURE);
+    }
+}
+
+std::vector<uint8_t *> ImageBuffer::buffers() const {
+    std::vector<uint8_t *> result;
+    result.reserve(data.size());
+    for (const CamImage &i : data) {
+        result.push_back(i.data);
+    }
+    return result;
+}
+
+void ImageBuffer::resetQueued() {
+    queued.assign(data.size(), false);
+}
+
 void ImageBuffer::debug() {
     LOG_DEBUG << "=======================";
     LOG_DEBUG << "ImageBuffer debug " << camName;
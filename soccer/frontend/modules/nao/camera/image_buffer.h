@@ -25,8 +25,13 @@ public:
     void initialize(const size_t &size, const int &cam, bool sim = false);
     void deinit();
 
-    /// returns most recent image
-    CamImage &getImage();
+    /**
+     * returns most recent image, locked with lt
+     *
+     * The lock is taken before the image is handed out, so it can't be given
+     * back to the driver in between. Release it with unlock(lt) when done.
+     */
+    CamImage &getImage(ImgLock lt);
 
     /**
      * @return reference to a locked CamImage from the ringbuffer,
@@ -42,6 +47,44 @@ public:
      */
     void releaseCaptureBuffer();
 
+    /// unlocks the capture buffer after a failed capture, without publishing it
+    void cancelCapture();
+
+    /*
+     * Zero copy capture: the camera driver writes straight into the images of
+     * this buffer. Each image is either queued in the driver or owned by us, an
+     * owned image goes back to the driver once it is unlocked and has been
+     * replaced as the most recent image by two newer ones.
+     */
+
+    /// data pointers of all images, page aligned, valid until deinit()
+    std::vector<uint8_t *> buffers() const;
+
+    /// no image is queued in the driver anymore, i.e. the stream was (re)started
+    void resetQueued();
+
+    /**
+     * hands every image back to the driver, that is owned by us but no longer used
+     * @param requeue called with the index of each returned image
+     */
+    template<typename F>
+    void recycle(F &&requeue) {
+        for (uint32_t i{0}; i < data.size(); ++i) {
+            if (queued[i] || i == curImg || i == prevImg || data[i].isLocked()) {
+                continue;
+            }
+            requeue(i);
+            queued[i] = true;
+        }
+    }
+
+    /**
+     * @return reference to the locked CamImage at index, that the driver has just filled
+     * throws, if the image is in use. It is not queued anymore then, recycle()
+     * hands it back to the driver once it is unlocked.
+     */
+    CamImage &getCaptureBuffer(uint32_t index);
+
     /**
      * print debug info
      */
@@ -53,9 +96,13 @@ private:
     std::string_view camName;
     bool simulator{false};
     std::vector<CamImage> data;
+    // zero copy capture: images owned by the driver
+    std::vector<bool> queued;
 
     // store most recent new and freed image pointer for increased performance
     std::atomic<uint32_t> curImg{0}, lastImg{1}, capture{0};
+    // image published before curImg, consumers may still be about to lock it
+    std::atomic<uint32_t> prevImg{1};
 };
 
 // vim: set ts=4 sw=4 sts=4 expandtab:
@@ -14,7 +14,7 @@ bool NaoCameras::initialized() const {
     return top && bottom;
 }
 
-void NaoCameras::openCamera(const int &cam, std::string simulatorHost, bool docker) {
+void NaoCameras::openCamera(const int &cam, std::string simulatorHost, bool docker, ImageBuffer *buffer) {
     std::string camName = (cam == TOP_CAMERA) ? "top" : "bottom";
     LOG_INFO << "Opening " << camName << " camera";
     std::unique_ptr<JsVideoSource> camPtr;
@@ -26,6 +26,9 @@ void NaoCameras::openCamera(const int &cam, std::string simulatorHost, bool dock
         LOG_WARN << "using TCP camera source.";
     }
 
+    if (buffer && !camPtr->attach(*buffer)) {
+        LOG_ERROR << camName << " camera can't capture zero copy";
+    }
     camPtr->startCapturing();
 
     if(cam == TOP_CAMERA) {
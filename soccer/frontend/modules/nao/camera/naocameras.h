@@ -2,13 +2,17 @@
 #include <memory>
 #include "sources/jsvideosource.h"
 
+class ImageBuffer;
+
 struct NaoCameras {
     std::unique_ptr<JsVideoSource> top;
     std::unique_ptr<JsVideoSource> bottom;
 
     explicit NaoCameras(bool simulator);
 
-    void openCamera(const int &cam, std::string simulatorHost = "", bool docker = false);
+    // if buffer is given and the source supports it, the camera captures zero copy into buffer
+    void openCamera(const int &cam, std::string simulatorHost = "", bool docker = false,
+                    ImageBuffer *buffer = nullptr);
     bool initialized() const;
 private:
     bool simulator{false};
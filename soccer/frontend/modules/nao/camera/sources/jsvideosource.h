@@ -15,12 +15,15 @@
 // defines see jsvisionvars.h
 #include <vector>
 #include <array>
+#include <stdexcept>
 #include <boost/shared_ptr.hpp>
 #include "../cameradef.h"
 #include <framework/image/camimage.h>
 
 using namespace CameraDefinitions;
 
+class ImageBuffer;
+
 /** inits reference to parent broker, to be called from jrlsoccer::preload, otherwise naodebug does not work
  * in principal inits static logger
  * @param parentProxy Sets naoqi parent broker
@@ -39,6 +42,31 @@ public:
      */
     virtual void fetchImage(CamImage &dst) = 0;
 
+    /**
+     * zero copy capture: the camera writes straight into the images of buffer,
+     * which must outlive the source. Has to be called before startCapturing().
+     * @return false, if the source can only copy into fetchImage(CamImage &)
+     */
+    virtual bool attach(ImageBuffer & /*buffer*/) {
+        return false;
+    }
+
+    /**
+     * zero copy capture: wait for the next image of the attached buffer
+     * @return the new image, locked for capture, see ImageBuffer::getCaptureBuffer(uint32_t)
+     */
+    virtual CamImage &fetchAttachedImage() {
+        throw std::logic_error("video source does not support zero copy capture");
+    }
+
+    /**
+     * @return file descriptor, that becomes readable (poll/epoll) when the next image
+     * can be fetched without blocking, -1 if the source can't be polled
+     */
+    virtual int fileDescriptor() const {
+        return -1;
+    }
+
     /**
      * start capturing
      * @return false on error
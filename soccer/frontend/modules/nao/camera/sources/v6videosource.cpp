@@ -14,6 +14,7 @@
 #include <framework/util/clock.h>
 
 #include "../CameraV4L2.hpp"
+#include "../image_buffer.h"
 
 namespace fs = std::filesystem;
 using namespace std::chrono_literals;
@@ -94,18 +95,65 @@ void V6VideoSource::fetchImage(CamImage &dst) {
         }
     }
 
-    if (dst.timestamp < 1) {
-        dst.timestamp = getSystemTimestamp();
-        // first few frames are usually missing timestamps, so silently ignore errors if framework is running for less than 5s
-        LOG_ERROR_IF(getTimestampMs() > 5000) << "Camera timestamp was 0! Using current timestamp instead.";
+    checkTimestamp(dst);
+}
+
+bool V6VideoSource::attach(ImageBuffer &buffer) {
+    cam->useUserBuffers(buffer.buffers());
+    attached = &buffer;
+    return true;
+}
+
+CamImage &V6VideoSource::fetchAttachedImage() {
+    static constexpr int MAX_TRIES{3};
+    int errCount{0};
+
+    // images released by vision since the last call
+    requeueUnused();
+
+    for (;;) {
+        try {
+            CameraV4L2::Frame frame = cam->dequeue();
+            CamImage &dst = attached->getCaptureBuffer(frame.index);
+            dst.camera = getCamera();
+            dst.timestamp = frame.timestamp;
+            checkTimestamp(dst);
+            return dst;
+        } catch (std::exception &e) {
+            LOG_ERROR << __PRETTY_FUNCTION__ << " - failed to fetch image: " << e.what();
+            if (errCount++ > MAX_TRIES)
+                throw;
+        }
     }
 }
 
+int V6VideoSource::fileDescriptor() const {
+    return cam->fileDescriptor();
+}
+
 bool V6VideoSource::startCapturing() {
-    cam->start();
+    if (attached) {
+        // stopping the stream took all buffers back from the driver
+        attached->resetQueued();
+        cam->start([this]() { requeueUnused(); });
+    } else {
+        cam->start();
+    }
     return true;
 }
 
+void V6VideoSource::requeueUnused() {
+    attached->recycle([this](uint32_t index) { cam->requeue(index); });
+}
+
+void V6VideoSource::checkTimestamp(CamImage &img) {
+    if (img.timestamp < 1) {
+        img.timestamp = getSystemTimestamp();
+        // first few frames are usually missing timestamps, so silently ignore errors if framework is running for less than 5s
+        LOG_ERROR_IF(getTimestampMs() > 5000) << "Camera timestamp was 0! Using current timestamp instead.";
+    }
+}
+
 
 int V6VideoSource::getCamera() const {
     return !isTopCam;
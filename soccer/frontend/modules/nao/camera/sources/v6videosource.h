@@ -14,6 +14,9 @@ public:
 
     virtual ~V6VideoSource();
     virtual void fetchImage(CamImage &dst) override;
+    virtual bool attach(ImageBuffer &buffer) override;
+    virtual CamImage &fetchAttachedImage() override;
+    virtual int fileDescriptor() const override;
     virtual bool startCapturing() override;
     virtual int getParameter(CameraOption option) override;
     virtual void setParameter(CameraOption option, int value) override;
@@ -24,10 +27,13 @@ public:
 
 private:
     CameraV4L2 *cam;
+    ImageBuffer *attached{nullptr};
     bool isTopCam;
     std::unordered_map<CameraDefinitions::CameraOption, CameraParameter> param;
 
     bool checkOpt(CameraOption option);
+    void requeueUnused();
+    void checkTimestamp(CamImage &img);
 };
 
 // vim: set ts=4 sw=4 sts=4 expandtab:
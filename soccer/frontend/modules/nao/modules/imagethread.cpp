@@ -6,12 +6,25 @@
 #include "../camera/cameraconfig.h"
 #include <framework/util/clock.h>
 #include <representations/blackboards/camera_calibration.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <stdexcept>
 #include <thread>
+#include <sys/epoll.h>
+#include <unistd.h>
 
 using namespace std::chrono_literals;
 using std::this_thread::sleep_for;
 
+namespace {
+// images per camera, when they are copied out of the driver (simulator)
+constexpr size_t COPY_BUFFERS{150};
+// images per camera with zero copy capture, each one is a driver buffer:
+// 4 queued in the driver, the capture, the two newest and the one vision works on
+constexpr size_t ZERO_COPY_BUFFERS{8};
+} // namespace
+
 void ImageThread::setCamPose(CamImage &img, CamPose &cp) {
     CameraCalibrationBlackboard *cal;
 
@@ -33,7 +46,7 @@ void ImageThread::setCamPose(CamImage &img, CamPose &cp) {
 void ImageThread::connect(rt::Linker &link) {
     link.name = "ImageThread";
     link(settings);
-    link(nao_states);
+    link(cam_poses);
     link(game_state);
     link(nao_info);
     link(image_provider);
@@ -49,8 +62,10 @@ void ImageThread::setup() {
     bottomCameraCalibration = std::make_unique<CameraCalibrationBlackboard>(name, "cameraCalibrationBottom");
     cameraParameters = std::make_unique<CameraParametersBlackboard>();
 
-    image_provider->top.initialize(150, TOP_CAMERA, settings->simulator);
-    image_provider->bottom.initialize(150, BOTTOM_CAMERA, settings->simulator);
+    zeroCopy = !settings->simulator;
+    const size_t buffers = zeroCopy ? ZERO_COPY_BUFFERS : COPY_BUFFERS;
+    image_provider->top.initialize(buffers, TOP_CAMERA, settings->simulator);
+    image_provider->bottom.initialize(buffers, BOTTOM_CAMERA, settings->simulator);
 
     CameraConfig::setCameras([=](){
         return cameras.get();
@@ -104,9 +119,6 @@ void ImageThread::process() {
     auto _ = std::async(&ImageThread::checkCameraParameters, this, false);
 
     // fetch images
-    CamImage &tImg = image_provider->top.getCaptureBuffer();
-    CamImage &bImg = image_provider->bottom.getCaptureBuffer();
-
     bool has_image = false;
     int reset_counter = 0;
 
@@ -115,10 +127,18 @@ void ImageThread::process() {
             throw std::runtime_error("Camera reset failed after too many tries");
         }
         try {
-            cameras->top->fetchImage(tImg); 
-            cameras->bottom->fetchImage(bImg);
+            if (epollFd >= 0) {
+                captureEvents();
+            } else {
+                CamImage &tImg = fetchImage(*cameras->top, image_provider->top);
+                CamImage &bImg = fetchImage(*cameras->bottom, image_provider->bottom);
+                publish(tImg, image_provider->top);
+                publish(bImg, image_provider->bottom);
+            }
             has_image = true;
         } catch (...) {
+            image_provider->top.cancelCapture();
+            image_provider->bottom.cancelCapture();
             resetCameras();
             sleep_for(1s);
             initCameras();
@@ -127,58 +147,7 @@ void ImageThread::process() {
         reset_counter++;
     }
 
-    // no body states available, wait for next one
-    if (bs_dq.empty())
-        nao_states.waitWhileEmpty();
-
-    // append bodystates
-    for (auto &s : nao_states.fetch()) {
-        bs_dq.emplace_back(std::move(s));
-    }
-
-    NaoState topState, bottomState;
-    topState.lola_timestamp = bottomState.lola_timestamp = INT64_MIN; // ensure any state will be better than this
-    int64_t tdiff{INT64_MAX}, bdiff{INT64_MAX};
-
-    // find best body state matches
-    for (auto &i : bs_dq) {
-        auto d = std::abs(tImg.timestamp - i.lola_timestamp);
-        if (d < tdiff) {
-            tdiff = d;
-            topState = i;
-        }
-
-        d = std::abs(bImg.timestamp - i.lola_timestamp);
-        if (d < bdiff) {
-            bdiff = d;
-            bottomState = i;
-        }
-    }
-
-    // store images in ringbuffer
-    setCamPose(tImg, topState.tCamPose);
-    image_provider->top.releaseCaptureBuffer();
-    setCamPose(bImg, bottomState.bCamPose);
-    image_provider->bottom.releaseCaptureBuffer();
-
-    bbapi::CamPoseMessageT cpm;
-    cpm.top = topState.tCamPose;
-    cpm.bottom = bottomState.bCamPose;
-    camPose.emit(cpm);
-
-    // prune queue
-    while (bs_dq.front().lola_timestamp < std::min(topState.lola_timestamp, bottomState.lola_timestamp))
-        bs_dq.pop_front();
-
-    // print error if timestamps for BodyState and image are more that one LoLa cycle out of sync
-    if (getTimestampMs() > 5000) { 
-        constexpr auto limit{1.5f * CONST::lola_cycle_ms * 1000};
-        LOG_ERROR_IF(std::abs(tImg.timestamp - topState.lola_timestamp) > limit)
-                << "ImageProvider: BodyState for top camera out of sync!";
-        LOG_ERROR_IF(std::abs(bImg.timestamp - bottomState.lola_timestamp) > limit)
-                << "ImageProvider: BodyState for bottom camera out of sync!";
-    }
-
+    camPose.emit(camPoses);
 
     // TODO: GIANT HACK, PLEASE FIX
     static int realTopBrightness = -1;
@@ -204,6 +173,57 @@ void ImageThread::process() {
     }
 }
 
+void ImageThread::captureEvents() {
+    constexpr int timeoutMs{1000};
+    bool captured[2]{false, false};
+
+    // publish every image as soon as the driver has it, until both cameras delivered one
+    while (!captured[TOP_CAMERA] || !captured[BOTTOM_CAMERA]) {
+        std::array<epoll_event, 2> events;
+        const int n = epoll_wait(epollFd, events.data(), events.size(), timeoutMs);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            throw std::runtime_error(std::string("ImageThread: epoll_wait failed: ") + std::strerror(errno));
+        }
+        if (n == 0) {
+            throw std::runtime_error("ImageThread: no image from " +
+                                     std::string(captured[TOP_CAMERA] ? "bottom" : "top") + " camera within 1s");
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const auto cam = static_cast<int>(events[i].data.u32);
+            auto &src = (cam == TOP_CAMERA) ? *cameras->top : *cameras->bottom;
+            auto &buffer = (cam == TOP_CAMERA) ? image_provider->top : image_provider->bottom;
+            publish(fetchImage(src, buffer), buffer);
+            captured[cam] = true;
+        }
+    }
+}
+
+void ImageThread::publish(CamImage &img, ImageBuffer &buffer) {
+    // no body states available yet, wait for motion
+    CamPoseHistory::Sample poses;
+    while (!cam_poses->lookup(img.timestamp, poses)) {
+        sleep_for(std::chrono::milliseconds(CONST::lola_cycle_ms));
+    }
+
+    // store image in ringbuffer
+    const bool top = (img.camera == TOP_CAMERA);
+    CamPose &cp = top ? poses.top : poses.bottom;
+    setCamPose(img, cp);
+    buffer.releaseCaptureBuffer();
+    (top ? camPoses.top : camPoses.bottom) = cp;
+
+    // print error if the image is more than one LoLa cycle outside of the pose history
+    if (getTimestampMs() > 5000) {
+        constexpr auto limit{1.5f * CONST::lola_cycle_ms * 1000};
+        LOG_ERROR_IF(std::abs(img.timestamp - poses.timestamp) > limit)
+                << "ImageProvider: BodyState for " << (top ? "top" : "bottom") << " camera out of sync!";
+    }
+}
+
 void ImageThread::onSetPitchOffset(SetPitchOffset& data) {
     jsassert(data.camera == TOP_CAMERA || data.camera == BOTTOM_CAMERA);
 
@@ -215,14 +235,62 @@ void ImageThread::onSetPitchOffset(SetPitchOffset& data) {
 }
 
 void ImageThread::stop() {
+    // with zero copy the drivers write into the image buffers, stop them first
+    cameras = std::make_shared<NaoCameras>(settings->simulator);
+    watchCameras();
     LOG_INFO << "image thread stopped";
 }
 
+CamImage &ImageThread::fetchImage(JsVideoSource &src, ImageBuffer &buffer) {
+    if (zeroCopy) {
+        return src.fetchAttachedImage();
+    }
+    CamImage &img = buffer.getCaptureBuffer();
+    src.fetchImage(img);
+    return img;
+}
+
 void ImageThread::initCameras() {
-    // initializing cameras takes quite a while, so let's do it in parallel
-    auto f1 = std::async(&NaoCameras::openCamera, cameras, TOP_CAMERA, settings->simulatorHost, settings->docker);
-    auto f2 = std::async(&NaoCameras::openCamera, cameras, BOTTOM_CAMERA, settings->simulatorHost, settings->docker);
-    // std::future destructor takes care of wait()
+    ImageBuffer *top = zeroCopy ? &image_provider->top : nullptr;
+    ImageBuffer *bottom = zeroCopy ? &image_provider->bottom : nullptr;
+    {
+        // initializing cameras takes quite a while, so let's do it in parallel
+        auto f1 = std::async(&NaoCameras::openCamera, cameras, TOP_CAMERA, settings->simulatorHost, settings->docker,
+                             top);
+        auto f2 = std::async(&NaoCameras::openCamera, cameras, BOTTOM_CAMERA, settings->simulatorHost,
+                             settings->docker, bottom);
+        // std::future destructor takes care of wait()
+    }
+    watchCameras();
+}
+
+void ImageThread::watchCameras() {
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (!cameras->initialized() || cameras->top->fileDescriptor() < 0 || cameras->bottom->fileDescriptor() < 0) {
+        // e.g. simulator, fetch images one after the other
+        return;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        LOG_ERROR << "ImageThread: epoll_create1 failed: " << std::strerror(errno);
+        return;
+    }
+    for (int cam : {TOP_CAMERA, BOTTOM_CAMERA}) {
+        const auto &src = (cam == TOP_CAMERA) ? *cameras->top : *cameras->bottom;
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = static_cast<uint32_t>(cam);
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, src.fileDescriptor(), &ev) < 0) {
+            LOG_ERROR << "ImageThread: epoll_ctl failed: " << std::strerror(errno);
+            close(epollFd);
+            epollFd = -1;
+            return;
+        }
+    }
 }
 
 void ImageThread::resetCameras(bool do_say) {
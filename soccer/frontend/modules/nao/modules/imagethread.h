@@ -8,15 +8,15 @@
 #include <representations/blackboards/camera_parameters.h>
 #include <representations/bembelbots/nao_info.h>
 #include <representations/camera/image_provider.h>
+#include <representations/camera/cam_pose_history.h>
 #include <representations/nao/commands.h>
-#include "../naostate.h"
-#include <deque>
 
 #include <cam_pose_message_generated.h>
 #include <gamestate_message_generated.h>
 
 //class DoCameraParameter{};
 class NaoCameras;
+class JsVideoSource;
 
 class ImageThread : public rt::Module {
 public:
@@ -32,7 +32,7 @@ private:
     rt::Command<DoCameraParameter, rt::Handle> cmds;
 */
     rt::Context<SettingsBlackboard> settings;
-    rt::Input<NaoState, rt::Snoop> nao_states;
+    rt::Context<CamPoseHistory> cam_poses;
     rt::Input<bbapi::GamestateMessageT> game_state;
     rt::Context<NaoInfo> nao_info;
     rt::Context<ImageProvider, rt::Write> image_provider;
@@ -45,13 +45,24 @@ private:
     std::unique_ptr<CameraCalibrationBlackboard> bottomCameraCalibration;
     std::unique_ptr<CameraParametersBlackboard> cameraParameters;
 
-    std::deque<NaoState> bs_dq;
+    // cameras write straight into the image buffers, see ImageBuffer::recycle()
+    bool zeroCopy{false};
+
+    // waits for images of both cameras at once, -1 if the sources can't be polled
+    int epollFd{-1};
+
+    // latest pose of each camera, emitted once per cycle
+    bbapi::CamPoseMessageT camPoses;
 
     void setCamPose(CamImage &img, CamPose &cp);
     void checkCameraParameters(bool force);
     void onSetPitchOffset(SetPitchOffset &);
 
+    CamImage &fetchImage(JsVideoSource &src, ImageBuffer &buffer);
+    void captureEvents();
+    void publish(CamImage &img, ImageBuffer &buffer);
     void initCameras();
+    void watchCameras();
     void resetCameras(bool do_say = true);
 };
 
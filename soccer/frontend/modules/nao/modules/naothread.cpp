@@ -82,8 +82,6 @@ void NaoThread::process() {
     NaoState current_state{.timestamp_ms = getTimestampMs(),
             .lola_timestamp = sensorMsg->lolaTimestamp,
             .connected = sensorMsg->connected,
-            .bCamPose = {},
-            .tCamPose = {},
             .actuatorData = actuatorMsg,
             .sensorData = sensorMsg};
 
@@ -4,7 +4,6 @@
 #include "ipc_sensor_message_generated.h"
 #include <framework/util/clock.h>
 
-#include <representations/camera/cam_pose_struct.h>
 #include <representations/flatbuffers/types/sensors.h>
 #include <representations/flatbuffers/types/actuators.h>
 
@@ -12,8 +11,6 @@ struct NaoState {
     TimestampMs timestamp_ms;
     int64_t lola_timestamp;
     bool connected;
-    CamPose bCamPose;
-    CamPose tCamPose;
     bbapi::BembelIpcActuatorMessageT *actuatorData;
     const bbapi::BembelIpcSensorMessageT *sensorData;
 };
@@ -0,0 +1,79 @@
+#include "profiling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+// p-th percentile of the calls in histogram, interpolated linearly inside the bucket
+float percentile(const std::vector<uint64_t> &histogram, uint64_t count, float p, float maxUs) {
+    const double rank = p / 100.0 * count;
+    uint64_t below = 0;
+    for (size_t b = 0; b < histogram.size(); b++) {
+        if (below + histogram[b] >= rank && histogram[b] > 0) {
+            const float lower = (b == 0) ? 0.f : profiler::bucketUpperUs(b - 1);
+            const float upper = std::min(profiler::bucketUpperUs(b), maxUs);
+            const double fraction = (rank - below) / histogram[b];
+            return std::min(maxUs, static_cast<float>(lower + fraction * std::max(0.f, upper - lower)));
+        }
+        below += histogram[b];
+    }
+    return maxUs;
+}
+
+} // namespace
+
+void Profiling::setup() {
+    previous = profiler::collect();
+    lastPublish = getTimestampMs();
+}
+
+void Profiling::connect(rt::Linker &link) {
+    link.name = "Profiling";
+
+    link(stats);
+}
+
+void Profiling::process() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(PERIOD_MS));
+
+    const TimestampMs now = getTimestampMs();
+    std::vector<profiler::ZoneStats> current = profiler::collect();
+    const double usPerTick = profiler::microsecondsPerTick();
+
+    bbapi::ProfilerMessageT msg;
+    msg.periodMs = static_cast<uint32_t>(now - lastPublish);
+    for (size_t b = 0; b < profiler::NUM_BUCKETS; b++) {
+        msg.bucketUpperUs.push_back(profiler::bucketUpperUs(b));
+    }
+
+    // zones are only appended, so previous is a prefix of current
+    previous.resize(current.size());
+    for (size_t z = 0; z < current.size(); z++) {
+        const profiler::ZoneStats &cur = current[z];
+        const profiler::ZoneStats &prev = previous[z];
+        const uint64_t count = cur.count - prev.count;
+        if (count == 0) {
+            continue;
+        }
+
+        auto zone = std::make_unique<bbapi::ProfileZoneT>();
+        zone->name = cur.name;
+        zone->count = count;
+        zone->totalUs = (cur.ticks - prev.ticks) * usPerTick;
+        zone->maxUs = static_cast<float>(cur.maxTicks * usPerTick);
+        for (size_t b = 0; b < profiler::NUM_BUCKETS; b++) {
+            zone->histogram.push_back(cur.histogram[b] - prev.histogram[b]);
+        }
+        zone->p50Us = percentile(zone->histogram, count, 50, zone->maxUs);
+        zone->p90Us = percentile(zone->histogram, count, 90, zone->maxUs);
+        zone->p99Us = percentile(zone->histogram, count, 99, zone->maxUs);
+        msg.zones.push_back(std::move(zone));
+    }
+
+    previous = std::move(current);
+    lastPublish = now;
+    stats.emit(msg);
+}
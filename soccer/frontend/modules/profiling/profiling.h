@@ -0,0 +1,26 @@
+#pragma once
+#include <framework/rt/module.h>
+#include <framework/benchmark/profiler.h>
+#include <framework/util/clock.h>
+#include <profiler_message_generated.h>
+
+#include <vector>
+
+/**
+ * Publishes the statistics of all profiler zones (see framework/benchmark/profiler.h)
+ * once per second, for the DebugServer and the log file.
+ */
+class Profiling : public rt::Module {
+public:
+    void setup() override;
+    void connect(rt::Linker &) override;
+    void process() override;
+
+private:
+    static constexpr TimestampMs PERIOD_MS{1000};
+
+    rt::Output<bbapi::ProfilerMessageT, rt::Event> stats;
+
+    std::vector<profiler::ZoneStats> previous;
+    TimestampMs lastPublish{0};
+};
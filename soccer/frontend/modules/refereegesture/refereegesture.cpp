@@ -6,6 +6,7 @@
 #include <tensorflow/lite/kernels/register.h>
 #include <representations/bembelbots/constants.h>
 
+#include <framework/image/yuv422.h>
 #include <framework/thread/util.h>
 
 void RefereeGesture::setup() {
@@ -45,17 +46,16 @@ void RefereeGesture::process() {
         return;
     }
 
-    cv::Mat converted = cv::imdecode(*img.jpeg, cv::IMREAD_COLOR);
-
-    //cv::cvtColor(img.mat(), converted, cv::COLOR_YUV2RGB_YUY2); // This conversion would we used if we had the original image mat instead of the JPEG data
-
-    // Cut relevant frame of the image
-    converted = converted(cv::Range(100, 100 + 256), cv::Range(192, 640 - 192));
-
-    cv::resize(converted, converted, cv::Size(192, 192));
+    jsassert(img.width >= CROP_X + CROP_SIZE && img.height >= CROP_Y + CROP_SIZE) << "image too small";
 
+    // cut relevant frame of the raw image, convert and scale it directly into the input tensor
     uint8_t *input_tensor = poseDetectionInterpreter->typed_input_tensor<uint8_t>(0);
-    std::memcpy(input_tensor, converted.data, 192 * 192 * 3 * sizeof(uint8_t));
+    cropYuv422ToRgb(img.yuyv(), img.width, CROP_X, CROP_Y, CROP_SIZE, CROP_SIZE, input_tensor, INPUT_SIZE,
+            INPUT_SIZE);
+
+    // debug image is written with OpenCV, which expects BGR
+    cv::Mat converted;
+    cv::cvtColor(cv::Mat(INPUT_SIZE, INPUT_SIZE, CV_8UC3, input_tensor), converted, cv::COLOR_RGB2BGR);
 
     jsassert(poseDetectionInterpreter->Invoke() == kTfLiteOk) << "Failed to run pose detection";
 
@@ -79,7 +79,7 @@ void RefereeGesture::process() {
     const bool right_arm_up = y(POS_RIGHT_WRIST) < y(POS_RIGHT_ELBOW) && y(POS_RIGHT_ELBOW) < y(POS_RIGHT_SHOULDER);
 
     for (size_t element = POS_LEFT_SHOULDER; element <= POS_RIGHT_WRIST; ++element) {
-        const auto center = cv::Point(192 * x(element), 192 * y(element));
+        const auto center = cv::Point(INPUT_SIZE * x(element), INPUT_SIZE * y(element));
         cv::circle(converted, center, 2, cv::Scalar(0, conf(element) * 255, 255), cv::FILLED, cv::LINE_8);
     }
 
@@ -90,8 +90,8 @@ void RefereeGesture::process() {
             std::make_pair(POS_RIGHT_ELBOW, POS_RIGHT_WRIST),
     };
     for (const auto &line : lines) {
-        const auto start = cv::Point(192 * x(line.first), 192 * y(line.first));
-        const auto end = cv::Point(192 * x(line.second), 192 * y(line.second));
+        const auto start = cv::Point(INPUT_SIZE * x(line.first), INPUT_SIZE * y(line.first));
+        const auto end = cv::Point(INPUT_SIZE * x(line.second), INPUT_SIZE * y(line.second));
         cv::line(converted, start, end, cv::Scalar(255, 0, 0), 1, cv::LINE_8);
     }
 
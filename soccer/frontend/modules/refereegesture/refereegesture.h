@@ -23,8 +23,14 @@ public:
     void process() override;
 
 private:
+    // region of the top camera image, where the referee is expected
+    static constexpr size_t CROP_X{192};
+    static constexpr size_t CROP_Y{100};
+    static constexpr size_t CROP_SIZE{256};
+    // MoveNet input size
+    static constexpr size_t INPUT_SIZE{192};
+
     rt::Context<SettingsBlackboard> settings;
-    /// TODO: Don't encode to JPEG and back
     rt::Input<VisionImageProcessed, rt::Snoop> inputImage;
     rt::Input<bbapi::GamecontrolMessageT> inputGameControl;
     rt::Output<bbapi::RefereeGestureMessageT, rt::Event> event;
@@ -12,6 +12,7 @@
 #include "vision/vision.h"
 #include "worldmodel/worldmodel.h"
 #include "logevents/logevents.h"
+#include "profiling/profiling.h"
 
 void RoboCup::connect(rt::Linker &link) {
     link.name = "Robocup";
@@ -29,6 +30,7 @@ void RoboCup::load(rt::Kernel &soccer) {
     modules.emplace_back(new Vision());
     modules.emplace_back(new WorldModel());
     modules.emplace_back(new LogEvents());
+    modules.emplace_back(new Profiling());
 
     for (auto &module : modules) {
         soccer.load(module.get());
@@ -0,0 +1,259 @@
+/**
+ * Replays recorded camera frames through the vision pipeline offline and
+ * reports per-stage latency percentiles, throughput and detection counts,
+ * so vision changes can be compared without a robot.
+ *
+ * Input is a directory tree of *.yuv files, each containing one or more frames
+ * as written by CamImage::write() (raw YUYV 640x480, CamPose, principal point).
+ * Files with "bottom" in their name are bottom camera frames, all others top camera.
+ * Pixel angles are computed from the calibration of --robot (defaults if unknown).
+ *
+ * Recording frames on the robot:
+ *   Set logImages and logRawImages in the settings, LogFile then writes every
+ *   logged image as <robot>-<tick>-top.yuv / -bottom.yuv next to the JPEG.
+ *   `bblog2zip <log.bblog>` and unzipping the result gives a frame directory.
+ *
+ * Build:
+ *   cd build/<target>
+ *   make vision_replay
+ *
+ * Usage:
+ *   bin/vision_replay -c <config dir> [-w workers] [-r repeat] <frame dir>
+ *
+ * Example:
+ *   Running `bin/vision_replay -c ../config/ -w 2 frames/` runs every frame
+ *   once with the same stage pool size as the Vision module.
+ */
+
+#include <modules/vision/visionpipeline.h>
+#include <modules/vision/toolbox/visiontoolbox.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <boost/program_options.hpp>
+
+#include <framework/benchmark/latency.h>
+#include <framework/logger/logger.h>
+#include <framework/thread/simplethreadmanager.h>
+#include <framework/thread/workstealingpool.h>
+#include <libbembelbots/config/calibration.h>
+#include <representations/bembelbots/constants.h>
+#include <representations/bembelbots/thread.h>
+#include <representations/camera/camera.h>
+#include <representations/playingfield/playingfield.h>
+
+#include <time.h>
+
+namespace fs = std::filesystem;
+
+ThreadManager* GetThreadManager() {
+    using T = SimpleThreadManager<NaoThread>;
+    static ThreadManager manager(new T());
+    return &manager;
+}
+
+void CreateXLoggerThread(XLogger *logger) {
+    using namespace std::placeholders;
+    GetThreadManager()->create(NaoThread::IO, std::bind(&XLogger::io_worker, logger, _1));
+}
+
+static cv::Mat pixelAngles(const calibration::HeadCalibration::cam &cal) {
+    const float fovL = std::atan2(cal.principalPoint[0], cal.focalLength[0]);
+    const float fovR = std::atan2(camera::w - cal.principalPoint[0], cal.focalLength[0]);
+    const float fovT = std::atan2(cal.principalPoint[1], cal.focalLength[1]);
+    const float fovB = std::atan2(camera::h - cal.principalPoint[1], cal.focalLength[1]);
+    return CamImage::calcPixelAngles(cal.principalPoint, cal.focalLength, {fovL, fovR}, {fovT, fovB}, cal.distortion);
+}
+
+// pixel data of a frame, the CamImage only points to it
+struct FreeFrame {
+    void operator()(uint8_t *data) const { free(data); } // posix_memalign needs free
+};
+using FrameBuffer = std::unique_ptr<uint8_t, FreeFrame>;
+
+// load all frames into memory, so disk I/O doesn't show up in the timings,
+// buffers owns their pixel data and has to outlive the frames
+static std::vector<CamImage> loadFrames(const fs::path &dir, size_t maxFrames, std::vector<FrameBuffer> &buffers) {
+    std::vector<fs::path> files;
+    for (const auto &entry : fs::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".yuv") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<CamImage> frames;
+    const size_t frameSize = camera::w * camera::h * camera::bpp;
+    for (const auto &path : files) {
+        const int cam = path.filename().string().find("bottom") != std::string::npos ? BOTTOM_CAMERA : TOP_CAMERA;
+        std::ifstream file(path, std::ios::binary);
+        while (file.peek() != EOF && (maxFrames == 0 || frames.size() < maxFrames)) {
+            void *data = nullptr;
+            if (posix_memalign(&data, 16, frameSize) != 0) {
+                throw std::bad_alloc();
+            }
+            FrameBuffer buffer(static_cast<uint8_t *>(data));
+            CamImage img(camera::w, camera::h, cam);
+            img.setData(buffer.get());
+            if (!img.read(file)) {
+                // buffer frees the partial frame
+                std::cerr << "Skipping truncated frame at the end of " << path << std::endl;
+                break;
+            }
+            img.timestamp = static_cast<int64_t>(frames.size());
+            frames.push_back(img);
+            buffers.push_back(std::move(buffer));
+        }
+    }
+    return frames;
+}
+
+static const char *visionClassName(VisionClass type) {
+    switch (type) {
+        case JSVISION_NOTHING: return "nothing";
+        case JSVISION_FIELD: return "field";
+        case JSVISION_BALL: return "ball";
+        case JSVISION_RECT: return "rect";
+        case JSVISION_GOAL: return "goal";
+        case JSVISION_LINE: return "line";
+        case JSVISION_LCROSS: return "L-cross";
+        case JSVISION_TCROSS: return "T-cross";
+        case JSVISION_XCROSS: return "X-cross";
+        case JSVISION_PENALTY: return "penalty";
+        case JSVISION_CIRCLE: return "circle";
+        case JSVISION_FACE: return "face";
+        case JSVISION_SCANPOINT: return "scanpoint";
+        case JSVISION_ROBOT: return "robot";
+    }
+    return "unknown";
+}
+
+static double cpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, const char *argv[]) {
+    std::string configPath, robot, frameDir;
+    int workers, repeat, maxFrames;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("config,c", po::value<std::string>(&configPath)->default_value("../config/"), "config directory (for the nn models)")
+        ("robot", po::value<std::string>(&robot)->default_value(""), "head serial, to use its camera calibration")
+        ("workers,w", po::value<int>(&workers)->default_value(2), "stage pool workers, 0 runs all stages on the main thread")
+        ("repeat,r", po::value<int>(&repeat)->default_value(1), "run all frames this often")
+        ("max-frames,n", po::value<int>(&maxFrames)->default_value(0), "load at most this many frames (0: all)")
+        ("frames", po::value<std::string>(&frameDir), "directory with recorded *.yuv frames")
+        ("help,h", "produce help message.");
+    po::positional_options_description pos;
+    pos.add("frames", 1);
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(desc).positional(pos).run(), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || frameDir.empty()) {
+        std::cout << std::endl << desc << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    std::vector<FrameBuffer> buffers;
+    std::vector<CamImage> frames = loadFrames(frameDir, std::max(maxFrames, 0), buffers);
+    if (frames.empty()) {
+        std::cerr << "No frames found in " << frameDir << std::endl;
+        return 1;
+    }
+
+    calibration::HeadCalibration head;
+    if (calibration::head.count(robot)) {
+        head = calibration::head.at(robot);
+    } else if (!robot.empty()) {
+        std::cerr << "No calibration for " << robot << ", using default values" << std::endl;
+    }
+    const cv::Mat anglesTop = pixelAngles(head.topCam);
+    const cv::Mat anglesBottom = pixelAngles(head.bottomCam);
+    for (auto &img : frames) {
+        img.setCalibration(img.principalPointX, img.principalPointY,
+                img.camera == TOP_CAMERA ? anglesTop : anglesBottom);
+    }
+
+    const float centerCircleRadius = PlayingField()._circle.wcs_radius;
+    VisionToolbox topToolbox(configPath, TOP_CAMERA);
+    VisionToolbox bottomToolbox(configPath, BOTTOM_CAMERA);
+    VisionPipeline top(topToolbox, true, centerCircleRadius);
+    VisionPipeline bottom(bottomToolbox, false, centerCircleRadius);
+
+    std::shared_ptr<ThreadPool> pool;
+    if (workers > 0) {
+        pool = std::make_shared<WorkStealingThreadPool<NaoThread>>(GetThreadManager(), NaoThread::NORMAL);
+        pool->start(workers);
+    }
+
+    std::map<std::string, std::vector<int64_t>> stageLatency;
+    std::vector<int64_t> frameLatency;
+    std::map<VisionClass, size_t> detections;
+    size_t ballFrames = 0;
+
+    using clock = std::chrono::steady_clock;
+    const double cpuStart = cpuSeconds();
+    const auto wallStart = clock::now();
+
+    for (int r = 0; r < repeat; r++) {
+        for (auto &img : frames) {
+            VisionPipeline &pipeline = img.camera == TOP_CAMERA ? top : bottom;
+
+            const auto start = clock::now();
+            pipeline.run(img, pool.get());
+            const auto end = clock::now();
+            frameLatency.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+            for (const auto &t : pipeline.graph().timings()) {
+                stageLatency[t.name].push_back(t.duration);
+            }
+            for (const auto &vr : pipeline.results()) {
+                detections[vr.type]++;
+            }
+            ballFrames += pipeline.isBallFound();
+        }
+    }
+
+    const double wall = std::chrono::duration<double>(clock::now() - wallStart).count();
+    const double cpu = cpuSeconds() - cpuStart;
+    if (pool != nullptr) {
+        pool->stop();
+    }
+
+    const size_t runs = frameLatency.size();
+    std::cout << "Frames: " << frames.size() << " x " << repeat << ", stage pool workers: " << workers << std::endl;
+    std::cout << std::endl << "Latency [us]" << std::endl;
+    benchmark::printLatencyHeader("stage");
+    for (auto &[name, us] : stageLatency) {
+        benchmark::printLatency(name, us);
+    }
+    benchmark::printLatency("frame", frameLatency);
+
+    std::cout << std::endl << std::fixed << std::setprecision(1);
+    std::cout << "Throughput: " << runs / wall << " frames/s, "
+              << runs / cpu << " frames/s per core (" << cpu / wall << " cores busy)" << std::endl;
+
+    std::cout << std::endl << "Detections (per frame)" << std::endl << std::setprecision(2);
+    std::cout << "  frames with ball   " << std::setw(8) << ballFrames
+              << std::setw(8) << double(ballFrames) / runs << std::endl;
+    for (const auto &[type, count] : detections) {
+        std::cout << "  " << std::left << std::setw(19) << visionClassName(type) << std::right
+                  << std::setw(8) << count << std::setw(8) << double(count) / runs << std::endl;
+    }
+
+    return 0;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
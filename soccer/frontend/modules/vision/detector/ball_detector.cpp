@@ -61,13 +61,15 @@ namespace bbvision {
         foundBall = false;
         penaltyMarkFound = false;
 
-        int try_count = 0;
-        for(htwk::ObjectHypothesis& hyp : hypoList){
-            if(try_count >= max_trys){
-                break;
-            }
-            try_count += 1;
-                        
+        // cut all candidate patches first, so each network only needs one forward pass per frame
+        std::vector<cv::Mat> patches;
+        std::vector<cv::Mat> penaltyPatches;
+        std::vector<int> penaltyIdx;
+
+        const size_t numHyps = std::min<size_t>(hypoList.size(), std::max(max_trys, 0));
+        for (size_t i = 0; i < numHyps; ++i) {
+            htwk::ObjectHypothesis& hyp = hypoList[i];
+
             if(img.camera == TOP_CAMERA){ // top camera
                 hyp.r = estimatedBallRadius(hyp.x, hyp.y, img);
             } else {
@@ -86,29 +88,30 @@ namespace bbvision {
             // Prepare image patch for network pass
             cv::Mat currImage = cv::Mat(patch.height, patch.width, CV_8UC1, 1);
             cutCyFromImage(img, currImage, patch);
-            
-            // Pass through BallNet
-            float ballProb = 0.f;
-            if(!foundBall){
-            	std::vector<float> result = caffeClassifier->Classify(currImage, 1);
-            	ballProb = result[1];
-
-                // Convert x,y to RCS position
-                //Coord ballRcs = img.getRcsPosition(hyp.x, hyp.y); // RCS positon of the ball
-                
-                // Get distance to rcs position
-                //float dist = ballRcs.dist();
-                //LOG_DEBUG_EVERY_N(100) << "dist: " << dist;
+            patches.push_back(currImage);
+
+            if(hyp.y >= 0.3*img.height){ // Check if roi is below theshold
+                penaltyIdx.push_back(i);
+                penaltyPatches.push_back(currImage);
             }
-            
-            // Pass through PenaltyRobotNet
+        }
+
+        // Pass all patches through BallNet and PenaltyRobotNet
+        std::vector<float> ballProbs = caffeClassifier->ClassifyBatch(patches, 1);
+        std::vector<float> robotProbs(numHyps, 0.f);
+        std::vector<float> penaltyResults = penaltyClassifier->ClassifyBatch(penaltyPatches, 1);
+        for (size_t i = 0; i < penaltyIdx.size(); ++i) {
+            robotProbs[penaltyIdx[i]] = penaltyResults[i];
+        }
+
+        for (size_t i = 0; i < numHyps; ++i) {
+            htwk::ObjectHypothesis& hyp = hypoList[i];
+
+            // only the first ball above threshold is used
+            float ballProb = foundBall ? 0.f : ballProbs[i];
+
             float penaltyProb = 0.f;
-            float robotProb = 0.f;
-            if(hyp.y >= 0.3*img.height){//hyp.y >= 0.3*img.height){ // Check if roi is below theshold
-                std::vector<float> resultPenalty = penaltyClassifier->Classify(currImage, 1);
-                //penaltyProb = resultPenalty[1];
-                robotProb = resultPenalty[1];
-            }
+            float robotProb = robotProbs[i];
 
             ratedBallHypotheses.push_back(hyp);
 
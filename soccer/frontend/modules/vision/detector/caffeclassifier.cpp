@@ -51,12 +51,49 @@ std::vector<float> CaffeClassifier::Classify(const cv::Mat& img, int N) {
     return output;
 }
 
-std::vector<float> CaffeClassifier::Predict(const cv::Mat& img) {
-    //Blob<float>* input_layer = net_->input_blobs()[0];
-    //input_layer->Reshape(1, num_channels_,
-    //                     input_geometry_.height, input_geometry_.width);
+std::vector<float> CaffeClassifier::ClassifyBatch(const std::vector<cv::Mat> &imgs, int label) {
+    if (imgs.empty()) {
+        return {};
+    }
+
+    ReshapeInput(imgs.size());
+
+    for (size_t i = 0; i < imgs.size(); ++i) {
+        std::vector<cv::Mat> input_channels;
+        WrapInputLayer(&input_channels, i);
+        Preprocess(imgs[i], &input_channels, i);
+    }
+
+    net_->Forward();
+
+    /* Pick probability of the requested class for every patch */
+    Blob<float> *output_layer = net_->output_blobs()[0];
+    const float *output = output_layer->cpu_data();
+    const int stride = output_layer->count() / output_layer->num();
+    CHECK_LT(label, stride) << "Network has no output for label " << label;
+
+    std::vector<float> result(imgs.size());
+    for (size_t i = 0; i < imgs.size(); ++i) {
+        result[i] = output[i * stride + label];
+    }
+    return result;
+}
+
+/* Set batch size of the input layer.
+ * Shrinking the batch doesn't reallocate, so this is cheap when called every frame. */
+void CaffeClassifier::ReshapeInput(int num) {
+    Blob<float> *input_layer = net_->input_blobs()[0];
+    if (input_layer->num() == num) {
+        return;
+    }
+    input_layer->Reshape(num, num_channels_,
+                         input_geometry_.height, input_geometry_.width);
     /* Forward dimension change to all layers. */
-    //net_->Reshape(); //NEEDED FOR DYNAMIC FULL CONV NETS!
+    net_->Reshape();
+}
+
+std::vector<float> CaffeClassifier::Predict(const cv::Mat& img) {
+    ReshapeInput(1);
 
     std::vector<cv::Mat> input_channels;
     WrapInputLayer(&input_channels);
@@ -78,12 +115,12 @@ std::vector<float> CaffeClassifier::Predict(const cv::Mat& img) {
  * don't need to rely on cudaMemcpy2D. The last preprocessing
  * operation will write the separate channels directly to the input
  * layer. */
-void CaffeClassifier::WrapInputLayer(std::vector<cv::Mat> *input_channels) {
+void CaffeClassifier::WrapInputLayer(std::vector<cv::Mat> *input_channels, int n) {
     Blob<float> *input_layer = net_->input_blobs()[0];
 
     int width = input_layer->width();
     int height = input_layer->height();
-    float *input_data = input_layer->mutable_cpu_data();
+    float *input_data = input_layer->mutable_cpu_data() + input_layer->offset(n);
     for (int i = 0; i < input_layer->channels(); ++i) {
         cv::Mat channel(height, width, CV_32FC1, input_data);
         input_channels->push_back(channel);
@@ -111,7 +148,7 @@ std::vector<int> CaffeClassifier::Argmax(const std::vector<float>& v, int N) {
 
 
 void CaffeClassifier::Preprocess(const cv::Mat &img,
-                                 std::vector<cv::Mat> *input_channels) {
+                                 std::vector<cv::Mat> *input_channels, int n) {
     /* Convert the input image to the input image format of the network. */
     cv::Mat sample;
     /*
@@ -148,7 +185,7 @@ void CaffeClassifier::Preprocess(const cv::Mat &img,
     cv::split(sample, *input_channels);
 
     CHECK(reinterpret_cast<float *>(input_channels->at(0).data)
-          == net_->input_blobs()[0]->cpu_data())
+          == net_->input_blobs()[0]->cpu_data() + net_->input_blobs()[0]->offset(n))
             << "Input channels are not wrapping the input layer of the network.";
 }
 
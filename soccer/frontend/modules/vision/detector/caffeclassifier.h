@@ -30,6 +30,10 @@ public:
 
     std::vector<float> Classify(const cv::Mat &img, int N = 5);
 
+    /* Classify all patches in a single forward pass.
+     * Returns the probability of class `label` for every patch. */
+    std::vector<float> ClassifyBatch(const std::vector<cv::Mat> &imgs, int label = 1);
+
     static std::vector<int> Argmax(const std::vector<float>& v, int N);
 
     void setMean(float mean);
@@ -38,10 +42,10 @@ public:
     cv::Size input_geometry_;
 
     std::shared_ptr<caffe::Net<float>> net_;
-    void WrapInputLayer(std::vector<cv::Mat>* input_channels);
+    void WrapInputLayer(std::vector<cv::Mat>* input_channels, int n = 0);
 
     void Preprocess(const cv::Mat &img,
-                    std::vector<cv::Mat> *input_channels);
+                    std::vector<cv::Mat> *input_channels, int n = 0);
 private:
     //cv::Size input_geometry_;
     int num_channels_;
@@ -51,6 +55,8 @@ private:
 
     std::vector<float> Predict(const cv::Mat& img);
 
+    void ReshapeInput(int num);
+
     static bool PairCompare(const std::pair<float, int>& lhs, const std::pair<float, int>& rhs);
 
     void LoadPreprocessParamters(const std::string& preprocess_file);
@@ -163,6 +163,16 @@ void VisionToolbox::_init(std::string configPath, int cam) {
  * @param image image to get size from
  */
 void VisionToolbox::process(const CamImage &img) {
+    setImage(img);
+
+    // basic init of htwk vision process
+    detectFieldColor();
+    classifyRegions();
+    detectField();
+    createIntegralImage();
+}
+
+void VisionToolbox::setImage(const CamImage &img) {
     _img = img;
     _htwkImg = _img.data;
 
@@ -174,19 +184,27 @@ void VisionToolbox::process(const CamImage &img) {
     _roi.upperBorder.resize(camera::w + 1);
 
     jsassert(_htwkImg != nullptr);
+}
 
-    // basic init of htwk vision process
+void VisionToolbox::detectFieldColor() {
     _htwk->fieldColorDetector->proceed(_htwkImg);
+}
+
+void VisionToolbox::classifyRegions() {
     _htwk->regionClassifier->proceed(_htwkImg, _htwk->fieldColorDetector);
+}
 
+void VisionToolbox::detectField() {
     // 10 iterations improves ball detection. I don't know why yet :/
     //for(size_t i = 0; i < 10; i++){
     _htwk->fieldDetector->proceed(_htwkImg, _htwk->fieldColorDetector,
-                                  _htwk->regionClassifier, img.camera == TOP_CAMERA);
+                                  _htwk->regionClassifier, _img.camera == TOP_CAMERA);
     //}
+}
 
+void VisionToolbox::createIntegralImage() {
+    // only needs the image, can run in parallel to the field detection
     _htwk->integralImage->proceed(_htwkImg);
-
 }
 
 bool VisionToolbox::isBallFound() const {
@@ -23,9 +23,18 @@ public:
     VisionToolbox();
     ~VisionToolbox();
 
-    /// create new binary image
+    /// create new binary image, runs all of the stages below one after another
     void process(const CamImage &img);
 
+    /// set the image the following stages work on
+    void setImage(const CamImage &img);
+
+    // stages of process(), the comment lists what has to be finished before
+    void detectFieldColor();        // setImage
+    void classifyRegions();         // detectFieldColor
+    void detectField();             // classifyRegions
+    void createIntegralImage();     // setImage
+
     bool isBallFound() const;
 
     // enable the new Ball Detection
@@ -1,10 +1,15 @@
 #include "vision.h"
 #include <framework/logger/logger.h>
+#include <framework/rt/kernel.h>
+#include <framework/rt/trace.h>
+#include <framework/thread/threadmanager.h>
 #include <representations/playingfield/playingfield.h>
 #include "toolbox/visiontoolbox.h"
-#include "toolbox/colorclasses.h"
 #include <future>
 
+// workers of the stage pool, the camera threads run stages, too
+static constexpr uint32_t STAGE_POOL_WORKERS = 2;
+
 static void visionResultsAppend(VisionResultVec &results, VisionResultVec &other) {
     results.insert(results.end(), other.begin(), other.end());
 }
@@ -24,26 +29,31 @@ void Vision::setup() {
     top_toolbox = std::make_shared<VisionToolbox>(settings->configPath, TOP_CAMERA);
     bottom_toolbox = std::make_shared<VisionToolbox>(settings->configPath, BOTTOM_CAMERA);
     center_circle_radius = playingfield->_circle.wcs_radius;
+
+    pool = rt::CreateModulePool();
+    pool->start(STAGE_POOL_WORKERS);
+    top_pipeline = std::make_unique<VisionPipeline>(*top_toolbox, true, center_circle_radius);
+    bottom_pipeline = std::make_unique<VisionPipeline>(*bottom_toolbox, false, center_circle_radius);
 }
 
 CamImage Vision::getImage(int cam) {
-    CamImage img = image_provider->getImage(cam);
-    img.lock(ImgLock::VISION);
-    return img;
+    return image_provider->getImage(cam, ImgLock::VISION);
 }
 
 void Vision::process() {
     auto lock = board.scopedLock();
-    std::future<CamImage> topimg, botimg;
+    std::shared_future<CamImage> topimg, botimg;
     topimg = std::async(&Vision::getImage, this, TOP_CAMERA);
     botimg = std::async(&Vision::getImage, this, BOTTOM_CAMERA);
-    
+
+    // the cameras publish independently, start with whichever image arrives first
     std::future<DetectResult> top_detect, bottom_detect;
-    top_detect = std::async(&Vision::processTopCam, this, topimg.get());
-    bottom_detect = std::async(&Vision::processBottomCam, this, botimg.get());
+    top_detect = std::async([this, topimg]() { return processTopCam(topimg.get()); });
+    bottom_detect = std::async([this, botimg]() { return processBottomCam(botimg.get()); });
 
     auto [top_ball, top_results] = top_detect.get(); 
     auto [bottom_ball, bottom_results] = bottom_detect.get();
+    rt::Tracer::setFrameOrigin(std::min(topimg.get().timestamp, botimg.get().timestamp));
     
     // verify camera of results
     for(auto &result : top_results) {
@@ -75,28 +85,8 @@ void Vision::process() {
 }
 
 Vision::DetectResult Vision::processTopCam(CamImage img){
-    auto &toolbox = *top_toolbox;
     jsassert(img.camera == TOP_CAMERA);
-    toolbox.process(img);
-    
-    // calucalte ROI
-    RoiDef roi = toolbox.getROI();
-
-    // set it and draw it on request
-    toolbox.setROI(img, roi);
-    if (board.showROI == 1) {
-        toolbox.drawROI(img);
-    }
-
-    // for debugging, draw field on the image
-    if (board.showField) {
-        toolbox.drawField(img);
-    }
-
-    ColorClass::green = toolbox.getGreen();
-    ColorClass::white = toolbox.getWhite();
-    
-    auto res = detect(img, toolbox);
+    auto res = detect(img, *top_pipeline);
 
     if (board.ballDistanceMeasuredTop > 0) {
         autoCalibratePitchWithBall(board.ballDistanceMeasuredTop, img, res.second);
@@ -107,11 +97,8 @@ Vision::DetectResult Vision::processTopCam(CamImage img){
 }
 
 Vision::DetectResult Vision::processBottomCam(CamImage img){
-    auto &toolbox = *bottom_toolbox;
     jsassert(img.camera == BOTTOM_CAMERA);
-    toolbox.process(img);
-
-    auto res = detect(img, toolbox);
+    auto res = detect(img, *bottom_pipeline);
 
     if (board.ballDistanceMeasuredBottom > 0) {
         autoCalibratePitchWithBall(board.ballDistanceMeasuredBottom, img, res.second);
@@ -121,21 +108,16 @@ Vision::DetectResult Vision::processBottomCam(CamImage img){
     return res;
 }
 
-Vision::DetectResult Vision::detect(CamImage &img, VisionToolbox &toolbox) {
-    VisionResultVec results;
+Vision::DetectResult Vision::detect(CamImage &img, VisionPipeline &pipeline) {
+    VisionPipeline::Debug debug{board.showROI, board.showField, board.showScanpoints};
+    pipeline.run(img, pool.get(), debug);
 
-    const CamPose &eulers = img._eulers;
-    auto ball = toolbox.findBall(eulers.r[1], eulers.r[2]);
-    visionResultsAppend(results, ball);
-    auto lines = toolbox.findLines(board.showScanpoints);
-    visionResultsAppend(results, lines);
-    auto crossings = toolbox.findCrossings(lines, center_circle_radius);
-    visionResultsAppend(results, crossings);
+    VisionResultVec results = pipeline.results();
 
     processed.emit(VisionImageProcessed(img, results));
 
     img.unlock(ImgLock::VISION);
-    return std::make_pair(toolbox.isBallFound(), results);
+    return std::make_pair(pipeline.isBallFound(), results);
 }
 
 void Vision::autoCalibratePitchWithBall(float real_distance, CamImage &image, VisionResultVec &vrs) {
@@ -169,5 +151,8 @@ void Vision::autoCalibratePitchWithBall(float real_distance, CamImage &image, Vi
 
 void Vision::stop() {
     LOG_DEBUG << "Vision Stop";
+    if (pool != nullptr) {
+        pool->stop();
+    }
 }
 
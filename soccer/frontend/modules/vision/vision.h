@@ -5,10 +5,12 @@
 #include <representations/camera/image_provider.h>
 #include <representations/vision/image.h>
 #include <representations/nao/commands.h>
+#include "visionpipeline.h"
 #include <mutex>
 
 class VisionToolbox;
 class PlayingField;
+class ThreadPool;
 
 class Vision : public rt::Module {
 public: 
@@ -35,12 +37,17 @@ private:
     std::shared_ptr<VisionToolbox> top_toolbox;
     std::shared_ptr<VisionToolbox> bottom_toolbox;
 
+    // stages of both cameras share this pool
+    std::shared_ptr<ThreadPool> pool;
+    std::unique_ptr<VisionPipeline> top_pipeline;
+    std::unique_ptr<VisionPipeline> bottom_pipeline;
+
     CamImage getImage(int cam);
 
     DetectResult processTopCam(CamImage img);
     DetectResult processBottomCam(CamImage img);
 
-    DetectResult detect(CamImage &, VisionToolbox &toolbox);
+    DetectResult detect(CamImage &, VisionPipeline &);
     
     void autoCalibratePitchWithBall(float real_distance, CamImage &camera, VisionResultVec &vrs);
 
@@ -0,0 +1,76 @@
+#include "visionpipeline.h"
+#include "toolbox/visiontoolbox.h"
+#include "toolbox/colorclasses.h"
+
+VisionPipeline::VisionPipeline(VisionToolbox &toolbox, bool withROI, float centerCircleRadius)
+  : toolbox(toolbox)
+  , centerCircleRadius(centerCircleRadius) {
+    build(withROI);
+}
+
+void VisionPipeline::build(bool withROI) {
+    using StageId = rt::StageGraph::StageId;
+    auto *tb = &toolbox;
+
+    StageId fieldColor = stages.add("fieldColorDetector", [tb]() { tb->detectFieldColor(); });
+    StageId regions = stages.add("regionClassifier", [tb]() { tb->classifyRegions(); }, {fieldColor});
+    StageId field = stages.add("fieldDetector", [tb]() { tb->detectField(); }, {regions});
+    StageId integral = stages.add("integralImage", [tb]() { tb->createIntegralImage(); });
+
+    std::vector<StageId> ballDeps{field, integral};
+    std::vector<StageId> lineDeps{field};
+    if (withROI) {
+        // draws into the image, so all stages reading it have to wait
+        StageId roi = stages.add("roi", [this, tb]() {
+            // calucalte ROI
+            RoiDef roi = tb->getROI();
+
+            // set it and draw it on request
+            tb->setROI(img, roi);
+            if (debug.showROI == 1) {
+                tb->drawROI(img);
+            }
+
+            // for debugging, draw field on the image
+            if (debug.showField) {
+                tb->drawField(img);
+            }
+
+            ColorClass::green = tb->getGreen();
+            ColorClass::white = tb->getWhite();
+        }, {field, integral});
+        ballDeps = {roi};
+        lineDeps = {roi};
+    }
+
+    stages.add("findBall", [this, tb]() {
+        const CamPose &eulers = img._eulers;
+        ball = tb->findBall(eulers.r[1], eulers.r[2]);
+    }, ballDeps);
+    StageId lineStage = stages.add("findLines", [this, tb]() {
+        lines = tb->findLines(debug.showScanpoints);
+    }, lineDeps);
+    stages.add("findCrossings", [this, tb]() {
+        crossings = tb->findCrossings(lines, centerCircleRadius);
+    }, {lineStage});
+}
+
+void VisionPipeline::run(CamImage &image, ThreadPool *pool, const Debug &dbg) {
+    img = image;
+    debug = dbg;
+    toolbox.setImage(img);
+    stages.run(pool);
+}
+
+VisionResultVec VisionPipeline::results() const {
+    VisionResultVec results;
+    results.reserve(ball.size() + lines.size() + crossings.size());
+    results.insert(results.end(), ball.begin(), ball.end());
+    results.insert(results.end(), lines.begin(), lines.end());
+    results.insert(results.end(), crossings.begin(), crossings.end());
+    return results;
+}
+
+bool VisionPipeline::isBallFound() const {
+    return toolbox.isBallFound();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <framework/rt/stage_graph.h>
+#include <representations/vision/visiondefinitions.h>
+#include <framework/image/camimage.h>
+
+class VisionToolbox;
+class ThreadPool;
+
+/**
+ * Detection stages of one camera as a dependency graph (see rt::StageGraph).
+ *
+ * Used by the Vision module on the robot and by the offline replay benchmark
+ * (benchmark/vision_replay.cpp), so both measure the same code path.
+ */
+class VisionPipeline {
+public:
+    // debug drawings into the camera image (ROI and field only with ROI)
+    struct Debug {
+        int showROI{0};
+        bool showField{false};
+        bool showScanpoints{false};
+    };
+
+    // withROI: restrict ball and line search to the region of interest (top camera)
+    VisionPipeline(VisionToolbox &toolbox, bool withROI, float centerCircleRadius);
+
+    // run all stages on img, stages run in parallel on pool (if not null)
+    void run(CamImage &img, ThreadPool *pool, const Debug &debug = {});
+
+    // ball, lines and crossings of the last run
+    VisionResultVec results() const;
+    bool isBallFound() const;
+
+    const rt::StageGraph &graph() const { return stages; }
+
+private:
+    VisionToolbox &toolbox;
+    float centerCircleRadius;
+
+    rt::StageGraph stages;
+    CamImage img;
+    Debug debug;
+
+    // filled by the stages
+    VisionResultVec ball;
+    VisionResultVec lines;
+    VisionResultVec crossings;
+
+    void build(bool withROI);
+};
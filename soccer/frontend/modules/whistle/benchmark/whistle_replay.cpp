@@ -0,0 +1,132 @@
+/**
+ * Replays WAV recordings (as written by the Whistle module to /home/nao/whistle/)
+ * through the whistle detector and reports processing time per step, CPU load
+ * relative to real time and when whistles were detected.
+ *
+ * Comparing window/hop settings on the same recordings shows the trade-off
+ * between detection latency and CPU time, e.g. --hop 1024 --window 1024
+ * --max-freq 22050 is close to the old non-overlapping full spectrum detector.
+ *
+ * Build:
+ *   cd build/<target>
+ *   make whistle_replay
+ *
+ * Usage:
+ *   bin/whistle_replay [--hop 512] [--window 1024] [--max-freq 5000] <file.wav>...
+ */
+
+#include <modules/whistle/detect/wavreader.h>
+#include <modules/whistle/detect/whistle_detector.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <boost/program_options.hpp>
+
+#include <framework/benchmark/latency.h>
+#include <framework/logger/logger.h>
+#include <framework/thread/simplethreadmanager.h>
+#include <representations/bembelbots/thread.h>
+
+#include <time.h>
+
+ThreadManager* GetThreadManager() {
+    using T = SimpleThreadManager<NaoThread>;
+    static ThreadManager manager(new T());
+    return &manager;
+}
+
+void CreateXLoggerThread(XLogger *logger) {
+    using namespace std::placeholders;
+    GetThreadManager()->create(NaoThread::IO, std::bind(&XLogger::io_worker, logger, _1));
+}
+
+static double cpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, const char *argv[]) {
+    size_t hop, window, minLength;
+    float maxFreq, threshold;
+    std::string wisdom;
+    std::vector<std::string> files;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("hop", po::value<size_t>(&hop)->default_value(512), "new samples per step (audio buffer size)")
+        ("window", po::value<size_t>(&window)->default_value(1024), "FFT length in samples")
+        ("max-freq", po::value<float>(&maxFreq)->default_value(5000), "highest evaluated frequency [Hz]")
+        ("threshold", po::value<float>(&threshold)->default_value(2500), "whistle frequency threshold [Hz]")
+        ("min-length", po::value<size_t>(&minLength)->default_value(512), "minimum whistle length [new samples of consecutive positive steps]")
+        ("wisdom", po::value<std::string>(&wisdom)->default_value(""), "fftw wisdom file (measure plan)")
+        ("files", po::value<std::vector<std::string>>(&files), "WAV files")
+        ("help,h", "produce help message.");
+    po::positional_options_description pos;
+    pos.add("files", -1);
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(desc).positional(pos).run(), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || files.empty()) {
+        std::cout << std::endl << desc << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    std::vector<int64_t> stepUs;
+    double audioSeconds = 0;
+    double cpuTotal = 0;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto &fname : files) {
+        WavReader wav(fname, hop);
+        if (!wav.isOpen()) {
+            continue;
+        }
+        WhistleDetector detector(&wav, minLength, threshold, window, maxFreq, wisdom);
+        // don't record the replay to /home/nao/whistle/
+        detector.start(false);
+
+        std::cout << fname << ": " << wav.getChannelNum() << " channels, "
+                  << wav.getSampleRate() << " Hz" << std::endl;
+
+        bool prevFound = false;
+        size_t detections = 0;
+        const double cpuStart = cpuSeconds();
+        while (!wav.ended()) {
+            const auto start = std::chrono::steady_clock::now();
+            const bool found = detector.process();
+            const auto end = std::chrono::steady_clock::now();
+            stepUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+            // same edge detection as the Whistle module
+            if (found && !prevFound) {
+                detections++;
+                std::cout << "  whistle at " << wav.position() / wav.getSampleRate() << " s" << std::endl;
+            }
+            prevFound = found;
+        }
+        cpuTotal += cpuSeconds() - cpuStart;
+        audioSeconds += wav.position() / wav.getSampleRate();
+        detector.stop();
+
+        std::cout << "  " << detections << " whistles" << std::endl;
+    }
+
+    if (stepUs.empty()) {
+        return 1;
+    }
+
+    std::cout << std::endl << "hop " << hop << ", window " << window << ", max freq " << maxFreq << " Hz" << std::endl;
+    std::cout << std::endl << "Latency [us]" << std::endl;
+    benchmark::printLatencyHeader("");
+    benchmark::printLatency("step", stepUs);
+    std::cout << std::setprecision(2) << "CPU: " << 100.0 * cpuTotal / audioSeconds
+              << " % of one core for " << audioSeconds << " s of audio" << std::endl;
+
+    return 0;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
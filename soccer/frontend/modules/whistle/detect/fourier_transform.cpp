@@ -3,34 +3,151 @@
  */
 #include "fourier_transform.h"
 
+#include <framework/logger/logger.h>
+#include <framework/util/assert.h>
+
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// log(x) for x >= 0 from the exponent and a short series of the mantissa,
+// absolute error < 1e-6. x = 0 results in about -88 instead of -inf.
+// The SSE version does the same operations as the scalar one.
+constexpr float LN2 = 0.69314718f;
+constexpr float SQRT2 = 1.41421356f;
+
+inline float fastLog(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float e = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    if (m > SQRT2) {
+        m = m - m * 0.5f;
+        e = e + 1.f;
+    }
+    const float t = (m - 1.f) / (m + 1.f);
+    const float t2 = t * t;
+    const float p = t * (2.f + t2 * (2.f / 3.f + t2 * (2.f / 5.f + t2 * (2.f / 7.f))));
+    return e * LN2 + p;
+}
 
-FourierTransform::FourierTransform(float *const input,
-                                   size_t inSize, float sampleRate)
+#if defined(__SSE2__)
+inline __m128 fastLog(__m128 x) {
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                                             _mm_set1_epi32(0x3f800000)));
+    const __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(SQRT2));
+    m = _mm_sub_ps(m, _mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))));
+    const __m128 ef = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_and_ps(big, _mm_set1_ps(1.f)));
+
+    const __m128 t = _mm_div_ps(_mm_sub_ps(m, _mm_set1_ps(1.f)), _mm_add_ps(m, _mm_set1_ps(1.f)));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 p = _mm_add_ps(_mm_set1_ps(2.f / 5.f), _mm_mul_ps(t2, _mm_set1_ps(2.f / 7.f)));
+    p = _mm_add_ps(_mm_set1_ps(2.f / 3.f), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(_mm_set1_ps(2.f), _mm_mul_ps(t2, p));
+    p = _mm_mul_ps(t, p);
+    return _mm_add_ps(_mm_mul_ps(ef, _mm_set1_ps(LN2)), p);
+}
+#endif
+
+// log(|c|) = 0.5 * log(re^2 + im^2)
+void logMagnitude(const fftwf_complex *in, float *out, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= n; i += 4) {
+        const float *c = in[i];
+        const __m128 a = _mm_loadu_ps(c);       // re0 im0 re1 im1
+        const __m128 b = _mm_loadu_ps(c + 4);   // re2 im2 re3 im3
+        const __m128 a2 = _mm_mul_ps(a, a);
+        const __m128 b2 = _mm_mul_ps(b, b);
+        const __m128 power = _mm_add_ps(_mm_shuffle_ps(a2, b2, _MM_SHUFFLE(2, 0, 2, 0)),
+                                        _mm_shuffle_ps(a2, b2, _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_set1_ps(0.5f), fastLog(power)));
+    }
+#endif
+    for (; i < n; i++) {
+        const float power = in[i][0] * in[i][0] + in[i][1] * in[i][1];
+        out[i] = 0.5f * fastLog(power);
+    }
+}
+
+} // namespace
+
+
+FourierTransform::FourierTransform(const float *const input, size_t hopSize,
+                                   size_t windowSize, float sampleRate,
+                                   float maxFreq, const std::string &wisdomFile)
     : _input(input)
-    , _inSize(inSize)
-    , _outSize(inSize / 2 + 1)
-    , _fftwOut(reinterpret_cast<fftwf_complex *>(fftwf_malloc(_outSize * sizeof(fftwf_complex))))
-    , _output(new float[_outSize])
-    , _plan(fftwf_plan_dft_r2c_1d(_inSize, _input, _fftwOut, FFTW_ESTIMATE))
-    , _freqSpacing((sampleRate / 2) / _outSize) {
+    , _hopSize(hopSize)
+    , _windowSize(windowSize)
+    , _window(reinterpret_cast<float *>(fftwf_malloc(_windowSize * sizeof(float))))
+    , _hann(reinterpret_cast<float *>(fftwf_malloc(_windowSize * sizeof(float))))
+    , _fftwIn(reinterpret_cast<float *>(fftwf_malloc(_windowSize * sizeof(float))))
+    , _outSize(0)
+    , _fftwOut(reinterpret_cast<fftwf_complex *>(fftwf_malloc((_windowSize / 2 + 1) * sizeof(fftwf_complex))))
+    , _output(nullptr)
+    , _plan(nullptr)
+    , _freqSpacing(sampleRate / _windowSize) {
+
+    jsassert(_hopSize > 0 && _hopSize <= _windowSize);
+    jsassert(maxFreq > 0);
+
+    // two extra bins, so smoothing still covers maxFreq
+    const size_t maxBin = static_cast<size_t>(std::ceil(maxFreq / _freqSpacing)) + 2;
+    _outSize = std::min(_windowSize / 2 + 1, maxBin);
+    _output = new float[_outSize];
+
+    for (size_t i = 0; i < _windowSize; i++) {
+        _hann[i] = 0.5f - 0.5f * std::cos(2.f * float(M_PI) * i / _windowSize);
+    }
+    reset();
+
+    // measuring overwrites the arrays, so plan before any data is in there
+    unsigned int flags = FFTW_ESTIMATE;
+    if (!wisdomFile.empty()) {
+        fftwf_import_wisdom_from_filename(wisdomFile.c_str());
+        flags = FFTW_MEASURE;
+    }
+    _plan = fftwf_plan_dft_r2c_1d(_windowSize, _fftwIn, _fftwOut, flags);
+    jsassert(_plan != nullptr);
+    if (!wisdomFile.empty() && !fftwf_export_wisdom_to_filename(wisdomFile.c_str())) {
+        LOG_WARN << "FourierTransform: can't write fftw wisdom to " << wisdomFile;
+    }
 }
 
 FourierTransform::~FourierTransform() {
+    fftwf_destroy_plan(_plan);
+    fftwf_free(_window);
+    fftwf_free(_hann);
+    fftwf_free(_fftwIn);
     fftwf_free(_fftwOut);
     delete[] _output;
 }
 
-float FourierTransform::length(const fftwf_complex &c) {
-    return sqrt(pow(c[0], 2) + pow(c[1], 2));
+void FourierTransform::reset() {
+    std::fill(_window, _window + _windowSize, 0.f);
 }
 
 void FourierTransform::execute() {
+    const size_t keep = _windowSize - _hopSize;
+    std::memmove(_window, _window + _hopSize, keep * sizeof(float));
+    std::memcpy(_window + keep, _input, _hopSize * sizeof(float));
+    for (size_t i = 0; i < _windowSize; i++) {
+        _fftwIn[i] = _window[i] * _hann[i];
+    }
+
     fftwf_execute(_plan);
-    std::transform(_fftwOut, _fftwOut + _outSize, _output, 
-            [] (const fftwf_complex &c) { return log(length(c)); });
+    logMagnitude(_fftwOut, _output, _outSize);
 }
 
 // vim: set ts=4 sw=4 sts=4 expandtab:
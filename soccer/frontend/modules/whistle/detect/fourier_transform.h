@@ -5,18 +5,32 @@
 
 #include <fftw3.h>
 
+#include <string>
+
 /**
- * Performs a fourier transform on the input data.
+ * Streaming fourier transform over overlapping, Hann windowed blocks.
+ *
+ * Every execute() appends hopSize new samples to the window and transforms
+ * the last windowSize samples, so a whistle is seen every hopSize samples
+ * while keeping the frequency resolution of windowSize.
+ * Only the log magnitudes of the bins up to maxFreq are computed.
  */
 class FourierTransform {
 
 public:
     /**
-     * @param input: Input signal.
-     * @param inSize: Size of input.
+     * @param input: Input signal, hopSize new samples per execute().
+     * @param hopSize: Number of new samples per execute().
+     * @param windowSize: FFT length, must be >= hopSize.
      * @param sampleRate: Samplerate of input signal.
+     * @param maxFreq: Highest frequency of interest (Unit: Hz).
+     * @param wisdomFile: FFTW wisdom, is loaded before and updated after
+     * planning, so the plan only has to be measured once per robot.
+     * Estimates a plan, if empty.
      */
-    explicit FourierTransform(float *const input, size_t inSize, float sampleRate);
+    explicit FourierTransform(const float *const input, size_t hopSize,
+                              size_t windowSize, float sampleRate,
+                              float maxFreq, const std::string &wisdomFile = "");
     ~FourierTransform();
 
     FourierTransform(const FourierTransform&) = delete;
@@ -24,6 +38,9 @@ public:
 
     void execute();
 
+    // forget previous samples
+    void reset();
+
     const float *output() const {
         return _output;
     }
@@ -36,10 +53,13 @@ public:
     }
 
 private:
-    static inline float length(const fftwf_complex &);
+    const float *_input;
+    size_t _hopSize;
+    size_t _windowSize;
 
-    float *_input;
-    size_t _inSize;
+    float *_window;     // last windowSize samples
+    float *_hann;
+    float *_fftwIn;
 
     size_t _outSize;
     fftwf_complex *_fftwOut;
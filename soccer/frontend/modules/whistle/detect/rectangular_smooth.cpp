@@ -38,7 +38,7 @@ void RectangularSmooth::execute() {
     const float *rectStart = _input;
     for (size_t i = 0; i < _outSize; i++) {
         const float *rectEnd = rectStart + _smoothWidth;
-        _output[i]  = std::accumulate(rectStart, rectEnd, 0);
+        _output[i]  = std::accumulate(rectStart, rectEnd, 0.f);
         _output[i] /= _smoothWidth;
         rectStart++;
     }
@@ -0,0 +1,56 @@
+#include "wavreader.h"
+
+#include <cstdint>
+#include "wavheader.h"
+
+#include <framework/logger/logger.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+WavReader::WavReader(const std::string &fname, size_t bufferSize)
+    : _file(fopen(fname.c_str(), "rb"))
+    , _bufferSize(bufferSize)
+    , _channelNum(1)
+    , _sampleRate(0)
+    , _position(0)
+    , _ended(false) {
+
+    WAV::header header;
+    if (_file == nullptr || fread(&header, sizeof(header), 1, _file) != 1) {
+        LOG_ERROR << "WavReader: can't read " << fname;
+    } else if (std::memcmp(header.id, "RIFF", 4) != 0 || header.pcm != 1 || header.bits_per_sample != 16) {
+        LOG_ERROR << "WavReader: " << fname << " is no 16 bit PCM wav file";
+    } else {
+        _channelNum = header.channels;
+        _sampleRate = header.frequency;
+        _buffer.resize(_bufferSize * _channelNum);
+        return;
+    }
+
+    if (_file != nullptr) {
+        fclose(_file);
+        _file = nullptr;
+    }
+    _buffer.resize(_bufferSize * _channelNum);
+}
+
+WavReader::~WavReader() {
+    if (_file != nullptr) {
+        fclose(_file);
+    }
+}
+
+bool WavReader::fetch() {
+    size_t read = 0;
+    if (_file != nullptr) {
+        read = fread(_buffer.data(), sizeof(int16_t), _buffer.size(), _file);
+    }
+    std::fill(_buffer.begin() + read, _buffer.end(), 0);
+    _position += read / _channelNum;
+    _ended = read < _buffer.size();
+    return !_ended;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "audiostream.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Reads 16 bit PCM audio from a WAV file as written by FileWriter,
+ * bufferSize samples per channel with every fetch().
+ */
+class WavReader : public AudioStream {
+
+public:
+
+    WavReader(const std::string &fname, size_t bufferSize);
+    ~WavReader();
+
+    WavReader(const WavReader&) = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    bool isOpen() const {
+        return _file != nullptr;
+    }
+
+    int16_t *getBuffer() override {
+        return _buffer.data();
+    }
+    size_t getBufferSize() override {
+        return _bufferSize;
+    }
+    short getChannelNum() override {
+        return _channelNum;
+    }
+    double getSampleRate() override {
+        return _sampleRate;
+    }
+    // @return false, if the file ended, the rest of the buffer is zeroed then
+    bool fetch() override;
+    void stop() override {}
+    void start() override {}
+
+    // samples per channel read so far
+    size_t position() const {
+        return _position;
+    }
+
+    // true after the first fetch(), that didn't get a full buffer
+    bool ended() const {
+        return _ended;
+    }
+
+private:
+
+    FILE *_file;
+    std::vector<int16_t> _buffer;
+    size_t _bufferSize;
+    short _channelNum;
+    double _sampleRate;
+    size_t _position;
+    bool _ended;
+
+};
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -13,13 +13,16 @@
 static const std::string logDir{"/home/nao/whistle/"};
 
 WhistleDetector::WhistleDetector(AudioStream* audioProvider,
-                                 const size_t minWhistleLength, const float whistleThreshold)
+                                 const size_t minWhistleLength, const float whistleThreshold,
+                                 const size_t windowSize, const float maxFreq,
+                                 const std::string &wisdomFile)
     : _audioProvider(audioProvider),
       _mergeChannels(_audioProvider->getBuffer(),
                      _audioProvider->getBufferSize(),
                      _audioProvider->getChannelNum()),
       _fourierTransform(_mergeChannels.output(), _mergeChannels.outSize(),
-                        _audioProvider->getSampleRate()),
+                        windowSize, _audioProvider->getSampleRate(), maxFreq,
+                        wisdomFile),
       _rectSmooth(3, _fourierTransform.output(), _fourierTransform.outSize(),
                   _fourierTransform.freqSpacing()),
       _whistleClassifier(_rectSmooth.output(), _rectSmooth.outSize(),
@@ -59,16 +62,18 @@ void WhistleDetector::onlyRecord() {
     _fileWriter.write();
 }
 
-void WhistleDetector::start() {
+void WhistleDetector::start(bool record) {
     jsassert(!_running);
     _audioProvider->start();
 
-    struct timespec tv;
-    clock_gettime(CLOCK_REALTIME, &tv);
-    mkdir(logDir.c_str(), 0755);
-    std::string fname{logDir};
-    fname += std::to_string(tv.tv_sec) + ".wav";
-    _fileWriter.open(fname);
+    if (record) {
+        struct timespec tv;
+        clock_gettime(CLOCK_REALTIME, &tv);
+        mkdir(logDir.c_str(), 0755);
+        std::string fname{logDir};
+        fname += std::to_string(tv.tv_sec) + ".wav";
+        _fileWriter.open(fname);
+    }
 
     _running = true;
 }
@@ -78,5 +83,6 @@ void WhistleDetector::stop() {
     _fileWriter.close();
     _audioProvider->stop();
     _whistleClassifier.reset();
+    _fourierTransform.reset();
     _running = false;
 }
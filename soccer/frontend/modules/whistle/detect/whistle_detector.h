@@ -11,12 +11,20 @@
 #include "whistle_classifier.h"
 
 #include <fftw3.h>
+#include <string>
 
 class WhistleDetector {
 
    public:
+    /**
+     * @param windowSize: FFT length in samples, every fetched audio buffer
+     * is one hop, so windows overlap if windowSize > buffer size.
+     * @param maxFreq: Only frequencies up to maxFreq are evaluated (Unit: Hz).
+     * @param wisdomFile: FFTW wisdom file, see FourierTransform.
+     */
     WhistleDetector(AudioStream*, const size_t minWhistleLength,
-                    const float whistleThreshold);
+                    const float whistleThreshold, const size_t windowSize,
+                    const float maxFreq, const std::string &wisdomFile = "");
 
     bool process();
 
@@ -24,8 +32,10 @@ class WhistleDetector {
 
     /**
      * Start whistle detection. Must be called before calling process.
+     * @param record: Write the audio to /home/nao/whistle/<timestamp>.wav,
+     * onlyRecord() needs this.
      */
-    void start();
+    void start(bool record = true);
 
     void stop();
 
@@ -8,12 +8,23 @@
 #include <framework/thread/util.h>
 
 static constexpr TimestampMs RECORD_ONLY_TIME = 5000;
-static constexpr size_t MIN_WHISTLE_LENGTH = 600;
 static constexpr float WHISTLE_THRESHOLD = 2500;
+// 512 new samples per step, FFT over the last 1024 (50% overlap)
+static constexpr size_t WHISTLE_HOP = 512;
+static constexpr size_t WHISTLE_WINDOW = 1024;
+// The classifier adds up the new samples of consecutive positive steps. One
+// positive 1024 sample window is a whistle, like with the former 1024 sample
+// buffers and a minimum of 600, so one hop is enough.
+static constexpr size_t MIN_WHISTLE_LENGTH = WHISTLE_HOP;
+// whistles are below, ignore high frequency noise
+static constexpr float WHISTLE_MAX_FREQ = 5000;
 
 void Whistle::setup() {
-    recorder = std::make_shared<AlsaRecorder>(AlsaRecorder::V5_SETTINGS_41000_STEREO);
-    detector = std::make_shared<WhistleDetector>(recorder.get(), MIN_WHISTLE_LENGTH, WHISTLE_THRESHOLD);
+    AlsaRecorder::Settings alsa = AlsaRecorder::V5_SETTINGS_41000_STEREO;
+    alsa.bufferSize = WHISTLE_HOP;
+    recorder = std::make_shared<AlsaRecorder>(alsa);
+    detector = std::make_shared<WhistleDetector>(recorder.get(), MIN_WHISTLE_LENGTH, WHISTLE_THRESHOLD,
+            WHISTLE_WINDOW, WHISTLE_MAX_FREQ, settings->configPath + "whistle.wisdom");
     cmds.connect<bbapi::WhistleRecordOnlyT, &Whistle::onRecordOnly>(this);
     cmds.connect<bbapi::WhistleStartT, &Whistle::onStart>(this);
     cmds.connect<bbapi::WhistleStopT, &Whistle::onStop>(this);
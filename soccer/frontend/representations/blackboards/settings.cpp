@@ -25,6 +25,7 @@ SettingsBlackboard::SettingsBlackboard() : Blackboard("RobotSettings") {
     INIT_VAR(docker, false, "running simulator inside docker container?");
 
     INIT_VAR_RW(logImages, false, "flag, which decides to save images");
+    INIT_VAR_RW(logRawImages, false, "with logImages, also save the raw YUYV frames (*.yuv, input of vision_replay)");
     INIT_VAR_RW(logImagesInterval,
             camera::fps,
             "write every Nth image (1: store all images, 2: skip every other image, etc..)");
@@ -65,6 +66,7 @@ bool SettingsBlackboard::loadConfig(ConfigFiles &fcfg) {
 
     READ_KEY(cfg, logToFile, bool);
     READ_KEY_TRY(cfg, logImages, bool);
+    READ_KEY_TRY(cfg, logRawImages, bool);
     READ_KEY_TRY(cfg, logImagesInterval, int);
     READ_KEY_TRY(cfg, logPath, std::string);
 
@@ -96,6 +98,7 @@ bool SettingsBlackboard::writeConfig(ConfigFiles &fcfg) {
     WRITE_KEY(cfg, logToFile, bool);
     WRITE_KEY(cfg, logPath, std::string);
     WRITE_KEY(cfg, logImages, bool);
+    WRITE_KEY(cfg, logRawImages, bool);
     WRITE_KEY(cfg, logImagesInterval, int);
     WRITE_KEY_ENUM(cfg, fieldSize);
     WRITE_KEY_VALUE(cfg, jerseyNumber, id + 1, int);
@@ -113,6 +116,7 @@ void SettingsBlackboard::logSettings() {
             << "role=" << roleToStr(role) << ";"
             << "logToFile=" << logToFile << ";"
             << "logImages=" << logImages << ";"
+            << "logRawImages=" << logRawImages << ";"
             << "logImagesInterval=" << logImagesInterval << ";"
             << "simulator=" << simulator;
 }
@@ -121,6 +125,7 @@ std::ostream &operator<<(std::ostream &s, const SettingsBlackboard *rhs) {
     s << "current framework blackboard content:\n";
     s << "  logToFile:           " << rhs->logToFile << "\n";
     s << "  logImages:           " << rhs->logImages << "\n";
+    s << "  logRawImages:        " << rhs->logRawImages << "\n";
     s << "  logImagesInterval:   " << rhs->logImagesInterval << "\n";
     s << "  fieldSize:           " << int(rhs->fieldSize) << "\n";
     s << "  id:                  " << rhs->id << "\n";
@@ -31,6 +31,7 @@ public:
     MAKE_VAR(bool, docker);
     MAKE_VAR(bool, logToFile);
     MAKE_VAR(bool, logImages);
+    MAKE_VAR(bool, logRawImages);
     MAKE_VAR(int,  logImagesInterval);
     MAKE_VAR(FieldSize, fieldSize);
     MAKE_VAR(int, id);
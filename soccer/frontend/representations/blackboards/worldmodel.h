@@ -1,6 +1,8 @@
 #pragma once
 #include <array>
 #include <framework/blackboard/blackboard.h>
+#include <framework/blackboard/snapshot.h>
+#include <framework/rt/message_utils.h>
 #include <framework/math/coord.h>
 #include "../worldmodel/definitions.h"
 
@@ -60,3 +62,5 @@ public:
     MAKE_VAR(float, ballFilterMaxTimeInterval);      //!< how old has our data to be to reset the filterx
 
 };
+
+RT_LOCKFREE_CHANNEL(Snapshot<WorldModelBlackboard>);
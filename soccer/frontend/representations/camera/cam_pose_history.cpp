@@ -0,0 +1,111 @@
+#include "cam_pose_history.h"
+
+#include <cmath>
+#include <Eigen/Geometry>
+
+namespace {
+
+// CamPose::r holds roll, pitch, yaw of R = Rz(yaw) * Ry(pitch) * Rx(roll)
+Eigen::Quaternionf toQuaternion(const Eigen::Vector3f &r) {
+    return Eigen::AngleAxisf(r[2], Eigen::Vector3f::UnitZ()) *
+           Eigen::AngleAxisf(r[1], Eigen::Vector3f::UnitY()) *
+           Eigen::AngleAxisf(r[0], Eigen::Vector3f::UnitX());
+}
+
+// inverse of toQuaternion(), same as CameraPose::getAnglesFromMatrix()
+Eigen::Vector3f toAngles(const Eigen::Quaternionf &q) {
+    const Eigen::Matrix3f R = q.toRotationMatrix();
+    return {std::atan2(R(2, 1), R(2, 2)), std::asin(-R(2, 0)), std::atan2(R(1, 0), R(0, 0))};
+}
+
+// sequence number of an entry, once sample n is completely written
+constexpr uint64_t written(uint64_t n) {
+    return 2 * n + 2;
+}
+
+} // namespace
+
+void CamPoseHistory::push(int64_t timestamp, const CamPose &top, const CamPose &bottom) {
+    const uint64_t n = count.load(std::memory_order_relaxed);
+    Entry &e = entries[n % CAPACITY];
+
+    e.seq.store(written(n) - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    e.sample.timestamp = timestamp;
+    e.sample.top = top;
+    e.sample.bottom = bottom;
+    e.seq.store(written(n), std::memory_order_release);
+
+    count.store(n + 1, std::memory_order_release);
+}
+
+bool CamPoseHistory::read(uint64_t n, Sample &out) const {
+    const Entry &e = entries[n % CAPACITY];
+    const uint64_t seq = e.seq.load(std::memory_order_acquire);
+    if (seq != written(n)) {
+        return false;
+    }
+    out = e.sample;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return e.seq.load(std::memory_order_relaxed) == seq;
+}
+
+bool CamPoseHistory::lookup(int64_t timestamp, Sample &out) const {
+    for (;;) {
+        const uint64_t c = count.load(std::memory_order_acquire);
+        if (c == 0) {
+            return false;
+        }
+
+        // the oldest entry is skipped, it is the next one to be overwritten
+        const uint64_t oldest = (c > CAPACITY) ? c - CAPACITY + 1 : 0;
+        const uint64_t newest = c - 1;
+
+        Sample after;
+        if (!read(newest, after)) {
+            // overwritten CAPACITY times while we were here, start over
+            continue;
+        }
+        if (timestamp >= after.timestamp) {
+            out = after;
+            return true;
+        }
+
+        // first sample after timestamp, overwritten samples are older than any valid one
+        uint64_t lo = oldest, hi = newest;
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            Sample s;
+            if (read(mid, s) && s.timestamp > timestamp) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+
+        Sample before;
+        if (!read(lo, after)) {
+            continue;
+        }
+        if (lo == oldest || !read(lo - 1, before)) {
+            out = after;
+            return true;
+        }
+
+        const int64_t span = after.timestamp - before.timestamp;
+        const float t = (span > 0) ? static_cast<float>(timestamp - before.timestamp) / span : 1.f;
+        out.timestamp = timestamp;
+        out.top = interpolate(before.top, after.top, t);
+        out.bottom = interpolate(before.bottom, after.bottom, t);
+        return true;
+    }
+}
+
+CamPose CamPoseHistory::interpolate(const CamPose &a, const CamPose &b, float t) {
+    CamPose result;
+    result.v = a.v + t * (b.v - a.v);
+    result.r = toAngles(toQuaternion(a.r).slerp(t, toQuaternion(b.r)));
+    return result;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "cam_pose_struct.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Camera poses of the last LoLa cycles, indexed by lola_timestamp.
+ *
+ * The motion thread appends the poses of every cycle, any other thread may
+ * look up the poses at an image timestamp concurrently. Entries are
+ * protected by a sequence counter each, readers retry when the writer
+ * overwrote an entry while they copied it, so neither side ever blocks.
+ */
+class CamPoseHistory {
+public:
+    // ~0.75s of LoLa cycles, far more than an image waits for its pose
+    static constexpr size_t CAPACITY{64};
+
+    struct Sample {
+        int64_t timestamp{0};
+        CamPose top;
+        CamPose bottom;
+    };
+
+    /**
+     * append the poses of a new cycle, motion thread only
+     * @param timestamp lola_timestamp of the cycle, must not decrease
+     */
+    void push(int64_t timestamp, const CamPose &top, const CamPose &bottom);
+
+    /**
+     * camera poses at timestamp, interpolated between the surrounding cycles:
+     * positions linearly, rotations by SLERP. Outside of the history the oldest
+     * or newest poses are used, out.timestamp tells which time they belong to.
+     * @return false, if no poses have been pushed yet
+     */
+    bool lookup(int64_t timestamp, Sample &out) const;
+
+    // interpolate a pose, t = 0 returns a, t = 1 returns b
+    static CamPose interpolate(const CamPose &a, const CamPose &b, float t);
+
+private:
+    struct Entry {
+        // odd while the entry is written
+        std::atomic<uint64_t> seq{0};
+        Sample sample;
+    };
+
+    std::array<Entry, CAPACITY> entries;
+    // number of samples pushed so far, sample n lives in entries[n % CAPACITY]
+    std::atomic<uint64_t> count{0};
+
+    // copy sample n, false if it has been overwritten meanwhile
+    bool read(uint64_t n, Sample &out) const;
+};
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
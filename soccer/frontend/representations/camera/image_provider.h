@@ -9,10 +9,11 @@ public:
     ImageBuffer top;
     ImageBuffer bottom;
 
-    CamImage getImage(const int &camera) {
+    // most recent image of camera, locked with lt
+    CamImage getImage(const int &camera, ImgLock lt) {
         if (TOP_CAMERA == camera)
-            return top.getImage();
+            return top.getImage(lt);
         else
-            return bottom.getImage();
+            return bottom.getImage(lt);
     }
 };
\ No newline at end of file
@@ -2,10 +2,11 @@
 #include <memory>
 #include <framework/image/camimage.h>
 #include <framework/util/clock.h>
+#include <framework/rt/message_utils.h>
 #include <framework/datastructures/mpsc_storage.h>
-#include <opencv2/imgcodecs.hpp>
 #include <vector>
 #include "framework/image/rgb.h"
+#include "framework/image/jpeg.h"
 #include "visiondefinitions.h"
 #include "visioncontext.h"
 
@@ -32,7 +33,7 @@ struct VisionImage : public VisionImageBase {
 };
 
 struct VisionImageProcessed {
-    using jpeg_t = std::vector<u_char>;
+    using jpeg_t = jpeg::buffer_t;
     using vr_t = std::vector<VisionResult>;
 
     size_t width;
@@ -54,7 +55,8 @@ struct VisionImageProcessed {
     cv::Vec<float, 5> distCoeffs;
 
     std::shared_ptr<vr_t> results;
-    std::shared_ptr<jpeg_t> jpeg;
+    // camera frame, only encoded when a consumer asks for it
+    std::shared_ptr<jpeg::LazyFrame> frame;
 
     VisionImageProcessed() = default;
 
@@ -74,11 +76,21 @@ struct VisionImageProcessed {
       , _eulers(img._eulers)
       , cameraMatrix(img.cameraMatrix)
       , distCoeffs(img.distCoeffs) {
-        std::vector<int> parms{cv::IMWRITE_JPEG_QUALITY, 80};
-        jpeg = std::make_shared<jpeg_t>();
-        cv::imencode(".jpg", img.toRGB().mat(), *jpeg, parms);
+        frame = std::make_shared<jpeg::LazyFrame>(img);
 
         results = std::make_shared<vr_t>();
         *results = vr;
     }
+
+    // JPEG at 1/scale resolution (quality 0: default), blocks until it's encoded
+    jpeg::buffer_ptr getJpeg(int scale = 1, int quality = 0) const { return frame->get(scale, quality); }
+
+    // start encoding in the background, so getJpeg() doesn't have to wait later
+    void prefetchJpeg(int scale = 1, int quality = 0) const { frame->prefetch(scale, quality); }
+
+    // raw YUYV frame (width x height), shared by all consumers, valid as long as this is
+    const uint8_t *yuyv() const { return frame->yuyv(); }
 };
+
+// listeners (debug server, logger, referee gesture) only need recent frames
+RT_SNOOP_POLICY(VisionImageProcessed, 4, DropOldest);
@@ -2,6 +2,7 @@
 
 #include <iosfwd>
 #include <framework/serialize/serializer.h>
+#include <framework/rt/message_utils.h>
 
 #define PERFECT_COLOR_BALL 220
 #define PERFECT_COLOR_FIELD 100
@@ -161,4 +162,6 @@ SERIALIZE(std::vector<VisionResult>, {
 
 using VisionResultVec = std::vector<VisionResult>;
 
+RT_LOCKFREE_CHANNEL(VisionResultVec);
+
 // vim: set ts=4 sw=4 sts=4 expandtab:
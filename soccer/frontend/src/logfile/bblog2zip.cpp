@@ -0,0 +1,74 @@
+/**
+ * Converts an append-only .bblog file written by LogFileIO into a ZIP archive.
+ *
+ * usage: bblog2zip <log.bblog> [log.zip]
+ */
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <libzippp/libzippp.h>
+
+#include "logstream.h"
+
+namespace fs = std::filesystem;
+using libzippp::ZipArchive;
+
+static constexpr uint32_t ZIP_COMPRESSION_LEVEL{3};
+
+// libzippp only reads added data on close(), so it is written in chunks to bound memory usage
+static constexpr size_t CHUNK_SIZE{64 << 20};
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <log.bblog> [log.zip]" << std::endl;
+        return 1;
+    }
+
+    const fs::path in{argv[1]};
+    const fs::path out{(argc > 2) ? fs::path(argv[2]) : fs::path(in).replace_extension(".zip")};
+
+    logstream::Reader log(in);
+    if (!log.valid()) {
+        std::cerr << in << " is not a bblog file" << std::endl;
+        return 1;
+    }
+
+    ZipArchive zip(out);
+    std::deque<std::vector<uint8_t>> chunk;
+    size_t chunkSize{0}, records{0};
+
+    std::string name;
+    std::vector<uint8_t> data;
+    bool more{true};
+    while (more) {
+        if (!zip.open(ZipArchive::Write)) {
+            std::cerr << "unable to open " << out << std::endl;
+            return 1;
+        }
+
+        while ((more = log.next(name, data))) {
+            // images are stored uncompressed, as before
+            const bool isImage{fs::path(name).extension() == ".jpg"};
+            zip.setCompressionMethod(isImage ? libzippp::STORE : libzippp::DEFLATE);
+            zip.setCompressionLevel(ZIP_COMPRESSION_LEVEL);
+
+            chunk.push_back(std::move(data));
+            zip.addData(name, chunk.back().data(), chunk.back().size());
+            chunkSize += chunk.back().size();
+            ++records;
+
+            if (chunkSize > CHUNK_SIZE)
+                break;
+        }
+
+        zip.close();
+        chunk.clear();
+        chunkSize = 0;
+    }
+
+    std::cout << "converted " << records << " records to " << out << std::endl;
+    return 0;
+}
@@ -9,6 +9,7 @@
 #include <framework/thread/util.h>
 #include <framework/util/frame.h>
 #include <framework/rt/kernel.h>
+#include <framework/rt/trace.h>
 #include <representations/motion/body_state.h>
 #include <representations/flatbuffers/flatbuffers.h>
 #include <flatbuffers/minireflect.h>
@@ -26,6 +27,7 @@ using bbapi::Penalty;
  * <tick>/<output_name>.bin
  * <tick>/topcam.<ext>
  * <tick>/botcam.<ext>
+ * <tick>/trace.json (chrome trace / perfetto, module timing since previous trace.json)
  **/
 
 void LogFile::load(rt::Kernel &soccer) {
@@ -47,6 +49,8 @@ void LogFile::setup() {
         return;
     }
     LOG_INFO << "logfile: logToFile enabled";
+    rt::Tracer::enable(true);
+    lastTrace = std::chrono::steady_clock::now();
 }
 
 void LogFile::process() {
@@ -70,6 +74,22 @@ void LogFile::process() {
         auto module = loggers->getModule(logger);
         logger->consume_all([=](rt::LogData data) { this->on_logdata(module, data); });
     }
+
+    write_trace();
+}
+
+void LogFile::write_trace() {
+    auto now = std::chrono::steady_clock::now();
+    if (not log_enabled || now - lastTrace < traceInterval) {
+        return;
+    }
+    lastTrace = now;
+
+    rt::TraceChunk chunk;
+    if (rt::Tracer::consume(chunk)) {
+        LOG_WARN_IF(rt::Tracer::dropped() > 0) << "logfile: " << rt::Tracer::dropped() << " trace events dropped";
+        out.emit(LogFileContext(tickDir / "trace.json", rt::LogData(chunk)));
+    }
 }
 
 void LogFile::on_logdata(const rt::ModuleMeta &module, rt::LogData &data) {
@@ -104,8 +124,15 @@ void LogFile::on_log_image(
         imageFileName << "-bottom";
     imageFileName << ".jpg";
 
+    // encode while the context waits in the writer queue
+    image->prefetchJpeg();
+
     auto imagePath = tickDir / imageFileName.str();
     out.emit(LogFileContext(imagePath, data));
+
+    if (settings->logRawImages) {
+        out.emit(LogFileContext(imagePath.replace_extension(".yuv"), data));
+    }
 }
 
 void LogFile::on_log_refereegesture(
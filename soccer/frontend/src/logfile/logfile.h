@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <filesystem>
+#include <chrono>
 
 #include <framework/rt/module.h>
 #include <representations/blackboards/settings.h>
@@ -27,6 +28,7 @@ public:
 
 private:
     static constexpr std::string_view ticksPath{"ticks"};
+    static constexpr std::chrono::milliseconds traceInterval{1000};
     LogFileIO io;
 
     rt::Context<rt::LogDataContext, rt::Write> loggers;
@@ -41,9 +43,12 @@ private:
     size_t tick = 0;
     std::filesystem::path tickDir;
 
+    std::chrono::steady_clock::time_point lastTrace;
+
     std::error_code filesystem_error;
 
     void on_logdata(const rt::ModuleMeta &, rt::LogData &);
+    void write_trace();
     void on_log_image(const rt::ModuleMeta &, rt::LogData &, rt::LogDataContainer<VisionImageProcessed> &);
     void on_log_refereegesture(
             const rt::ModuleMeta &module, rt::LogData &data, rt::LogDataContainer<RefereeGestureDebug> &image);
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <framework/rt/logdata/logdata.h>
+#include <framework/rt/message_utils.h>
 
 class LogFileContext {
 public:
@@ -12,4 +13,7 @@ public:
         : path(path), data(data) {
 
     }
-};
\ No newline at end of file
+};
+
+// about ten frames of log data, if the writer falls further behind the oldest data is dropped
+RT_SNOOP_POLICY(LogFileContext, 1024, DropOldest);
@@ -1,9 +1,9 @@
 #include "logfileio.h"
 
-#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 
-#include <libzippp.h>
 #include <representations/vision/image.h>
 #include <framework/logger/logger.h>
 
@@ -13,20 +13,14 @@
 
 #include <modules/refereegesture/refereegesture.h>
 
-static constexpr uint32_t ZIP_COMPRESSION_LEVEL{3};
-static constexpr libzippp::CompressionMethod ZIP_COMPRESSION{libzippp::DEFLATE};
-static constexpr uint8_t PNG_COMPRESSION_LVL{2};
 static constexpr uint8_t JPEG_QUALITY{80};
+// batches collect this long, a full staging buffer is handed over earlier
+static constexpr std::chrono::milliseconds FLUSH_INTERVAL{500};
 
 namespace fs = std::filesystem;
-using libzippp::ZipArchive;
 
 LogFileIO::~LogFileIO() {
-    close();
-    if (zip) {
-        delete zip;
-        zip = nullptr;
-    }
+    log.close();
 }
 
 void LogFileIO::connect(rt::Linker &link) {
@@ -39,36 +33,35 @@ void LogFileIO::setup() {
     if (!settings->logToFile)
         return;
 
-    fs::path zippath = settings->logPath;
+    fs::path logpath = settings->logPath;
     std::error_code filesystem_error;
-    if (!fs::is_directory(zippath, filesystem_error)) {
-        if (!fs::create_directories(zippath, filesystem_error)) {
-            LOG_WARN << "logfileio: unable to create log directory " << zippath;
+    if (!fs::is_directory(logpath, filesystem_error)) {
+        if (!fs::create_directories(logpath, filesystem_error)) {
+            LOG_WARN << "logfileio: unable to create log directory " << logpath;
             return;
         }
     }
 
-    std::stringstream zipname;
+    // append-only log, convert to ZIP with bblog2zip
+    std::stringstream logname;
     auto now = std::chrono::system_clock::now();
     auto in_time_t = std::chrono::system_clock::to_time_t(now);
-    zipname << settings->nameToStr(settings->name);
-    zipname << "_" << std::put_time(std::localtime(&in_time_t), "%F-%H%M%S") << ".zip";
-    zippath /= zipname.str();
-
-    zip = new ZipArchive(zippath);
-    if (not zip->open(ZipArchive::Write)) {
-        LOG_WARN << "logfileio: unable to create ZIP file " << zippath;
-        delete zip;
-        zip = nullptr;
+    logname << settings->nameToStr(settings->name);
+    logname << "_" << std::put_time(std::localtime(&in_time_t), "%F-%H%M%S") << ".bblog";
+    logpath /= logname.str();
+
+    if (not log.open(logpath)) {
+        LOG_WARN << "logfileio: unable to create log file " << logpath;
         return;
     }
 
     // add config files to log
-    zip->setCompressionMethod(ZIP_COMPRESSION);
-    zip->setCompressionLevel(ZIP_COMPRESSION_LEVEL);
-    for (const auto &f : {"bembelbots.json", "calibration.json"})
-        zip->addFile(std::string("config/") + f, settings->configPath + f);
-    close();
+    for (const auto &f : {"bembelbots.json", "calibration.json"}) {
+        std::ifstream in(settings->configPath + f, std::ios::binary);
+        const std::vector<char> content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        log.write(std::string("config/") + f, content.data(), content.size());
+    }
+    log.flush();
 }
 
 void LogFileIO::process() {
@@ -76,72 +69,68 @@ void LogFileIO::process() {
 
     logdata.waitWhileEmpty();
 
-    if (!zip)
+    if (!log.isOpen())
         return;
 
-    if (zip->open(ZipArchive::Write)) {
-        auto data = logdata.fetch();
-        for (auto &context : data) {
-            auto &context_data = context.data;
-            context_data.handle<VisionImageProcessed>(std::bind(&LogFileIO::on_log_image, this, _1, _2), context.path);
-            context_data.handle<RefereeGestureDebug>(
-                    std::bind(&LogFileIO::on_log_refereegesture, this, _1, _2), context.path);
+    auto data = logdata.fetch();
+    if (logdata.dropped() != dropped) {
+        LOG_WARN << "logfileio: " << logdata.dropped() - dropped << " log entries dropped, writer can't keep up";
+        dropped = logdata.dropped();
+    }
 
-            if (context_data.is_handled() || not context_data->is_serializeable()) {
-                continue;
-            }
+    for (auto &context : data) {
+        auto &context_data = context.data;
+        context_data.handle<VisionImageProcessed>(std::bind(&LogFileIO::on_log_image, this, _1, _2), context.path);
+        context_data.handle<RefereeGestureDebug>(
+                std::bind(&LogFileIO::on_log_refereegesture, this, _1, _2), context.path);
 
-            auto [size, content] = context_data->serialize();
-            zipWrite(context.path, content, size, false, ZIP_COMPRESSION);
+        if (context_data.is_handled() || not context_data->is_serializeable()) {
+            continue;
         }
-        close();
+
+        // flatbuffer builder is reused, so the data is copied to the staging buffer
+        auto [size, content] = context_data->serialize();
+        log.write(context.path.native(), content, size);
     }
-}
 
-void LogFileIO::on_log_image(std::filesystem::path path, rt::LogDataContainer<VisionImageProcessed> &image) {
-    if (zip) {
-        // copy image buffer, so libzippp may free it, after data is written.
-        // Use malloc() instead of new, since free() is called from libzip C-API
-        auto &jpeg{*image->jpeg};
-        void *imgbuf = malloc(jpeg.size());
-        memcpy(imgbuf, jpeg.data(), jpeg.size());
-        zipWrite(path.c_str(), imgbuf, jpeg.size(), true, libzippp::STORE); // store images uncompressed
+    // hand batch to I/O thread, unless it is still writing the previous one
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastFlush >= FLUSH_INTERVAL && log.tryFlush()) {
+        lastFlush = now;
     }
 }
 
-void LogFileIO::on_log_refereegesture(std::filesystem::path path, rt::LogDataContainer<RefereeGestureDebug> &image) {
-    std::vector<int> parms{cv::IMWRITE_JPEG_QUALITY, 80};
-    std::vector<u_char> jpeg;
-    cv::imencode(path, image->img, jpeg, parms);
-
-    void *imgbuf = malloc(jpeg.size());
-    memcpy(imgbuf, jpeg.data(), jpeg.size());
-    zipWrite(path.c_str(), imgbuf, jpeg.size(), true, libzippp::STORE); // store images uncompressed
+// raw frame in the layout of CamImage::write(), as read by vision_replay
+static logstream::shared_buffer rawFrame(const VisionImageProcessed &image) {
+    const uint8_t *yuyv = image.yuyv();
+    auto buffer = std::make_shared<std::vector<uint8_t>>(yuyv, yuyv + image.width * image.height * YuvImage::channels);
+    auto append = [&buffer](float value) {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        buffer->insert(buffer->end(), bytes, bytes + sizeof(value));
+    };
+    for (int i = 0; i < image._eulers.v.size(); i++) {
+        append(image._eulers.v[i]);
+    }
+    for (int i = 0; i < image._eulers.r.size(); i++) {
+        append(image._eulers.r[i]);
+    }
+    append(image.principalPointX);
+    append(image.principalPointY);
+    return buffer;
 }
 
-void LogFileIO::close() {
-    if (!zip)
+void LogFileIO::on_log_image(std::filesystem::path path, rt::LogDataContainer<VisionImageProcessed> &image) {
+    if (path.extension() == ".yuv") {
+        log.write(path.native(), rawFrame(image.data));
         return;
-
-    try {
-        // file is not actually written, until ZipArchive::close() is called,
-        // so this might throw, if file can't be written
-        zip->close();
-    } catch (std::exception &e) {
-        LOG_ERROR << "logfileio: error writing to ZIP file " << zip->getPath();
-        zip->discard();
-        delete zip;
-        zip = nullptr;
     }
+    // zero copy, the writer keeps a reference to the shared JPEG buffer until it is on disk
+    log.write(path.native(), image->getJpeg());
 }
 
-bool LogFileIO::zipWrite(const std::string &fname, const void *data, size_t length, const bool freeData,
-        const libzippp::CompressionMethod &cm) {
-    if (!zip || !zip->open(ZipArchive::Write))
-        return false;
-
-    zip->setCompressionMethod(cm);
-    zip->setCompressionLevel(ZIP_COMPRESSION_LEVEL);
-
-    return zip->addData(fname, data, length, freeData);
+void LogFileIO::on_log_refereegesture(std::filesystem::path path, rt::LogDataContainer<RefereeGestureDebug> &image) {
+    std::vector<int> parms{cv::IMWRITE_JPEG_QUALITY, JPEG_QUALITY};
+    auto jpeg = std::make_shared<std::vector<u_char>>();
+    cv::imencode(path, image->img, *jpeg, parms);
+    log.write(path.native(), std::move(jpeg));
 }
@@ -2,11 +2,11 @@
 
 #include "logfilecontext.h"
 
+#include <chrono>
 #include <memory>
 #include <filesystem>
 
-#include <zip.h>
-#include <libzippp/libzippp.h>
+#include "logstream.h"
 
 #include <framework/rt/module.h>
 #include <representations/bembelbots/types.h>
@@ -26,19 +26,16 @@ public:
     void process() override;
 
 private:
-    libzippp::ZipArchive *zip{nullptr};
+    logstream::Writer log;
 
     rt::Context<SettingsBlackboard> settings;
     rt::Input<LogFileContext, rt::Snoop> logdata;
+    uint64_t dropped{0};
+    std::chrono::steady_clock::time_point lastFlush;
 
     std::filesystem::path tickDir;
     std::filesystem::path ticksPath;
 
     void on_log_image(std::filesystem::path path, rt::LogDataContainer<VisionImageProcessed> &);
     void on_log_refereegesture(std::filesystem::path path, rt::LogDataContainer<RefereeGestureDebug> &);
-
-    void close();
-
-    bool zipWrite(const std::string &fname, const void *data, size_t length, const bool freeData = false,
-            const libzippp::CompressionMethod &cm = libzippp::DEFAULT);
 };
@@ -0,0 +1,245 @@
+#include "logstream.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include <framework/logger/logger.h>
+
+namespace logstream {
+
+static constexpr size_t ENTRIES_RESERVED{1024};
+
+Writer::Batch::Batch(size_t size)
+  : staging(new uint8_t[size]) {
+    entries.reserve(ENTRIES_RESERVED);
+}
+
+void Writer::Batch::clear() {
+    used = 0;
+    // keeps capacity, drops references to shared buffers
+    entries.clear();
+}
+
+Writer::Writer(size_t stagingSize)
+  : stagingSize(stagingSize)
+  , active(std::make_unique<Batch>(stagingSize))
+  , pending(std::make_unique<Batch>(stagingSize)) {
+    iov.reserve(2 * ENTRIES_RESERVED);
+}
+
+Writer::~Writer() {
+    close();
+}
+
+bool Writer::open(const std::filesystem::path &p) {
+    close();
+
+    fd = ::open(p.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_ERROR << "logstream: unable to create " << p << ": " << strerror(errno);
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    if (::write(fd, &header, sizeof(header)) != sizeof(header)) {
+        LOG_ERROR << "logstream: unable to write " << p << ": " << strerror(errno);
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    path = p;
+    fileOffset = sizeof(header);
+    syncedOffset = 0;
+    failed = false;
+    running = true;
+    worker = std::thread(&Writer::run, this);
+    return true;
+}
+
+void Writer::close() {
+    if (fd < 0)
+        return;
+
+    flush();
+    {
+        std::scoped_lock lock(mtx);
+        running = false;
+    }
+    onPending.notify_one();
+    worker.join();
+
+    ::fsync(fd);
+    ::close(fd);
+    fd = -1;
+}
+
+void Writer::write(std::string_view name, const void *data, size_t length) {
+    if (fd < 0)
+        return;
+
+    std::unique_lock lock(mtx);
+    if (sizeof(RecordHeader) + name.size() + length > stagingSize) {
+        // does not fit into staging buffer at all, write from a copy on the heap instead
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        stage(lock, name, length, 0, std::make_shared<const std::vector<uint8_t>>(bytes, bytes + length));
+        return;
+    }
+
+    uint8_t *dst{stage(lock, name, length, length, nullptr)};
+    std::memcpy(dst, data, length);
+}
+
+void Writer::write(std::string_view name, shared_buffer data) {
+    if (fd < 0 || !data)
+        return;
+
+    const size_t length{data->size()};
+    std::unique_lock lock(mtx);
+    stage(lock, name, length, 0, std::move(data));
+}
+
+void Writer::flush() {
+    if (fd < 0)
+        return;
+
+    std::unique_lock lock(mtx);
+    swapBatches(lock);
+}
+
+bool Writer::tryFlush() {
+    if (fd < 0)
+        return false;
+
+    std::unique_lock lock(mtx);
+    if (hasPending)
+        return false;
+    swapBatches(lock);
+    return true;
+}
+
+uint8_t *Writer::stage(std::unique_lock<std::mutex> &lock, std::string_view name, uint64_t dataLength,
+        size_t copyLength, shared_buffer data) {
+    // names are paths inside the log, so this only truncates garbage
+    name = name.substr(0, UINT16_MAX);
+
+    const size_t length{sizeof(RecordHeader) + name.size() + copyLength};
+    if (active->used + length > stagingSize) {
+        // staging buffer full, blocks until the I/O thread is done with the previous batch
+        swapBatches(lock);
+    }
+
+    Batch &b{*active};
+    uint8_t *dst{b.staging.get() + b.used};
+
+    RecordHeader header{RECORD_MAGIC, 0, static_cast<uint16_t>(name.size()), dataLength};
+    std::memcpy(dst, &header, sizeof(header));
+    std::memcpy(dst + sizeof(header), name.data(), name.size());
+
+    b.entries.push_back({b.used, length, std::move(data)});
+    b.used += length;
+
+    return dst + sizeof(header) + name.size();
+}
+
+void Writer::swapBatches(std::unique_lock<std::mutex> &lock) {
+    if (active->empty())
+        return;
+
+    onWritten.wait(lock, [this]() { return !hasPending; });
+    std::swap(active, pending);
+    hasPending = true;
+    onPending.notify_one();
+}
+
+void Writer::run() {
+    std::unique_lock lock(mtx);
+    while (true) {
+        onPending.wait(lock, [this]() { return hasPending || !running; });
+        if (!hasPending)
+            return;
+
+        // callers only touch the active batch, so the lock is not needed for writing
+        lock.unlock();
+        if (!failed && !writeBatch(*pending)) {
+            LOG_ERROR << "logstream: error writing to " << path << ": " << strerror(errno);
+            failed = true;
+        }
+        pending->clear();
+        lock.lock();
+
+        hasPending = false;
+        onWritten.notify_all();
+    }
+}
+
+bool Writer::writeBatch(Batch &batch) {
+    iov.clear();
+    for (const auto &e : batch.entries) {
+        iov.push_back({batch.staging.get() + e.offset, e.length});
+        if (e.data && !e.data->empty())
+            iov.push_back({const_cast<uint8_t *>(e.data->data()), e.data->size()});
+    }
+
+    size_t first{0};
+    while (first < iov.size()) {
+        const int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+        ssize_t n{::writev(fd, &iov[first], count)};
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        fileOffset += n;
+
+        // skip completely written vectors, continue partially written one
+        while (first < iov.size() && static_cast<size_t>(n) >= iov[first].iov_len) {
+            n -= iov[first].iov_len;
+            ++first;
+        }
+        if (n > 0) {
+            iov[first].iov_base = static_cast<uint8_t *>(iov[first].iov_base) + n;
+            iov[first].iov_len -= n;
+        }
+    }
+
+    // start writeback now, instead of letting dirty pages pile up for a large
+    // flush later, and drop older pages, that are never read again, from the page cache
+    const uint64_t end{fileOffset};
+    sync_file_range(fd, syncedOffset, end - syncedOffset, SYNC_FILE_RANGE_WRITE);
+    if (syncedOffset > 0)
+        posix_fadvise(fd, 0, syncedOffset, POSIX_FADV_DONTNEED);
+    syncedOffset = end;
+
+    return true;
+}
+
+
+Reader::Reader(const std::filesystem::path &path)
+  : in(path, std::ios::binary) {
+    FileHeader header;
+    ok = in.read(reinterpret_cast<char *>(&header), sizeof(header)) &&
+         std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0;
+}
+
+bool Reader::next(std::string &name, std::vector<uint8_t> &data) {
+    if (!ok)
+        return false;
+
+    RecordHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != RECORD_MAGIC)
+        return ok = false;
+
+    name.resize(header.nameLength);
+    data.resize(header.dataLength);
+    ok = in.read(name.data(), name.size()) && in.read(reinterpret_cast<char *>(data.data()), data.size());
+    return ok;
+}
+
+} // namespace logstream
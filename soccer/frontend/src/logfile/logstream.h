@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+/*
+ * Append-only log container (.bblog), convert to zip with bblog2zip.
+ *
+ * file:   FileHeader, Record...
+ * record: RecordHeader, name (nameLength bytes), data (dataLength bytes)
+ *
+ * Records are never rewritten, so a log that was cut off (power loss, crash)
+ * is valid up to the last complete record.
+ */
+namespace logstream {
+
+static constexpr char FILE_MAGIC[8]{'B', 'B', 'L', 'O', 'G', 0, 0, 1};
+static constexpr uint32_t RECORD_MAGIC{0x43524242}; // "BBRC"
+
+struct FileHeader {
+    char magic[8];
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint16_t flags;
+    uint16_t nameLength;
+    uint64_t dataLength;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+// data that is written without copying, e.g. a shared JPEG buffer
+using shared_buffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+/**
+ * Writes records through a dedicated I/O thread.
+ *
+ * Callers never block on disk I/O: headers and small payloads are copied
+ * into one of two preallocated staging buffers, shared buffers are only referenced.
+ * The I/O thread swaps the staging buffers and writes a whole batch with writev().
+ * The calling thread only waits, if the staging buffer is full while the disk is busy.
+ */
+class Writer {
+public:
+    explicit Writer(size_t stagingSize = 4 << 20);
+    ~Writer();
+
+    bool open(const std::filesystem::path &path);
+    void close();
+    bool isOpen() const { return fd >= 0; }
+
+    // copies data into the staging buffer
+    void write(std::string_view name, const void *data, size_t length);
+    // keeps a reference to data, until it has been written
+    void write(std::string_view name, shared_buffer data);
+
+    // hand the current batch to the I/O thread, waits while the previous one is written
+    void flush();
+    // hand the current batch to the I/O thread, unless it is still busy; never waits
+    bool tryFlush();
+
+    // bytes written to disk so far
+    uint64_t written() const { return fileOffset.load(); }
+
+private:
+    struct Entry {
+        size_t offset;       // start of header (+ copied data) in staging buffer
+        size_t length;       // bytes in staging buffer
+        shared_buffer data;  // written after the staged bytes, if set
+    };
+
+    struct Batch {
+        std::unique_ptr<uint8_t[]> staging;
+        size_t used{0};
+        std::vector<Entry> entries;
+
+        explicit Batch(size_t size);
+        bool empty() const { return entries.empty(); }
+        void clear();
+    };
+
+    int fd{-1};
+    std::filesystem::path path;
+    size_t stagingSize;
+
+    // filled by callers
+    std::unique_ptr<Batch> active;
+    // written by the I/O thread
+    std::unique_ptr<Batch> pending;
+    std::vector<iovec> iov;
+
+    std::thread worker;
+    std::mutex mtx;
+    std::condition_variable onPending, onWritten;
+    bool hasPending{false};
+    bool running{false};
+    bool failed{false};
+
+    std::atomic<uint64_t> fileOffset{0};
+    uint64_t syncedOffset{0};
+
+    // reserve header, name and copyLength bytes, caller must hold mtx
+    uint8_t *stage(std::unique_lock<std::mutex> &lock, std::string_view name, uint64_t dataLength,
+            size_t copyLength, shared_buffer data);
+    void swapBatches(std::unique_lock<std::mutex> &lock);
+    void run();
+    bool writeBatch(Batch &batch);
+};
+
+/**
+ * Sequential reader, used for offline conversion.
+ */
+class Reader {
+public:
+    explicit Reader(const std::filesystem::path &path);
+
+    bool valid() const { return ok; }
+
+    // false at end of file or at the first incomplete record
+    bool next(std::string &name, std::vector<uint8_t> &data);
+
+private:
+    std::ifstream in;
+    bool ok{false};
+};
+
+} // namespace logstream
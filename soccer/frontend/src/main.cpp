@@ -93,6 +93,12 @@ struct Application : public Engine {
             return EXIT_FAILURE;
         }
        
+        if (system->modulePool) {
+            // keep lola communication & BodyControl off the pool cores
+            soccer.pin("nao", std::thread::hardware_concurrency() - 1);
+            soccer.setScheduling(rt::Kernel::Scheduling::POOL);
+        }
+
         config->loadBaseSettings(nao, settings, playingfield);
         soccer.setup();
         config->loadBlackboardSettings(settings);
@@ -20,3 +20,40 @@ struct DebugImageHeader {
     uint64_t imageSize{0};
     uint64_t vrSize{0};
 };
+
+// binary debug symbol stream over UDP, decoded by bembelapi/symbolstream.py
+// all numbers are little endian
+constexpr char DEBUG_SYMBOLS_MAGIC[4]{'B', 'B', 's', 'y'};
+constexpr uint8_t DEBUG_SYMBOLS_VERSION{1};
+
+enum class DebugSymbolsType : uint8_t {
+    TABLE = 0,      // entries map id -> "blackboard.symbol"
+    VALUES = 1,     // entries are values, that changed since the last frame
+    KEYFRAME = 2,   // entries are all enabled values, replace everything received before
+};
+
+// set on the last packet of a frame
+constexpr uint8_t DEBUG_SYMBOLS_LAST_PACKET{1};
+
+struct DebugSymbolsHeader {
+    char magic[4];
+
+    uint8_t version{DEBUG_SYMBOLS_VERSION};
+    DebugSymbolsType type{DebugSymbolsType::VALUES};
+    uint8_t flags{0};
+    uint8_t reserved0{0};
+
+    uint32_t tableId{0};    // ids are only valid for the table with the same id
+    uint32_t sequence{0};   // frame number, same for all packets of a frame
+
+    uint16_t count{0};      // number of entries following the header
+    uint16_t reserved1{0};
+} __attribute__((__packed__));
+
+// followed by length bytes (not terminated), length == REMOVED: symbol was disabled
+struct DebugSymbolsEntry {
+    static constexpr uint16_t REMOVED{0xffff};
+
+    uint16_t id;
+    uint16_t length;
+} __attribute__((__packed__));
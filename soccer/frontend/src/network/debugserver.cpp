@@ -37,7 +37,7 @@ DebugServer::DebugServer() : _lastAlive(0) {
 
     _netBcast = std::make_unique<UDP>(Network::DEBUG, &DebugServer::recv, this);
     _netUcast = std::make_unique<UDP>(Network::RANDOM, &DebugServer::recv, this);
-    _netTCP = std::make_unique<TCPServer>(Network::DEBUG, false, 0, 10485760ULL);
+    _netTCP = std::make_unique<TCPServer>(Network::DEBUG, false, 0, TCP_SEND_BUFFER_SIZE);
 }
 
 DebugServer::~DebugServer() {
@@ -54,6 +54,7 @@ void DebugServer::connect(rt::Linker &link) {
     link(settings);
     link(config);
     link(images);
+    link(profile);
     link(debugState);
 }
 
@@ -68,6 +69,7 @@ void DebugServer::process() {
     microTime start = getMicroTime();
     broadcastSymbolValues();
     broadcastImages();
+    broadcastProfile();
     {
         std::scoped_lock lock(mtx);
         debugState->debug_ep = lastDebug;
@@ -122,6 +124,10 @@ void DebugServer::recv(const char *msg, const size_t &bytes_recvd, const udp::en
                 connectClient(sender);
                 updateDebugSymbols(pt, false);
             }
+        } else if (msg_type == "symbol_table") {
+            if (connected && authorized) {
+                sendSymbolTable = true;
+            }
         } else if (msg_type == "change_value") {
             if (!connected || (connected && authorized)) {
                 connectClient(sender);
@@ -185,28 +191,18 @@ void DebugServer::broadcastSymbolValues() {
         return;
     }
 
-    // fetch debug symbols from all included blackboards
-    std::vector<BlackboardDataContainer> allDebugSymbols;
-
-    for (auto &blackboard : BlackboardRegistry::GetBlackboards()) {
-        auto lock = blackboard->scopedLock();
-        for (auto &debugValues : blackboard->_debugValues) {
-            auto &[symbol, symbolVal] = debugValues;
-            bool hasGetter = blackboard->_get_funcs.find(symbol) != blackboard->_get_funcs.end();
-            if (*symbolVal && hasGetter) {
-                allDebugSymbols.push_back(blackboard->_get_funcs.at(symbol)());
-            }
+    // only changed values are sent, a new table id or keyframe makes the client start over
+    bool keyframe = symbolStream.sequence() % SYMBOL_KEYFRAME_INTERVAL == 0;
+    const bool tableChanged = symbolStream.update();
+    if (sendSymbolTable.exchange(false) || tableChanged) {
+        for (auto &packet : symbolStream.table()) {
+            send(packet.data(), packet.size());
         }
+        keyframe = true;
     }
 
-    if (allDebugSymbols.size() != 0) {
-        // convert to json data structure
-        ptree pt;
-        pt.put("debugv2.msg_type", "symbol_values");
-        for (auto &symbol : allDebugSymbols) {
-            pt.put("debugv2." + symbol.getKey(), symbol.getValue());
-        }
-        send(pt);
+    for (auto &packet : symbolStream.values(keyframe)) {
+        send(packet.data(), packet.size());
     }
 }
 
@@ -230,6 +226,33 @@ void DebugServer::broadcastSymbolNames() {
     send(pt);
 }
 
+void DebugServer::broadcastProfile() {
+    auto messages = profile.fetch();
+    if (messages.empty() || !isSending()) {
+        return;
+    }
+    const auto &msg = messages.back();
+
+    // zone names contain dots, so they can't be part of a ptree path
+    ptree zones;
+    for (const auto &zone : msg.zones) {
+        ptree z;
+        z.put("count", zone->count);
+        z.put("total_us", zone->totalUs);
+        z.put("max_us", zone->maxUs);
+        z.put("p50_us", zone->p50Us);
+        z.put("p90_us", zone->p90Us);
+        z.put("p99_us", zone->p99Us);
+        zones.push_back({zone->name, z});
+    }
+
+    ptree pt;
+    pt.put("debugv2.msg_type", "profiler_stats");
+    pt.put("debugv2.period_ms", msg.periodMs);
+    pt.add_child("debugv2.zones", zones);
+    send(pt);
+}
+
 void DebugServer::updateDebugSymbols(ptree &pt, const bool &change_value) const {
 
     for (auto &v : pt.get_child("debugv2")) {
@@ -257,9 +280,9 @@ void DebugServer::updateDebugSymbols(ptree &pt, const bool &change_value) const
 
                 if (change_value) {
                     for (auto &kv : pairs) {
-                        if (bb->_set_funcs.find(kv.first) != bb->_set_funcs.end()) {
+                        if (bb->isEditable(kv.first)) {
                             LOG_INFO << "Setting var: " << kv.first << " to: " << kv.second;
-                            bb->_set_funcs.at(kv.first)(kv.second);
+                            bb->setValue(kv.first, kv.second);
                         }
                     }
                 } else {
@@ -273,10 +296,15 @@ void DebugServer::updateDebugSymbols(ptree &pt, const bool &change_value) const
 void DebugServer::broadcastImages() {
     auto imgs{images.fetch()};
 
-    // skip if no debug client is connected or previous image has not been sent completely
-    if (!isSending() || _netTCP->is_busy())
+    // skip if no debug client is connected
+    if (!isSending() || imgs.empty())
         return;
 
+    // drop frames and lower resolution/quality, before the connection falls behind
+    if (!imageStream.admit(_netTCP->queued_bytes(), getTimestampMs()))
+        return;
+    const auto &level = imageStream.level();
+
     // only keep latest top & bottom image, in case there are multiple in queue
     std::array<VisionImageProcessed *, 2> latest{nullptr};
     for (auto &i : imgs) {
@@ -290,35 +318,36 @@ void DebugServer::broadcastImages() {
         }
     }
 
+    // encode both cameras in the background at the same time
+    for (auto &img_context : latest) {
+        if (img_context)
+            img_context->prefetchJpeg(level.scale, level.quality);
+    }
+
     for (auto &img_context : latest) {
         if (!img_context)
             continue;
 
-        auto &image{*(img_context->jpeg)};
+        auto jpeg{img_context->getJpeg(level.scale, level.quality)};
         size_t vrSize = img_context->results->size() * sizeof(VisionResult);
-        size_t size = image.size() + sizeof(DebugImageHeader) + vrSize;
 
-        char *data = new char[size];
-        DebugImageHeader *dbgHdr = reinterpret_cast<DebugImageHeader *>(data);
+        auto header = std::make_shared<std::vector<char>>(sizeof(DebugImageHeader));
+        DebugImageHeader *dbgHdr = reinterpret_cast<DebugImageHeader *>(header->data());
+        std::memcpy(dbgHdr->magic, DEBUG_IMAGE_MAGIC, sizeof(dbgHdr->magic));
         dbgHdr->version = DEBUG_IMAGE_VERSION;
         dbgHdr->camera = img_context->camera;
         dbgHdr->codec = ImageCodec::JPG;
         dbgHdr->timestamp = img_context->timestamp;
-        dbgHdr->imageSize = image.size();
+        dbgHdr->imageSize = jpeg->size();
         dbgHdr->vrSize = vrSize;
 
-        char *offset = data;
-
-        std::memcpy(offset, DEBUG_IMAGE_MAGIC, sizeof(dbgHdr->magic));
-        offset += sizeof(DebugImageHeader);
-
-        std::memcpy(offset, img_context->results->data(), dbgHdr->vrSize);
-        offset += dbgHdr->vrSize;
-
-        std::memcpy(offset, image.data(), dbgHdr->imageSize);
+        // header, vision results and jpeg are sent from where they are, without copying
+        shared_const_buffer buf{std::shared_ptr<const std::vector<char>>(std::move(header))};
+        buf.append(shared_const_buffer(std::shared_ptr<const std::vector<VisionResult>>(img_context->results)));
+        buf.append(shared_const_buffer(jpeg));
 
-        _netTCP->write(data, size);
-        delete[] data;
+        imageStream.sent(buf.size());
+        _netTCP->write(buf);
     }
 }
 
@@ -427,6 +456,7 @@ void DebugServer::connectClient(const boost::asio::ip::udp::endpoint &client) {
     if (!_debug_client) {
         _debug_client = new udp::endpoint(client);
         broadcastSymbolNames();
+        sendSymbolTable = true;
     }
 
     _lastAlive = getTimestampMs();
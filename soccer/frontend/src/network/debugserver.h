@@ -13,6 +13,10 @@
 #include <representations/vision/image.h>
 #include <representations/bembelbots/types.h>
 #include <representations/debugserver/debugstate.h>
+#include "debugsymbols.h"
+#include "imagestream.h"
+#include <profiler_message_generated.h>
+#include <atomic>
 
 
 class Config;
@@ -48,10 +52,10 @@ public:
     bool isSending();
 
 private:
-    static constexpr uint8_t PNG_LOW_COMPRESSION_LVL{2};
-    static constexpr uint8_t JPEG_BAD_QUALITY{80};
-    static constexpr uint8_t LQ_WIDTH{160};
-    static constexpr uint8_t LQ_HEIGHT{120};
+    // ImageStreamControl keeps the queue short, the socket only has to hold a few frames
+    static constexpr size_t TCP_SEND_BUFFER_SIZE{1024 * 1024};
+    // send all symbol values every n frames, in case packets were lost
+    static constexpr uint32_t SYMBOL_KEYFRAME_INTERVAL{30};
 
     std::mutex mtx;
 
@@ -67,10 +71,16 @@ private:
     rt::Context<SettingsBlackboard> settings;
     rt::Context<Config, rt::Write> config;
     rt::Input<VisionImageProcessed, rt::Snoop> images;
+    rt::Input<bbapi::ProfilerMessageT, rt::Snoop> profile;
     
     boost::asio::ip::udp::endpoint lastDebug;
     rt::Output<DebugState> debugState;
 
+    ImageStreamControl imageStream;
+    DebugSymbolStream symbolStream;
+    // set by recv(), if a client (re)connected or asked for the symbol table
+    std::atomic<bool> sendSymbolTable{false};
+
     void recv(const char *msg, const size_t &bytes_recvd,
               const udp::endpoint &sender);
 
@@ -85,6 +95,9 @@ private:
 
     void broadcastImages();
 
+    // Sends the newest profiler statistics as "profiler_stats".
+    void broadcastProfile();
+
     void updateDebugSymbols(boost::property_tree::ptree &pt,
                             const bool &change_value) const;
     std::vector<bool> getDebugValues();
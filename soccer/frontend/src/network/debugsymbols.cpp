@@ -0,0 +1,164 @@
+#include "debugsymbols.h"
+
+#include <framework/blackboard/blackboard.h>
+#include <framework/blackboard/blackboardregistry.h>
+#include <framework/blackboard/datacontainer.h>
+#include <framework/logger/logger.h>
+
+#include <algorithm>
+#include <cstring>
+
+// splits entries into packets of at most MAX_PACKET_SIZE bytes
+class DebugSymbolStream::Writer {
+public:
+    Writer(DebugSymbolsType type, uint32_t tableId, uint32_t sequence) {
+        std::memcpy(header.magic, DEBUG_SYMBOLS_MAGIC, sizeof(header.magic));
+        header.type = type;
+        header.tableId = tableId;
+        header.sequence = sequence;
+    }
+
+    // data nullptr: remove the symbol on the client
+    // @return false, if data is too large, the symbol is removed instead
+    bool add(uint16_t id, const std::string *data) {
+        size_t size = data ? data->size() : 0;
+        const bool fits = size < DebugSymbolsEntry::REMOVED;
+        if (!fits) {
+            LOG_WARN_EVERY_N(100) << "DebugSymbolStream: value of symbol " << id << " too large, " << size << " bytes";
+            data = nullptr;
+            size = 0;
+        }
+
+        const size_t entrySize = sizeof(DebugSymbolsEntry) + size;
+        if (current.empty() || (current.size() + entrySize > MAX_PACKET_SIZE && count > 0)) {
+            flush();
+            current.resize(sizeof(DebugSymbolsHeader));
+        }
+
+        DebugSymbolsEntry entry{id, data ? static_cast<uint16_t>(size) : DebugSymbolsEntry::REMOVED};
+        const size_t offset = current.size();
+        current.resize(offset + entrySize);
+        std::memcpy(current.data() + offset, &entry, sizeof(entry));
+        if (size > 0) {
+            std::memcpy(current.data() + offset + sizeof(entry), data->data(), size);
+        }
+        count++;
+        return fits;
+    }
+
+    // empty: send a packet, even if there are no entries
+    std::vector<packet_t> finish(bool empty = false) {
+        flush();
+        if (packets.empty() && empty) {
+            header.count = 0;
+            current.resize(sizeof(header));
+            std::memcpy(current.data(), &header, sizeof(header));
+            packets.emplace_back(std::move(current));
+        }
+        if (!packets.empty()) {
+            auto *last = reinterpret_cast<DebugSymbolsHeader *>(packets.back().data());
+            last->flags |= DEBUG_SYMBOLS_LAST_PACKET;
+        }
+        return std::move(packets);
+    }
+
+private:
+    DebugSymbolsHeader header;
+    packet_t current;
+    uint16_t count{0};
+    std::vector<packet_t> packets;
+
+    void flush() {
+        if (count == 0) {
+            return;
+        }
+        header.count = count;
+        std::memcpy(current.data(), &header, sizeof(header));
+        packets.emplace_back(std::move(current));
+        current.clear();
+        count = 0;
+    }
+};
+
+bool DebugSymbolStream::update() {
+    auto &registry = BlackboardRegistry::GetBlackboards();
+    if (tableId != 0 && std::equal(registry.begin(), registry.end(), blackboards.begin(), blackboards.end())) {
+        return false;
+    }
+
+    blackboards.assign(registry.begin(), registry.end());
+    symbols.clear();
+    ranges.assign(1, 0);
+    size_t rawSize = 0;
+    for (auto *bb : blackboards) {
+        auto lock = bb->scopedLock();
+        const auto &schema = bb->symbols();
+        for (Introspection::SymbolId id = 0; id < schema.size(); id++) {
+            if (not bb->hasValue(id)) {
+                continue; // switches have no value
+            }
+            symbols.push_back({bb->getBlackboardName() + "." + schema[id].name, id, schema[id].size, rawSize, std::nullopt});
+            rawSize += schema[id].size;
+        }
+        ranges.push_back(symbols.size());
+    }
+    raw.assign(rawSize, 0);
+    jsassert(symbols.size() < DebugSymbolsEntry::REMOVED) << "too many debug symbols";
+
+    tableId++;
+    return true;
+}
+
+std::vector<DebugSymbolStream::packet_t> DebugSymbolStream::table() const {
+    Writer writer(DebugSymbolsType::TABLE, tableId, frame);
+    for (size_t id = 0; id < symbols.size(); id++) {
+        writer.add(id, &symbols[id].name);
+    }
+    return writer.finish(true);
+}
+
+std::vector<DebugSymbolStream::packet_t> DebugSymbolStream::values(bool keyframe) {
+    Writer writer(keyframe ? DebugSymbolsType::KEYFRAME : DebugSymbolsType::VALUES, tableId, frame++);
+
+    for (size_t i = 0; i < blackboards.size(); i++) {
+        auto *bb = blackboards[i];
+        auto lock = bb->scopedLock();
+        for (size_t id = ranges[i]; id < ranges[i + 1]; id++) {
+            auto &s = symbols[id];
+            if (!bb->isDebugged(s.symbol)) {
+                if (s.sent) {
+                    s.sent.reset();
+                    if (!keyframe) {
+                        writer.add(id, nullptr);
+                    }
+                }
+                continue;
+            }
+
+            if (s.rawSize > 0) {
+                const void *current = bb->valuePtr(s.symbol);
+                char *previous = raw.data() + s.rawOffset;
+                if (s.sent && std::memcmp(current, previous, s.rawSize) == 0) {
+                    if (keyframe) {
+                        writer.add(id, &*s.sent);
+                    }
+                    continue;
+                }
+                std::memcpy(previous, current, s.rawSize);
+            }
+
+            std::string value = bb->getValue(s.symbol).getValue();
+            if (keyframe || !s.sent || *s.sent != value) {
+                if (writer.add(id, &value)) {
+                    s.sent = std::move(value);
+                } else {
+                    s.sent.reset(); // the client removed it, try again next frame
+                }
+            }
+        }
+    }
+    // a keyframe clears symbols on the client, even without entries
+    return writer.finish(keyframe);
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
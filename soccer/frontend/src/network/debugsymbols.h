@@ -0,0 +1,66 @@
+#pragma once
+
+#include "debugheader.h"
+
+#include <framework/blackboard/introspection.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+class BlackboardBase;
+
+/**
+ * Encodes debug symbols of all blackboards into the binary symbol stream
+ * (see DebugSymbolsHeader).
+ *
+ * Every symbol gets a numeric id once, the client receives the id table once
+ * and after that only the values, that changed since the previous frame.
+ * Keyframes with all enabled values let the client recover from lost packets.
+ * Trivially copyable values are compared bytewise with the sent copy,
+ * so only changed values are formatted.
+ */
+class DebugSymbolStream {
+public:
+    using packet_t = std::vector<char>;
+
+    // stay below the MTU, so packets are not fragmented
+    static constexpr size_t MAX_PACKET_SIZE{1400};
+
+    // rebuild the id table, if blackboards were (un)registered
+    // @return true, if the table changed
+    bool update();
+
+    // packets with the id -> name table
+    std::vector<packet_t> table() const;
+
+    // packets with changed values (all enabled values for a keyframe),
+    // empty if nothing changed and no keyframe was requested
+    std::vector<packet_t> values(bool keyframe);
+
+    // frames encoded since start
+    uint32_t sequence() const { return frame; }
+
+private:
+    struct Symbol {
+        std::string name;   // blackboard.symbol
+        Introspection::SymbolId symbol;
+        uint32_t rawSize;   // see Introspection::Symbol::size
+        size_t rawOffset;   // into raw
+        std::optional<std::string> sent;
+    };
+
+    // symbols of blackboards[i] are symbols[ranges[i], ranges[i + 1])
+    std::vector<BlackboardBase *> blackboards;
+    std::vector<size_t> ranges;
+    std::vector<Symbol> symbols;    // index is the id
+    // bytes of the sent trivially copyable values, unchanged ones are not formatted again
+    std::vector<char> raw;
+    uint32_t tableId{0};
+    uint32_t frame{0};
+
+    class Writer;
+};
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,96 @@
+#include "imagestream.h"
+
+#include <framework/logger/logger.h>
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// ordered from best to cheapest
+constexpr std::array<ImageStreamControl::Level, 7> LEVELS{{
+    {1, 80, 1},
+    {1, 60, 1},
+    {2, 80, 1},
+    {2, 60, 1},
+    {4, 60, 1},
+    {4, 60, 2},
+    {4, 40, 4},
+}};
+
+constexpr size_t START_LEVEL{2};
+
+} // namespace
+
+ImageStreamControl::ImageStreamControl() : current(START_LEVEL) {
+}
+
+const ImageStreamControl::Level &ImageStreamControl::level() const {
+    return LEVELS[current];
+}
+
+bool ImageStreamControl::admit(size_t queued, TimestampMs now) {
+    updateRate(queued, now);
+    adapt(now);
+
+    if (frame++ % level().every != 0) {
+        return false;
+    }
+
+    offered++;
+    const size_t limit = std::max<size_t>(MIN_QUEUE_BYTES, bytesPerSecond * MAX_QUEUE_DELAY_MS / 1000);
+    if (queued > limit) {
+        dropped++;
+        return false;
+    }
+    return true;
+}
+
+void ImageStreamControl::sent(size_t bytes) {
+    written += bytes;
+}
+
+void ImageStreamControl::updateRate(size_t queued, TimestampMs now) {
+    const TimestampMs dt = now - lastTime;
+    if (lastTime != 0 && dt > 0) {
+        const size_t drained = lastQueued + written > queued ? lastQueued + written - queued : 0;
+        const float sample = drained * 1000.f / dt;
+
+        // only a backlogged queue shows the rate of the connection,
+        // otherwise we just learn, that it is at least that fast
+        if (lastQueued > 0) {
+            bytesPerSecond += RATE_SMOOTHING * (sample - bytesPerSecond);
+        } else {
+            bytesPerSecond = std::max(bytesPerSecond, sample);
+        }
+    }
+    lastQueued = queued;
+    lastTime = now;
+    written = 0;
+}
+
+void ImageStreamControl::adapt(TimestampMs now) {
+    if (now - periodStart < ADAPT_PERIOD_MS) {
+        return;
+    }
+
+    if (offered > 0 && dropped * 2 > offered) {
+        calmPeriods = 0;
+        if (current + 1 < LEVELS.size()) {
+            current++;
+            LOG_DEBUG << "ImageStreamControl: " << bytesPerSecond / 1024 << " KiB/s, lowering to level " << current;
+        }
+    } else if (dropped == 0 && ++calmPeriods >= CALM_PERIODS_TO_IMPROVE) {
+        calmPeriods = 0;
+        if (current > 0) {
+            current--;
+            LOG_DEBUG << "ImageStreamControl: " << bytesPerSecond / 1024 << " KiB/s, raising to level " << current;
+        }
+    }
+
+    periodStart = now;
+    offered = 0;
+    dropped = 0;
+}
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <framework/util/clock.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Picks resolution, JPEG quality and frame skip of the camera stream,
+ * so images never pile up on a slow connection (e.g. field Wi-Fi).
+ *
+ * The rate of the connection is estimated from how fast its send queue
+ * drains. A frame is only sent, if the queue is short enough to be sent
+ * within MAX_QUEUE_DELAY_MS, otherwise it is dropped. If more than half
+ * of the frames of a period were dropped, the next cheaper level is used,
+ * after some periods without drops the next better one is tried.
+ */
+class ImageStreamControl {
+public:
+    struct Level {
+        int scale;      // 1/scale of the camera resolution
+        int quality;    // JPEG quality
+        int every;      // send every n-th frame only
+    };
+
+    ImageStreamControl();
+
+    // call once per frame
+    // @param queued: bytes, that are not sent yet
+    // @return true, if the frame should be sent at level()
+    bool admit(size_t queued, TimestampMs now);
+
+    // size of an admitted frame, that was put into the send queue
+    void sent(size_t bytes);
+
+    const Level &level() const;
+
+    // estimated rate of the connection [bytes/s]
+    float rate() const { return bytesPerSecond; }
+
+private:
+    static constexpr TimestampMs ADAPT_PERIOD_MS{1000};
+    static constexpr int CALM_PERIODS_TO_IMPROVE{3};
+    static constexpr TimestampMs MAX_QUEUE_DELAY_MS{100};
+    static constexpr size_t MIN_QUEUE_BYTES{16 * 1024};
+    static constexpr float INITIAL_RATE{1e6f};
+    static constexpr float RATE_SMOOTHING{0.2f};
+
+    size_t current;
+    uint32_t frame{0};
+
+    float bytesPerSecond{INITIAL_RATE};
+    size_t lastQueued{0};
+    size_t written{0};
+    TimestampMs lastTime{0};
+
+    TimestampMs periodStart{0};
+    int offered{0};
+    int dropped{0};
+    int calmPeriods{0};
+
+    void updateRate(size_t queued, TimestampMs now);
+    void adapt(TimestampMs now);
+};
+
+// vim: set ts=4 sw=4 sts=4 expandtab:
@@ -148,6 +148,10 @@ void System::init_logger() {
     // do not strip whitespaces before/after msg!
     xlog->set_msg_stripping(false);
 
+    // record messages without allocating or locking, so the motion thread
+    // never waits for the logger, the IO worker does the formatting
+    xlog->set_binary_mode(true);
+
     LOG_INFO << "Started logger (" << LOGID << ") with min-lvls ["
             << "runtime = " << xlog->get_min_loglvl() << " "
             << "compile-time = " << XLOG_MIN_LOG_LVL << "]";
@@ -158,6 +162,7 @@ bool System::init_cli(int argc, char *argv[]) {
     desc.add_options()
     ("help,h", "produce help message.")
     ("docker", "simulation mode inside docker container. Reads additional options from environment variables.")
+    ("module-pool", "run modules with required inputs as tasks on a work-stealing thread pool.")
     ("buildinfo", "print buildinfo");
 
     boost::program_options::store(
@@ -180,5 +185,9 @@ bool System::init_cli(int argc, char *argv[]) {
         std::cout << "Framework running in Docker mode." << std::endl;
     }
 
+    if (cli.count("module-pool")) {
+        modulePool = true;
+    }
+
     return true;
 }
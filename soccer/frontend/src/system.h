@@ -15,6 +15,7 @@ class System
 {
 public:
     bool docker{false};
+    bool modulePool{false};
     
     bool init(int argc, char *argv[]);
     int run();
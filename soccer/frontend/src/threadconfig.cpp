@@ -1,4 +1,5 @@
 #include <framework/thread/simplethreadmanager.h>
+#include <framework/thread/workstealingpool.h>
 #include <framework/logger/logger.h>
 #include <framework/network/network.h>
 #include <representations/bembelbots/thread.h>
@@ -46,6 +47,10 @@ void rt::CreateModuleThread(rt::Kernel* kernel, rt::ModuleId m, int runs) {
     tm->create(NaoThread::NORMAL, std::bind(&rt::Kernel::moduleLoop, kernel, _1, _2, _3), m, runs);
 }
 
+std::shared_ptr<ThreadPool> rt::CreateModulePool() {
+    return std::make_shared<WorkStealingThreadPool<NaoThread>>(GetThreadManager(), NaoThread::NORMAL);
+}
+
 void CreateNetworkThread(NetworkIO *network) {
     using namespace std::placeholders;
     GetThreadManager()->create(NaoThread::IO, std::bind(&NetworkIO::worker, network, _1));